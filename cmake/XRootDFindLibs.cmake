@@ -101,6 +101,8 @@ if( BUILD_TPC )
 set ( CMAKE_REQUIRED_LIBRARIES ${CURL_LIBRARIES} )
 check_function_exists( curl_multi_wait HAVE_CURL_MULTI_WAIT )
 compiler_define_if_found( HAVE_CURL_MULTI_WAIT HAVE_CURL_MULTI_WAIT )
+check_function_exists( curl_multi_wakeup HAVE_CURL_MULTI_WAKEUP )
+compiler_define_if_found( HAVE_CURL_MULTI_WAKEUP HAVE_CURL_MULTI_WAKEUP )
 endif()
 
 if( ENABLE_MACAROONS )
@@ -758,7 +758,8 @@ struct ClientSigverRequest {
 /******************************************************************************/
 
 enum XStatRequestOption {
-   kXR_vfs    = 1
+   kXR_vfs    = 1,
+   kXR_sxfull = 2   // statx: return "<errcode> <stat info>" per path
 };
   
 struct ClientStatRequest {
@@ -1169,6 +1170,7 @@ typedef struct ServerResponseReqs_Protocol secReqs;
 #define kXR_supgpf        0x00400000
 #define kXR_suppgrw       0x00200000
 #define kXR_supposc       0x00100000
+#define kXR_supsxfull     0x00080000
 
 // TLS requirements
 //
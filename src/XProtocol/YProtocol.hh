@@ -115,6 +115,7 @@ enum CmsReqCode            // Request Codes
      kYR_update  = 25,
      kYR_usage   = 26,
      kYR_xauth   = 27,
+     kYR_bloom   = 28,
      kYR_MaxReq            // Count of request numbers (highest + 1)
 };
 
@@ -187,6 +188,30 @@ struct CmsAvailRequest
 //     kXR_int32     diskUtil;
 };
 
+/******************************************************************************/
+/*                         b l o o m   R e q u e s t                          */
+/******************************************************************************/
+  
+// Request: bloom <gen> <words> <offset> <hashes> <keys> <data>
+// Respond: n/a
+//
+// A server describes the files it has using a Bloom filter. Since the filter
+// may exceed the maximum request size, it is sent as consecutive segments of
+// 32-bit words. The filter takes effect once the last segment arrives.
+//
+struct CmsBloomRequest
+{      CmsRRHdr      Hdr;
+       kXR_unt32     Gen;                // Filter generation number
+       kXR_unt32     Words;              // Number of words in the filter
+       kXR_unt32     Offset;             // Word offset of this segment
+       kXR_unt16     Hashes;             // Number of hash functions
+       kXR_unt16     Rsvd;
+       kXR_unt32     Keys;               // Number of keys in the filter
+//     kXR_unt32     Data[];             // Segment words in network order
+
+static const int maxSegWords = 4080;     // Keeps segments below 16K
+};
+
 /******************************************************************************/
 /*                         c h m o d   R e q u e s t                          */
 /******************************************************************************/
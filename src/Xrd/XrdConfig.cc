@@ -805,6 +805,7 @@ int XrdConfig::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest)
    TS_Xeq("adminpath",     xapath);
    TS_Xeq("allow",         xallow);
    TS_Xeq("homepath",      xhpath);
+   TS_Xeq("logasync",      xlogasync);
    TS_Xeq("pidpath",       xpidf);
    TS_Xeq("port",          xport);
    TS_Xeq("protocol",      xprot);
@@ -1649,6 +1650,37 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
     return 0;
 }
 
+/******************************************************************************/
+/*                             x l o g a s y n c                              */
+/******************************************************************************/
+
+/* Function: xlogasync
+
+   Purpose:  To parse the directive: logasync [<qmax>]
+
+             <qmax>    the maximum amount of message text that may be queued
+                       for writing (default 16m). Messages beyond this limit
+                       are dropped and the number dropped is logged.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdConfig::xlogasync(XrdSysError *eDest, XrdOucStream &Config)
+{
+    long long qmax = 16*1024*1024;
+    char *val;
+
+    if ((val = Config.GetWord())
+    &&  XrdOuca2x::a2sz(*eDest, "logasync queue limit", val, &qmax, 65536))
+       return 1;
+
+    if (!Log.logger()->setAsync(qmax))
+       {eDest->Emsg("Config", "Unable to write log messages asynchronously.");
+        return 1;
+       }
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x n e t                                   */
 /******************************************************************************/
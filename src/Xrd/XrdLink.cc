@@ -232,6 +232,12 @@ XrdTlsPeerCerts *XrdLink::getPeerCerts()
 /******************************************************************************/
 
 XrdProtocol *XrdLink::getProtocol() {return linkXQ.getProtocol();}
+
+/******************************************************************************/
+/*                          g e t R e a d y T i m e                           */
+/******************************************************************************/
+
+long long XrdLink::getReadyTime() {return linkXQ.PollInfo.rdyTime;}
   
 /******************************************************************************/
 /*                                  H o l d                                   */
@@ -185,6 +185,15 @@ XrdTlsPeerCerts *getPeerCerts();
 
 XrdProtocol    *getProtocol();
 
+//-----------------------------------------------------------------------------
+//! Get the time the link was last dispatched because it had data to read.
+//!
+//! @return The time as returned by XrdOucLatency::Now() or zero if the link
+//!         has not yet been dispatched by a poller.
+//-----------------------------------------------------------------------------
+
+long long       getReadyTime();
+
 //-----------------------------------------------------------------------------
 //! Lock or unlock the mutex used for control operations.
 //!
@@ -31,6 +31,7 @@
 #include <cstdio>
 #include <cstdlib>
   
+#include "XrdOuc/XrdOucLatency.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysPlatform.hh"
@@ -41,6 +41,7 @@ XrdPollInfo   *Next;        // Chain of links waiting for a PollPoll event
 XrdLink       &Link;        // Link associated with this object (always the same)
 struct pollfd *PollEnt;     // Used only by PollPoll
 XrdPoll       *Poller;      // -> Poller object associated with this object
+long long      rdyTime;     // Time the link was last dispatched (usec)
 int            FD;          // Associated target file descriptor number
 bool           inQ;         // True -> in a PollPoll event queue
 bool           isEnabled;   // True -> interrupts are enabled
@@ -48,6 +49,7 @@ char           rsv[2];      // Reserved for future flags
 
 void           Zorch() {Next      = 0;     PollEnt  = 0;
                         Poller    = 0;     FD       = -1;
+                        rdyTime   = 0;
                         isEnabled = false; inQ      = false;
                         rsv[0]    = 0;     rsv[1]   = 0;
                        }
@@ -28,7 +28,32 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <climits>
+#include <vector>
+
 #include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccPrefixTrie.hh"
+
+/******************************************************************************/
+/*                         X r d A c c C a p T r e e                          */
+/******************************************************************************/
+
+// A compiled capability list. Plain capabilities are indexed by path in the
+// trie, with the list position of the first one for each path. Templates are
+// kept in list order so that we can check those ahead of the matching path.
+//
+struct XrdAccCapTree
+{
+struct CapEnt
+      {XrdAccCapability *cap;
+       int               pos;
+       CapEnt() : cap(0), pos(INT_MAX) {}
+       CapEnt(XrdAccCapability *cP, int cpos) : cap(cP), pos(cpos) {}
+      };
+
+XrdAccPrefixTrie<CapEnt> paths;
+std::vector<CapEnt>      tmplts;
+};
 
 /******************************************************************************/
 /*                   E x t e r n a l   R e f e r e n c e s                    */
@@ -46,7 +71,7 @@ XrdAccCapability::XrdAccCapability(char *pathval, XrdAccPrivCaps &privval)
 
 // Do common initialization
 //
-   next = 0; ctmp = 0;
+   next = 0; ctmp = 0; ctree = 0;
    priv.pprivs = privval.pprivs; priv.nprivs = privval.nprivs;
    plen = strlen(pathval); pins = 0; prem = 0;
    pkey = XrdOucHashVal2((const char *)pathval, plen);
@@ -71,10 +96,38 @@ XrdAccCapability::~XrdAccCapability()
      XrdAccCapability *cp, *np = next;
 
      if (path) {free(path); path = 0;}
+     if (ctree) {delete ctree; ctree = 0;}
 
      while(np) {cp = np; np = np->next; cp->next = 0; delete cp;}
      next = 0;
 }
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+  
+void XrdAccCapability::Compile()
+{
+   static const int minCaps = 8;
+   XrdAccCapability *cp;
+   int n = 0;
+
+// Short lists are faster to just run through
+//
+   for (cp = this; cp; cp = cp->next) n++;
+   if (n < minCaps || ctree) return;
+
+// Index each capability. Only the first capability for a path can ever match.
+//
+   ctree = new XrdAccCapTree;
+   n = 0;
+   for (cp = this; cp; cp = cp->next, n++)
+       {if (cp->ctmp) ctree->tmplts.push_back(XrdAccCapTree::CapEnt(cp->ctmp, n));
+           else {XrdAccCapTree::CapEnt &ent = ctree->paths.Add(cp->path, cp->plen);
+                 if (!ent.cap) ent = XrdAccCapTree::CapEnt(cp, n);
+                }
+       }
+}
+
 /******************************************************************************/
 /*                                 P r i v s                                  */
 /******************************************************************************/
@@ -87,6 +140,28 @@ int XrdAccCapability::Privs(      XrdAccPrivCaps &pathpriv,
 {XrdAccCapability *cp=this;
  const int psl = (pathsub ? strlen(pathsub) : 0);
 
+// If the list was compiled, find the first capability whose path is a prefix
+// of ours. A template that precedes it in the list gets first crack. Lists
+// that substitute into the path are always handled the long way.
+//
+ if (ctree && !pathsub)
+    {const XrdAccCapTree::CapEnt *best = 0;
+     ctree->paths.Match(pathname, pathlen,
+                       [&best](const XrdAccCapTree::CapEnt &ent)
+                              {if (!best || ent.pos < best->pos) best = &ent;
+                               return true;
+                              });
+     for (unsigned int i = 0; i < ctree->tmplts.size(); i++)
+         {if (best && ctree->tmplts[i].pos > best->pos) break;
+          if (ctree->tmplts[i].cap->Privs(pathpriv,pathname,pathlen,pathhash))
+             return 1;
+         }
+     if (!best) return 0;
+     pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs | best->cap->priv.pprivs);
+     pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs | best->cap->priv.nprivs);
+     return 1;
+    }
+
  do {if (cp->ctmp)
        {if (cp->ctmp->Privs(pathpriv,pathname,pathlen,pathhash,pathsub))
            return 1;
@@ -36,6 +36,8 @@
 
 #include "XrdAcc/XrdAccPrivs.hh"
 
+struct XrdAccCapTree;
+
 /******************************************************************************/
 /*                      X r d A c c C a p a b i l i t y                       */
 /******************************************************************************/
@@ -45,6 +47,12 @@ class XrdAccCapability
 public:
 void                Add(XrdAccCapability *newcap) {next = newcap;}
 
+// Compile() builds a prefix tree for this capability list when it is long
+// enough for that to pay off. It must be called on the head of the list once
+// the list is complete. Privs() then returns exactly the same results.
+//
+void                Compile();
+
 XrdAccCapability   *Next() {return next;}
 
 // Privs() searches the associated capability for a prefix matching path. If one
@@ -79,7 +87,7 @@ int                 Subcomp(const char *pathname, const int pathlen,
                   XrdAccCapability(char *pathval, XrdAccPrivCaps &privval);
 
                   XrdAccCapability(XrdAccCapability *taddr)
-                        {next = 0; ctmp = taddr;
+                        {next = 0; ctmp = taddr; ctree = 0;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
                         }
 
@@ -87,6 +95,7 @@ int                 Subcomp(const char *pathname, const int pathlen,
 private:
 XrdAccCapability *next;      // -> Next capability
 XrdAccCapability *ctmp;      // -> Capability template
+XrdAccCapTree    *ctree;     // -> Compiled list (list head only)
 
 /*----------- The below fields are valid when template is zero -----------*/
 
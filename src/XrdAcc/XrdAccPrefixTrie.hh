@@ -0,0 +1,154 @@
+#ifndef __ACC_PREFIXTRIE__
+#define __ACC_PREFIXTRIE__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d A c c P r e f i x T r i e . h h                    */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+/******************************************************************************/
+/*                       X r d A c c P r e f i x T r i e                      */
+/******************************************************************************/
+
+//------------------------------------------------------------------------------
+//! A radix tree keyed by path prefix. Rules are added once when they are
+//! loaded. Each lookup then visits only the prefixes of the path being
+//! checked, instead of comparing the path against every rule.
+//------------------------------------------------------------------------------
+
+template<class T>
+class XrdAccPrefixTrie
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Add a prefix to the tree.
+//!
+//! @param  prefix   Pointer to the prefix.
+//! @param  plen     Length of the prefix.
+//!
+//! @return A reference to the value associated with the prefix. The value is
+//!         value-initialized the first time the prefix is added.
+//------------------------------------------------------------------------------
+
+T          &Add(const char *prefix, int plen)
+                {Node *nP = &root;
+                 int i = 0;
+
+                 while(i < plen)
+                      {auto it = nP->Find(prefix[i]);
+                       if (it == nP->kids.end() || (*it)->label[0] != prefix[i])
+                          {Node *kP = new Node;
+                           kP->label.assign(prefix+i, plen-i);
+                           nP->kids.emplace(it, kP);
+                           nP = kP;
+                           break;
+                          }
+                       Node *kP = it->get();
+                       int n = 1, klen = kP->label.size();
+                       while(n < klen && i+n < plen && kP->label[n] == prefix[i+n])
+                            n++;
+                       if (n < klen)
+                          {Node *mP = new Node;
+                           mP->label.assign(kP->label, 0, n);
+                           kP->label.erase(0, n);
+                           it->release();
+                           it->reset(mP);
+                           mP->kids.emplace_back(kP);
+                           kP = mP;
+                          }
+                       nP = kP;
+                       i += n;
+                      }
+                 if (!nP->isSet) {nP->isSet = true; numKeys++;}
+                 return nP->value;
+                }
+
+//------------------------------------------------------------------------------
+//! Visit the value of every added prefix of a path, shortest first.
+//!
+//! @param  path     Pointer to the path.
+//! @param  plen     Length of the path.
+//! @param  func     Callable taking a const T reference. It returns false to
+//!                  stop the walk.
+//------------------------------------------------------------------------------
+
+template<class F>
+void        Match(const char *path, int plen, F func) const
+                 {const Node *nP = &root;
+                  int i = 0;
+
+                  do {if (nP->isSet && !func(nP->value)) return;
+                      if (i >= plen) return;
+                      auto it = nP->Find(path[i]);
+                      if (it == nP->kids.end() || (*it)->label[0] != path[i])
+                         return;
+                      nP = it->get();
+                      int klen = nP->label.size();
+                      if (plen - i < klen
+                      ||  nP->label.compare(0, klen, path+i, klen)) return;
+                      i += klen;
+                     } while(true);
+                 }
+
+//------------------------------------------------------------------------------
+//! Return the number of distinct prefixes in the tree.
+//------------------------------------------------------------------------------
+
+int         Size() const {return numKeys;}
+
+            XrdAccPrefixTrie() : numKeys(0) {}
+           ~XrdAccPrefixTrie() {}
+
+private:
+
+struct Node
+      {typedef std::vector<std::unique_ptr<Node>> KidVec;
+
+       typename KidVec::const_iterator Find(char c) const
+                {return std::lower_bound(kids.begin(), kids.end(), c,
+                        [](const std::unique_ptr<Node> &k, char x)
+                          {return k->label[0] < x;});
+                }
+       typename KidVec::iterator Find(char c)
+                {return std::lower_bound(kids.begin(), kids.end(), c,
+                        [](const std::unique_ptr<Node> &k, char x)
+                          {return k->label[0] < x;});
+                }
+
+       std::string label;
+       KidVec      kids;
+       T           value = T();
+       bool        isSet = false;
+      };
+
+Node root;
+int  numKeys;
+};
+#endif
@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d C k s C a l c a d l e r 3 2 . c c                   */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+/* The scalar implementation of adler32 was derived from zlib; see the zlib
+   license terms in XrdCksCalcadler32.hh. The vector implementation computes
+   the same sums 16 bytes at a time. For a block of bytes x[0..15] added when
+   the running sums are s1 and s2, s1 grows by the sum of x[j] and s2 grows
+   by 16*s1 plus the sum of (16-j)*x[j]. The per-block sums are accumulated
+   in vector lanes and reduced modulo the base every AdlerNMax bytes.
+*/
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define XRDCKS_SSSE3 1
+#include <immintrin.h>
+#endif
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+
+/******************************************************************************/
+/*                         L o c a l   D e f i n e s                          */
+/******************************************************************************/
+
+#define DO1(buf)  {a += *buf++; b += a;}
+#define DO2(buf)  DO1(buf); DO1(buf);
+#define DO4(buf)  DO2(buf); DO2(buf);
+#define DO8(buf)  DO4(buf); DO4(buf);
+#define DO16(buf) DO8(buf); DO8(buf);
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+
+void XrdCksCalcadler32::Update(const char *Buff, int BLen)
+{
+   const unsigned char *buff = (const unsigned char *)Buff;
+
+#ifdef XRDCKS_SSSE3
+   static const bool useVec = (__builtin_cpu_init(),
+                               __builtin_cpu_supports("ssse3"));
+
+   if (useVec && BLen >= 64) {Vector(unSum1, unSum2, buff, BLen); return;}
+#endif
+   Scalar(unSum1, unSum2, buff, BLen);
+}
+
+/******************************************************************************/
+/* Private:                       S c a l a r                                 */
+/******************************************************************************/
+
+void XrdCksCalcadler32::Scalar(unsigned int &s1, unsigned int &s2,
+                               const unsigned char *buff, int blen)
+{
+   unsigned int a = s1, b = s2;
+   int k;
+
+// Work on local copies of the sums as the buffer could alias them
+//
+   while(blen > 0)
+        {k = (blen < AdlerNMax ? blen : AdlerNMax);
+         blen -= k;
+         while(k >= 16) {DO16(buff); k -= 16;}
+         if (k != 0) do {DO1(buff);} while (--k);
+         a %= AdlerBase; b %= AdlerBase;
+        }
+   s1 = a; s2 = b;
+}
+
+/******************************************************************************/
+/* Private:                       V e c t o r                                 */
+/******************************************************************************/
+
+#ifdef XRDCKS_SSSE3
+namespace
+{
+inline unsigned long long Sum32(__m128i v)
+{
+   unsigned int lane[4];
+
+   _mm_storeu_si128((__m128i *)lane, v);
+   return (unsigned long long)lane[0] + lane[1] + lane[2] + lane[3];
+}
+}
+
+__attribute__((target("ssse3")))
+void XrdCksCalcadler32::Vector(unsigned int &s1, unsigned int &s2,
+                               const unsigned char *buff, int blen)
+{
+   const __m128i tap  = _mm_setr_epi8(16,15,14,13,12,11,10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+   const __m128i ones = _mm_set1_epi16(1);
+   const __m128i zero = _mm_setzero_si128();
+   unsigned long long a, b;
+   int n, nBlk = blen / 16;
+
+// Process whole blocks, reducing the sums often enough to avoid overflow
+//
+   blen -= nBlk * 16;
+   while(nBlk > 0)
+        {__m128i vS1 = zero, vPS = zero, vS2 = zero;
+         n = (nBlk < AdlerNMax/16 ? nBlk : AdlerNMax/16);
+         nBlk -= n;
+         a = s1;
+         b = s2 + 16ULL * n * s1;
+         for (int i = 0; i < n; i++)
+             {__m128i v = _mm_loadu_si128((const __m128i *)buff);
+              vPS = _mm_add_epi32(vPS, vS1);
+              vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(v, zero));
+              vS2 = _mm_add_epi32(vS2,
+                    _mm_madd_epi16(_mm_maddubs_epi16(v, tap), ones));
+              buff += 16;
+             }
+         a += Sum32(vS1);
+         b += 16 * Sum32(vPS) + Sum32(vS2);
+         s1 = a % AdlerBase; s2 = b % AdlerBase;
+        }
+
+// Handle whatever is left over
+//
+   if (blen) Scalar(s1, s2, buff, blen);
+}
+#else
+void XrdCksCalcadler32::Vector(unsigned int &s1, unsigned int &s2,
+                               const unsigned char *buff, int blen)
+{
+   Scalar(s1, s2, buff, blen);
+}
+#endif
@@ -40,6 +40,7 @@
   
 #include "XrdCks/XrdCksCalc.hh"
 #include "XrdCks/XrdCksManOss.hh"
+#include "XrdCks/XrdCksPipeline.hh"
 #include "XrdOss/XrdOss.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSys/XrdSysError.hh"
@@ -86,8 +87,8 @@ const char *Pfn2Lfn(const char *Lfn)
 XrdCksManOss::XrdCksManOss(XrdOss *ossX, XrdSysError *erP, int iosz,
                            XrdVersionInfo &vInfo, bool autoload)
              : XrdCksManager(erP, rdSz, vInfo, autoload)
-             {if (rdSz <= 65536) rdSz = 67108864;
-                 else rdSz = ((rdSz/65536) + (rdSz%65536 != 0)) * 65536;
+             {if (iosz <= 65536) rdSz = 67108864;
+                 else rdSz = ((iosz/65536) + (iosz%65536 != 0)) * 65536;
               eDest = erP;
               ossP  = ossX;
              }
@@ -110,6 +111,22 @@ int XrdCksManOss::Calc(const char *Lfn, XrdCksData &Cks, int doSet)
    return XrdCksManager::Calc(Xfn.Pfn, Cks, doSet);
 }
 
+/******************************************************************************/
+
+int XrdCksManOss::Calc(const char *Lfn, XrdCksData *Cks, int csNum, int doSet)
+{
+   int rc;
+   LfnPfn Xfn(Lfn, rc);
+
+// If lfn conversion failed, bail out
+//
+   if (rc) return rc;
+
+// Return the result
+//
+   return XrdCksManager::Calc(Xfn.Pfn, Cks, csNum, doSet);
+}
+
 /******************************************************************************/
   
 int XrdCksManOss::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
@@ -123,10 +140,8 @@ int XrdCksManOss::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
    XrdOucEnv openEnv;
    const char *Lfn = Pfn2Lfn(Pfn);
    struct stat Stat;
-   char  *buffP;
-   off_t  Offset=0, fileSize;
-   size_t ioSize, calcSize;
-   int    rc;
+   off_t  Offset=0, calcSize;
+   int    ioSize, n, rc;
 
 // Open the input file
 //
@@ -136,24 +151,28 @@ int XrdCksManOss::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
 //
    if ((rc = In.fP->Fstat(&Stat))) return (rc > 0 ? -rc : rc);
    if (!(Stat.st_mode & S_IFREG)) return -EPERM;
-   calcSize = fileSize = Stat.st_size;
+   calcSize = Stat.st_size;
    MTime = Stat.st_mtime;
+   if (!calcSize) return 0;
 
-// Compute read size and allocate a buffer
+// Compute read size and allocate two buffers, each half the read size but
+// capped, so that one can be read while the other is checksummed.
 //
-   ioSize = (fileSize < (off_t)rdSz ? fileSize : rdSz); rc = 0;
-   buffP  = (char *)malloc(ioSize);
-   if (!buffP) return -ENOMEM;
+   ioSize = XrdCksPipeline::BuffSize(rdSz, calcSize);
+   XrdCksPipeline Pipe(csP, ioSize);
+   if (!Pipe.Ready()) return -ENOMEM;
 
-// We now compute checksum 64MB at a time using mmap I/O
+// We now compute the checksum, reading the next segment while the previous
+// one is being checksummed
 //
    while(calcSize)
-        {if ((rc= In.fP->Read(buffP, Offset, ioSize)) < 0) break;
-         csP->Update(buffP, ioSize);
-         calcSize -= ioSize; Offset += ioSize;
-         if (calcSize < (size_t)ioSize) ioSize = calcSize;
+        {n = (calcSize < (off_t)ioSize ? calcSize : ioSize);
+         if ((rc = In.fP->Read(Pipe.Buffer(), Offset, n)) < 0) break;
+         if (rc != n) {rc = -EIO; break;}
+         Pipe.Update(n);
+         calcSize -= n; Offset += n;
         }
-   free(buffP);
+   Pipe.Wait();
 
 // Issue error message if we have an error
 //
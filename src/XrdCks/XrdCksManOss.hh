@@ -64,6 +64,10 @@ protected:
 virtual int         Calc(const char *Lfn, time_t &MTime, XrdCksCalc *CksObj);
 virtual int         ModTime(const char *Pfn, time_t &MTime);
 
+public:
+virtual int         Calc(const char *Lfn, XrdCksData *Cks, int csNum,
+                         int doSet=1);
+
 private:
 
 int buffSZ;
@@ -34,7 +34,6 @@
 #include <ctime>
 #include <cstdio>
 #include <unistd.h>
-#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
   
@@ -45,6 +44,7 @@
 #include "XrdCks/XrdCksCalcmd5.hh"
 #include "XrdCks/XrdCksLoader.hh"
 #include "XrdCks/XrdCksManager.hh"
+#include "XrdCks/XrdCksPipeline.hh"
 #include "XrdCks/XrdCksXAttr.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
 #include "XrdOuc/XrdOucTokenizer.hh"
@@ -59,6 +59,38 @@
 #define ENOATTR ENODATA
 #endif
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// A calculator that passes each segment to several calculators so that the
+// file need only be read once. It is never asked for a value of its own.
+//
+class CalcMany : public XrdCksCalc
+{
+public:
+
+char       *Final() {return 0;}
+
+void        Init() {for (int i = 0; i < csNum; i++) csP[i]->Init();}
+
+XrdCksCalc *New() {return 0;}
+
+const char *Type(int &csSize) {csSize = 0; return "many";}
+
+void        Update(const char *Buff, int BLen)
+                  {for (int i = 0; i < csNum; i++) csP[i]->Update(Buff, BLen);}
+
+XrdCksCalc *csP[8];  // At most XrdCksManager::csMax
+int         csNum;
+
+            CalcMany() : csNum(0) {}
+           ~CalcMany() {for (int i = 0; i < csNum; i++) csP[i]->Recycle();}
+};
+}
+
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
@@ -147,6 +179,54 @@ int XrdCksManager::Calc(const char *Pfn, XrdCksData &Cks, int doSet)
    return rc;
 }
 
+/******************************************************************************/
+
+int XrdCksManager::Calc(const char *Pfn, XrdCksData *Cks, int csNum, int doSet)
+{
+   CalcMany csMany;
+   csInfo  *csIP[csMax];
+   time_t   MTime;
+   int      i, rc;
+
+// Determine which checksums to get
+//
+   if (csLast < 0) return -ENOTSUP;
+   if (csNum < 1 || csNum > csMax) return -EINVAL;
+   for (i = 0; i < csNum; i++)
+       {if (!(*Cks[i].Name)) Cks[i].Set((csIP[i] = &csTab[0])->Name);
+           else if (!(csIP[i] = Find(Cks[i].Name))) return -ENOTSUP;
+       }
+
+// Obtain a new checksum object for each one
+//
+   for (i = 0; i < csNum; i++)
+       {if (!(csMany.csP[i] = csIP[i]->Obj->New())) return -ENOMEM;
+        csMany.csNum++;
+       }
+
+// Compute all of the checksums reading the file only once
+//
+   if ((rc = Calc(Pfn, MTime, &csMany))) return rc;
+
+// Return the results, setting them if so wanted
+//
+   for (i = 0; i < csNum; i++)
+       {memcpy(Cks[i].Value, csMany.csP[i]->Final(), csIP[i]->Len);
+        Cks[i].fmTime = static_cast<long long>(MTime);
+        Cks[i].csTime = static_cast<int>(time(0) - MTime);
+        Cks[i].Length = csIP[i]->Len;
+        if (doSet)
+           {XrdOucXAttr<XrdCksXAttr> xCS;
+            memcpy(&xCS.Attr.Cks, &Cks[i], sizeof(xCS.Attr.Cks));
+            if ((rc = xCS.Set(Pfn))) return -rc;
+           }
+       }
+
+// All done
+//
+   return 0;
+}
+
 /******************************************************************************/
   
 int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
@@ -158,10 +238,10 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
             ~ioFD() {if (FD >= 0) close(FD);}
         } In;
    struct stat Stat;
-   char *inBuff;
-   off_t  Offset=0, fileSize;
-   size_t ioSize, calcSize;
-   int rc;
+   char   *inBuff;
+   off_t   Offset=0, calcSize;
+   ssize_t rdLen;
+   int     ioSize, n, rc = 0;
 
 // Open the input file
 //
@@ -171,34 +251,43 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
 //
    if (fstat(In.FD, &Stat)) return -errno;
    if (!(Stat.st_mode & S_IFREG)) return -EPERM;
-   calcSize = fileSize = Stat.st_size;
+   calcSize = Stat.st_size;
    MTime = Stat.st_mtime;
+   if (!calcSize) return 0;
+#ifdef __linux__
+   posix_fadvise(In.FD, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+// Each of the two buffers is half the i/o size, but no more than a few MB as
+// many checksums may be computed at the same time. Small files only need a
+// small buffer.
+//
+   ioSize = XrdCksPipeline::BuffSize(segSize, calcSize);
+   XrdCksPipeline Pipe(csP, ioSize);
+   if (!Pipe.Ready()) return -ENOMEM;
 
-// We now compute checksum 64MB at a time using mmap I/O
+// Read the file segment by segment. Each segment is checksummed while the
+// next one is being read.
 //
-   ioSize = (fileSize < (off_t)segSize ? fileSize : segSize); rc = 0;
    while(calcSize)
-        {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
-#if defined(__FreeBSD__)
-                       MAP_RESERVED0040|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#elif defined(__GNU__)
-                       MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#else
-                       MAP_NORESERVE|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#endif
-            {rc = errno; eDest->Emsg("Cks", rc, "memory map", Pfn); break;}
-         madvise(inBuff, ioSize, MADV_SEQUENTIAL);
-         csP->Update(inBuff, ioSize);
-         calcSize -= ioSize; Offset += ioSize;
-         if (munmap(inBuff, ioSize) < 0)
-            {rc = errno; eDest->Emsg("Cks",rc,"unmap memory for",Pfn); break;}
-         if (calcSize < (size_t)segSize) ioSize = calcSize;
+        {n = (calcSize < (off_t)ioSize ? calcSize : ioSize);
+         inBuff = Pipe.Buffer();
+         for (int got = 0; got < n; got += rdLen)
+             {if ((rdLen = pread(In.FD, inBuff+got, n-got, Offset+got)) <= 0)
+                 {if (rdLen < 0 && errno == EINTR) {rdLen = 0; continue;}
+                  rc = (rdLen ? errno : EIO);
+                  break;
+                 }
+             }
+         if (rc) {eDest->Emsg("Cks", rc, "read", Pfn); break;}
+         Pipe.Update(n);
+         calcSize -= n; Offset += n;
         }
 
-// Return if we failed
+// Wait for the checksum to be computed
 //
-   if (calcSize) return (rc ? -rc : -EIO);
-   return 0;
+   Pipe.Wait();
+   return (rc ? -rc : 0);
 }
 
 /******************************************************************************/
@@ -79,7 +79,9 @@ protected:
 /* Calc()     returns 0 if the checksum was successfully calculated using the
               supplied CksObj and places the file's modification time in MTime.
               Otherwise, it returns -errno. The default implementation uses
-              open(), fstat(), mmap(), and unmap() to calculate the results.
+              open(), fstat(), and pread() into two alternating buffers,
+              computing the checksum on a dedicated thread pool while the
+              next segment is read.
 */
 virtual int         Calc(const char *Pfn, time_t &MTime, XrdCksCalc *CksObj);
 
@@ -88,6 +90,18 @@ virtual int         Calc(const char *Pfn, time_t &MTime, XrdCksCalc *CksObj);
 */
 virtual int         ModTime(const char *Pfn, time_t &MTime);
 
+public:
+
+/* Calc()     computes several checksums reading the file only once. Each
+              element of Cks names a checksum (an empty name means the default
+              one) and receives its value. When doSet is true, each checksum is
+              also recorded. The file is read by the protected Calc() above.
+              Returns 0 upon success and -errno otherwise. It is declared last
+              so that the virtual table of existing plugins is not changed.
+*/
+virtual int         Calc( const char *Pfn, XrdCksData *Cks, int csNum,
+                          int doSet=1);
+
 private:
 
 struct csInfo
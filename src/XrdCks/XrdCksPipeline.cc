@@ -0,0 +1,126 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d C k s P i p e l i n e . c c                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdlib>
+#include <unistd.h>
+
+#include "Xrd/XrdScheduler.hh"
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksPipeline.hh"
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+XrdSysMutex   schedMutex;
+XrdScheduler *schedP = 0;
+
+// Checksum calculations get their own thread pool so that long running ones
+// do not compete with client requests for the server's worker threads. Jobs
+// are queued when all of the pool's threads are busy.
+//
+XrdScheduler *Sched()
+{
+   XrdSysMutexHelper mHelp(schedMutex);
+
+   if (!schedP)
+      {schedP = new XrdScheduler(4, 64, 60);
+       schedP->Start();
+      }
+   return schedP;
+}
+}
+
+const int XrdCksPipeline::maxBsz;
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdCksPipeline::XrdCksPipeline(XrdCksCalc *csP, int bsz)
+               : doneSem(0), isPend(false), bufN(0)
+{
+   static const int pgSz = getpagesize();
+
+// Set up the task that updates the checksum
+//
+   task.csP  = csP;
+   task.done = &doneSem;
+
+// Allocate the two segment buffers
+//
+   bufP[0] = bufP[1] = 0;
+   if (posix_memalign((void **)&bufP[0], pgSz, bsz)
+   ||  posix_memalign((void **)&bufP[1], pgSz, bsz)) bufP[1] = 0;
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdCksPipeline::~XrdCksPipeline()
+{
+   Wait();
+   if (bufP[0]) free(bufP[0]);
+   if (bufP[1]) free(bufP[1]);
+}
+
+/******************************************************************************/
+/*                                  D o I t                                   */
+/******************************************************************************/
+
+void XrdCksPipeline::Task::DoIt()
+{
+   csP->Update(buff, blen);
+   done->Post();
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+
+void XrdCksPipeline::Update(int blen)
+{
+
+// Wait for the previous segment. This keeps the segments in order and frees
+// the buffer that will be returned by Buffer().
+//
+   Wait();
+
+// Schedule the update over this segment
+//
+   task.buff = bufP[bufN];
+   task.blen = blen;
+   isPend    = true;
+   Sched()->Schedule(&task);
+
+// Switch to the other buffer
+//
+   bufN ^= 1;
+}
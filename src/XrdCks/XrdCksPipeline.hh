@@ -0,0 +1,141 @@
+#ifndef __XRDCKSPIPELINE_HH__
+#define __XRDCKSPIPELINE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d C k s P i p e l i n e . h h                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+#include "Xrd/XrdJob.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCksCalc;
+
+//------------------------------------------------------------------------------
+//! Compute a checksum over a stream of file segments. The caller reads each
+//! segment into Buffer() and passes it to Update(), which hands the segment
+//! to the checksum calculator on the checksum thread pool and returns so that
+//! the next segment can be read into the other buffer while the calculation
+//! proceeds. The calculator sees the segments in order.
+//------------------------------------------------------------------------------
+
+class XrdCksPipeline
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Get the buffer into which the next segment is to be read.
+//!
+//! @return Pointer to a page aligned buffer of the size given to the
+//!         constructor.
+//------------------------------------------------------------------------------
+
+char *Buffer() {return bufP[bufN];}
+
+//------------------------------------------------------------------------------
+//! Get the size to use for each of the two segment buffers.
+//!
+//! @param  iosz     The configured i/o size.
+//! @param  fsz      The size of the file.
+//!
+//! @return Half the i/o size, capped at maxBsz, or the file size if smaller.
+//------------------------------------------------------------------------------
+
+static int BuffSize(int iosz, off_t fsz)
+                   {int bsz = (iosz/2 < maxBsz ? iosz/2 : maxBsz);
+                    return (fsz < (off_t)bsz ? (int)fsz : bsz);
+                   }
+
+//------------------------------------------------------------------------------
+//! Check whether the buffers could be allocated.
+//!
+//! @return true if the object is usable, false otherwise (i.e. ENOMEM).
+//------------------------------------------------------------------------------
+
+bool  Ready() {return bufP[1] != 0;}
+
+//------------------------------------------------------------------------------
+//! Schedule the calculation of the checksum over the segment just read into
+//! Buffer(). This waits for the previous segment to be fully processed.
+//!
+//! @param  blen     The number of bytes in the segment.
+//------------------------------------------------------------------------------
+
+void  Update(int blen);
+
+//------------------------------------------------------------------------------
+//! Wait for the scheduled calculation to complete. This must be called
+//! before the calculator's result is obtained.
+//------------------------------------------------------------------------------
+
+void  Wait() {if (isPend) {doneSem.Wait(); isPend = false;}}
+
+//------------------------------------------------------------------------------
+//! Constructor
+//!
+//! @param  csP      Pointer to the checksum calculator.
+//! @param  bsz      The size of each of the two segment buffers.
+//------------------------------------------------------------------------------
+
+      XrdCksPipeline(XrdCksCalc *csP, int bsz);
+
+//------------------------------------------------------------------------------
+//! Destructor; waits for outstanding calculations.
+//------------------------------------------------------------------------------
+
+     ~XrdCksPipeline();
+
+//------------------------------------------------------------------------------
+//! The largest buffer size; this bounds the memory used by each checksum
+//! calculation (two buffers) regardless of the configured i/o size.
+//------------------------------------------------------------------------------
+
+static const int maxBsz = 4*1024*1024;
+
+private:
+
+class Task : public XrdJob
+{
+public:
+void        DoIt();
+
+XrdCksCalc      *csP;
+const char      *buff;
+XrdSysSemaphore *done;
+int              blen;
+
+            Task() : XrdJob("checksum update"), csP(0), buff(0), done(0),
+                     blen(0) {}
+           ~Task() {}
+};
+
+Task            task;
+char           *bufP[2];
+XrdSysSemaphore doneSem;
+bool            isPend;
+int             bufN;
+};
+#endif
@@ -95,7 +95,9 @@ namespace XrdCl
   const int DefaultWantTlsOnNoPgrw         = 0;
   const int DefaultRetryWrtAtLBLimit       = 3;
   const int DefaultCpRetry                 = 0;
+  const int DefaultDirListParallel         = 16;
   const int DefaultCpUsePgWrtRd            = 1;
+  const int DefaultTlsReuse                = 1;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -161,7 +163,9 @@ namespace XrdCl
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
       { to_lower( "WantTlsOnNoPgrw" ),         DefaultWantTlsOnNoPgrw },
-      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit }
+      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit },
+      { to_lower( "DirListParallel" ),         DefaultDirListParallel },
+      { to_lower( "TlsReuse" ),                DefaultTlsReuse }
     };
 
   static std::unordered_map<std::string, std::string> theDefaultStrs
@@ -36,11 +36,13 @@
 #include "XrdCl/XrdClPlugInManager.hh"
 #include "XrdCl/XrdClLocalFileTask.hh"
 #include "XrdCl/XrdClZipListHandler.hh"
+#include "XrdCl/XrdClUtils.hh"
 #include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
 #include <sys/stat.h>
 
+#include <deque>
 #include <memory>
 #include <algorithm>
 #include <iterator>
@@ -492,12 +494,16 @@ namespace
       RecursiveDirListCtx( const XrdCl::URL &url, const std::string &path,
                            XrdCl::DirListFlags::Flags flags,
                            XrdCl::ResponseHandler *handler, time_t expires ) :
-                             finalst( 0 ), pending( 1 ),
+                             finalst( 0 ), pending( 1 ), inflight( 1 ),
                              dirList( new XrdCl::DirectoryList() ), expires( expires ),
                              handler( handler ), flags( flags ),
                              fs( new XrdCl::FileSystem( url ) )
       {
         dirList->SetParentName( path );
+
+        int val = XrdCl::DefaultDirListParallel;
+        XrdCl::DefaultEnv::GetEnv()->GetInt( "DirListParallel", val );
+        parallel = val > 0 ? val : 1;
       }
 
       ~RecursiveDirListCtx()
@@ -524,7 +530,10 @@ namespace
       }
 
       XrdCl::XRootDStatus        *finalst;
-      int                         pending;
+      int                         pending;  // queued and in-flight dirlists
+      int                         inflight; // dirlists sent to the server
+      int                         parallel; // max number of in-flight dirlists
+      std::deque<std::string>     queue;    // directories not yet listed
       XrdCl::DirectoryList       *dirList;
       time_t                      expires;
       XrdCl::ResponseHandler     *handler;
@@ -571,7 +580,10 @@ namespace
         // has been chunked), if not we can decrement the number of pending
         // DieLists
         if( finalrsp )
+        {
           --pCtx->pending;
+          --pCtx->inflight;
+        }
 
         pCtx->UpdateStatus( *status );
 
@@ -605,45 +617,19 @@ namespace
                 new DirectoryList::ListEntry( entry->GetHostAddress(), path, info );
             pCtx->dirList->Add( e );
 
-            // if it's a directory do a recursive call
+            // if it's a directory queue it, it will be listed as soon as
+            // the number of in-flight dirlists allows for it
             if( info->TestFlags( StatInfo::IsDir ) )
             {
-              // bump the pending counter
               ++pCtx->pending;
-              // switch of the recursive flag, we will
-              // provide the respective handler ourself,
-              // make sure that stat is on
-              DirListFlags::Flags flags = ( pCtx->flags & (~DirListFlags::Recursive) )
-                                          | DirListFlags::Stat;
-              // the recursive dir list handler
-              RecursiveDirListHandler *handler = new RecursiveDirListHandler( pCtx );
-              // timeout
-              time_t timeout = 0;
-              if( pCtx->expires )
-              {
-                timeout = pCtx->expires - ::time( 0 );
-                if( timeout <= 0 )
-                {
-                  log->Error( FileMsg, "Recursive directory list operation for %s expired.",
-                              parent.c_str() );
-                  pCtx->UpdateStatus( XRootDStatus( stError, errOperationExpired ) );
-                  break;
-                }
-              }
-              // send the request
-              std::string child = parent + path;
-              XRootDStatus st = pCtx->fs->DirList( child, flags, handler, timeout );
-              if( !st.IsOK() )
-              {
-                log->Error( FileMsg, "Recursive directory list operation for %s failed: ",
-                            child.c_str(), st.ToString().c_str() );
-                pCtx->UpdateStatus( st );
-                continue;
-              }
+              pCtx->queue.push_back( parent + path );
             }
           }
         }
 
+        // send as many of the queued dirlists as we are allowed to
+        Dispatch();
+
         // if there are no more outstanding dirlist queries we can finalize the request
         if( pCtx->pending == 0 )
         {
@@ -678,6 +664,59 @@ namespace
 
     private:
 
+      //------------------------------------------------------------------------
+      // Send queued dirlist requests until the parallelism limit is reached,
+      // must be called with the context mutex locked
+      //------------------------------------------------------------------------
+      void Dispatch()
+      {
+        using namespace XrdCl;
+
+        Log *log = DefaultEnv::GetLog();
+
+        // switch of the recursive flag, we will provide the respective handler
+        // ourself, make sure that stat is on and ask for a chunked response
+        // so that we can process the entries as they arrive
+        DirListFlags::Flags flags = ( pCtx->flags & (~DirListFlags::Recursive) )
+                                    | DirListFlags::Stat | DirListFlags::Chunked;
+
+        while( pCtx->inflight < pCtx->parallel && !pCtx->queue.empty() )
+        {
+          std::string child = pCtx->queue.front();
+          pCtx->queue.pop_front();
+
+          // timeout
+          time_t timeout = 0;
+          if( pCtx->expires )
+          {
+            timeout = pCtx->expires - ::time( 0 );
+            if( timeout <= 0 )
+            {
+              log->Error( FileMsg, "Recursive directory list operation for %s expired.",
+                          child.c_str() );
+              pCtx->UpdateStatus( XRootDStatus( stError, errOperationExpired ) );
+              pCtx->pending -= pCtx->queue.size() + 1;
+              pCtx->queue.clear();
+              break;
+            }
+          }
+
+          // send the request
+          RecursiveDirListHandler *handler = new RecursiveDirListHandler( pCtx );
+          XRootDStatus st = pCtx->fs->DirList( child, flags, handler, timeout );
+          if( !st.IsOK() )
+          {
+            log->Error( FileMsg, "Recursive directory list operation for %s failed: %s",
+                        child.c_str(), st.ToString().c_str() );
+            delete handler;
+            pCtx->UpdateStatus( st );
+            --pCtx->pending;
+            continue;
+          }
+          ++pCtx->inflight;
+        }
+      }
+
       RecursiveDirListCtx *pCtx;
   };
 
@@ -857,6 +896,153 @@ namespace
       std::set<ListEntry*, less>  uniquesofar;
       XrdCl::ResponseHandler     *pHandler;
   };
+
+  //----------------------------------------------------------------------------
+  // Common context of the individual stats making up a batched stat that the
+  // server cannot handle in one request
+  //----------------------------------------------------------------------------
+  struct StatBatchCtx
+  {
+      StatBatchCtx( const std::vector<std::string> &paths,
+                    XrdCl::ResponseHandler         *handler ) :
+        paths( paths ), results( paths.size() ), pending( paths.size() ),
+        handler( handler )
+      {
+      }
+
+      ~StatBatchCtx()
+      {
+        for( size_t i = 0; i < results.size(); ++i )
+          delete results[i].second;
+      }
+
+      std::vector<std::string>                                   paths;
+      std::vector<std::pair<XrdCl::XRootDStatus, XrdCl::StatInfo*> > results;
+      size_t                                                     pending;
+      XrdSysMutex                                                mtx;
+      XrdCl::ResponseHandler                                    *handler;
+  };
+
+  //----------------------------------------------------------------------------
+  // Handle the stat of a single path of a batch, the last one to complete
+  // hands the whole list to the user's handler
+  //----------------------------------------------------------------------------
+  class StatBatchHandler: public XrdCl::ResponseHandler
+  {
+    public:
+
+      StatBatchHandler( StatBatchCtx *ctx, size_t index ) :
+        pCtx( ctx ), pIndex( index )
+      {
+
+      }
+
+      virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                   XrdCl::AnyObject    *response )
+      {
+        using namespace XrdCl;
+
+        StatInfo *info = 0;
+        if( status->IsOK() && response )
+          response->Get( info );
+        if( response )
+          response->Set( (StatInfo*)0 );
+
+        bool last;
+        {
+          XrdSysMutexHelper lck( pCtx->mtx );
+          pCtx->results[pIndex] = std::make_pair( *status, info );
+          last = ( --pCtx->pending == 0 );
+        }
+        delete status;
+        delete response;
+
+        if( last )
+        {
+          StatInfoList *list = new StatInfoList();
+          for( size_t i = 0; i < pCtx->paths.size(); ++i )
+          {
+            list->Add( new StatInfoList::ListEntry( pCtx->paths[i],
+                                                    pCtx->results[i].first,
+                                                    pCtx->results[i].second ) );
+            pCtx->results[i].second = 0;
+          }
+          AnyObject *obj = new AnyObject();
+          obj->Set( list );
+          pCtx->handler->HandleResponse( new XRootDStatus(), obj );
+          delete pCtx;
+        }
+        delete this;
+      }
+
+    private:
+
+      StatBatchCtx *pCtx;
+      size_t        pIndex;
+  };
+
+  //----------------------------------------------------------------------------
+  // Stat each path of a batch with a request of its own
+  //----------------------------------------------------------------------------
+  void StatEach( XrdCl::FileSystem              *fs,
+                 const std::vector<std::string> &paths,
+                 XrdCl::ResponseHandler         *handler,
+                 uint16_t                        timeout )
+  {
+    using namespace XrdCl;
+
+    StatBatchCtx *ctx = new StatBatchCtx( paths, handler );
+    for( size_t i = 0; i < paths.size(); ++i )
+    {
+      StatBatchHandler *hdlr = new StatBatchHandler( ctx, i );
+      XRootDStatus st = fs->Stat( paths[i], hdlr, timeout );
+      if( !st.IsOK() )
+        hdlr->HandleResponse( new XRootDStatus( st ), 0 );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Handle the response to a batched stat, falling back to one stat per path
+  // if the server refuses the batch (e.g. because it would be redirected)
+  //----------------------------------------------------------------------------
+  class StatBatchFallbackHandler: public XrdCl::ResponseHandler
+  {
+    public:
+
+      StatBatchFallbackHandler( XrdCl::FileSystem              *fs,
+                                const std::vector<std::string> &paths,
+                                XrdCl::ResponseHandler         *handler,
+                                uint16_t                        timeout ) :
+        pFS( fs ), pPaths( paths ), pHandler( handler ), pTimeout( timeout )
+      {
+
+      }
+
+      virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                   XrdCl::AnyObject    *response )
+      {
+        using namespace XrdCl;
+
+        if( status->code == errErrorResponse &&
+            status->errNo == kXR_Unsupported )
+        {
+          DefaultEnv::GetLog()->Debug( FileSystemMsg, "Batched stat refused "
+                                       "by the server; stating each path." );
+          delete status;
+          delete response;
+          StatEach( pFS, pPaths, pHandler, pTimeout );
+        }
+        else pHandler->HandleResponse( status, response );
+        delete this;
+      }
+
+    private:
+
+      XrdCl::FileSystem        *pFS;
+      std::vector<std::string>  pPaths;
+      XrdCl::ResponseHandler   *pHandler;
+      uint16_t                  pTimeout;
+  };
 }
 
 namespace XrdCl
@@ -1574,6 +1760,73 @@ namespace XrdCl
     return MessageUtils::WaitForResponse( &handler, response );
   }
 
+  //----------------------------------------------------------------------------
+  // Obtain status information for several paths in one request - async
+  //----------------------------------------------------------------------------
+  XRootDStatus FileSystem::StatBatch( const std::vector<std::string> &paths,
+                                      ResponseHandler                *handler,
+                                      uint16_t                        timeout )
+  {
+    if( pPlugIn || pImpl->fsdata->pUrl->IsLocalFile() )
+      return XRootDStatus( stError, errNotSupported );
+
+    std::string pathList;
+    for( size_t i = 0; i < paths.size(); ++i )
+    {
+      if( paths[i].empty() || paths[i].find( '\n' ) != std::string::npos )
+        return XRootDStatus( stError, errInvalidArgs );
+      if( i ) pathList += '\n';
+      pathList += FilterXrdClCgi( paths[i] );
+    }
+    if( pathList.empty() )
+      return XRootDStatus( stError, errInvalidArgs );
+
+    //--------------------------------------------------------------------------
+    // Servers that do not support kXR_sxfull, redirectors (which cannot
+    // redirect each path on its own) and servers that we are not yet
+    // connected to get one stat request per path
+    //--------------------------------------------------------------------------
+    if( !Utils::HasStatxFull( *pImpl->fsdata->pUrl ) )
+    {
+      StatEach( this, paths, handler, timeout );
+      return XRootDStatus();
+    }
+
+    Message           *msg;
+    ClientStatRequest *req;
+    MessageUtils::CreateRequest( msg, req, pathList.length() );
+
+    req->requestid  = kXR_statx;
+    req->options    = kXR_sxfull;
+    req->dlen       = pathList.length();
+    msg->Append( pathList.c_str(), pathList.length(), 24 );
+    MessageSendParams params; params.timeout = timeout;
+    MessageUtils::ProcessSendParams( params );
+    XRootDTransport::SetDescription( msg );
+
+    StatBatchFallbackHandler *hdlr =
+      new StatBatchFallbackHandler( this, paths, handler, timeout );
+    XRootDStatus st = FileSystemData::Send( pImpl->fsdata, msg, hdlr, params );
+    if( !st.IsOK() )
+      delete hdlr;
+    return st;
+  }
+
+  //----------------------------------------------------------------------------
+  // Obtain status information for several paths in one request - sync
+  //----------------------------------------------------------------------------
+  XRootDStatus FileSystem::StatBatch( const std::vector<std::string> &paths,
+                                      StatInfoList                  *&response,
+                                      uint16_t                        timeout )
+  {
+    SyncResponseHandler handler;
+    Status st = StatBatch( paths, &handler, timeout );
+    if( !st.IsOK() )
+      return st;
+
+    return MessageUtils::WaitForResponse( &handler, response );
+  }
+
   //----------------------------------------------------------------------------
   // Obtain status information for a path - async
   //----------------------------------------------------------------------------
@@ -1693,12 +1946,18 @@ namespace XrdCl
     if( flags & DirListFlags::Recursive )
       handler = new RecursiveDirListHandler( *pImpl->fsdata->pUrl, url.GetPath(), flags, handler, timeout );
 
+    //--------------------------------------------------------------------------
+    // The recursive handler consumes chunked responses so that entries are
+    // processed, and subdirectories listed, while the response is streamed
+    //--------------------------------------------------------------------------
+    bool chunked = flags & ( DirListFlags::Chunked | DirListFlags::Recursive );
+
     if( flags & DirListFlags::Merge )
-      handler = new MergeDirListHandler( flags & DirListFlags::Chunked, handler );
+      handler = new MergeDirListHandler( chunked, handler );
 
     msg->Append( fPath.c_str(), fPath.length(), 24 );
     MessageSendParams params; params.timeout = timeout;
-    if( flags & DirListFlags::Chunked )
+    if( chunked )
       params.chunkedResponse = true;
     MessageUtils::ProcessSendParams( params );
     XRootDTransport::SetDescription( msg );
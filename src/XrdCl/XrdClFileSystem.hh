@@ -550,6 +550,44 @@ namespace XrdCl
                          uint16_t            timeout = 0 )
                          XRD_WARN_UNUSED_RESULT;
 
+      //------------------------------------------------------------------------
+      //! Obtain status information for several paths in one request - async
+      //!
+      //! Servers that do not support batched stats, redirectors, as well as
+      //! a server that has not been connected to yet, are sent one stat
+      //! request per path. The same happens when a batch would have to be
+      //! redirected, since its paths may live on different servers.
+      //!
+      //! @param paths   file/directory paths, none may contain a newline
+      //! @param handler handler to be notified when the response arrives,
+      //!                the response parameter will hold a StatInfoList
+      //!                object with one entry per path, in request order,
+      //!                if the procedure is successful; a path that could
+      //!                not be stated does not fail the whole request
+      //! @param timeout timeout value, if 0 the environment default will
+      //!                be used
+      //! @return        status of the operation
+      //------------------------------------------------------------------------
+      XRootDStatus StatBatch( const std::vector<std::string> &paths,
+                              ResponseHandler                *handler,
+                              uint16_t                        timeout = 0 )
+                              XRD_WARN_UNUSED_RESULT;
+
+      //------------------------------------------------------------------------
+      //! Obtain status information for several paths in one request - sync
+      //!
+      //! @param paths    file/directory paths, none may contain a newline
+      //! @param response the response (to be deleted by the user only if the
+      //!                 procedure is successful)
+      //! @param timeout  timeout value, if 0 the environment default will
+      //!                 be used
+      //! @return         status of the operation
+      //------------------------------------------------------------------------
+      XRootDStatus StatBatch( const std::vector<std::string> &paths,
+                              StatInfoList                  *&response,
+                              uint16_t                        timeout = 0 )
+                              XRD_WARN_UNUSED_RESULT;
+
       //------------------------------------------------------------------------
       //! Obtain status information for a Virtual File System - async
       //!
@@ -121,6 +121,19 @@ namespace XrdCl
     //----------------------------------------------------------------------
     if( !tlsContext.isOK() ) throw std::runtime_error( emsg );
 
+    //----------------------------------------------------------------------
+    // Unless disabled, remember sessions so that subsequent connections to
+    // the same host can skip the full handshake.
+    //----------------------------------------------------------------------
+    static const bool tlsReuse = []()
+    {
+      int val = DefaultTlsReuse;
+      DefaultEnv::GetEnv()->GetInt( "TlsReuse", val );
+      if( val ) tlsContext.SessionCache( XrdTlsContext::scClnt );
+      return val != 0;
+    }();
+    (void)tlsReuse;
+
     pTls.reset(
         new XrdTlsSocket( tlsContext, pSocket->GetFD(), XrdTlsSocket::TLS_RNB_WNB,
                           XrdTlsSocket::TLS_HS_NOBLK, true ) );
@@ -273,6 +273,25 @@ namespace XrdCl
         return protver >= kXR_PROTPGRWVERSION;
       }
 
+      //------------------------------------------------------------------------
+      //! Check if given server returns full results for batched stats
+      //! @param url : URL pointing to the server
+      //! @return    : true if yes, false otherwise (or if not yet connected)
+      //------------------------------------------------------------------------
+      inline static bool HasStatxFull( const XrdCl::URL &url )
+      {
+        if( url.IsLocalFile() ) return false;
+        XrdCl::AnyObject  qryResult;
+        XrdCl::XRootDStatus st = XrdCl::DefaultEnv::GetPostMaster()->
+            QueryTransport( url, XrdCl::XRootDQuery::ServerFlags, qryResult );
+        if( !st.IsOK() ) return false;
+        int *flags = 0;
+        qryResult.Get( flags );
+        bool hasIt = ( *flags & kXR_supsxfull );
+        delete flags;
+        return hasIt;
+      }
+
       //------------------------------------------------------------------------
       //! Split chunks in a ChunkList into one or more ChunkLists
       //! @param listsvec        : output vector of ChunkLists
@@ -1388,6 +1388,40 @@ namespace XrdCl
         return Status();
       }
 
+      //------------------------------------------------------------------------
+      // kXR_statx, only the full form carries anything worth parsing
+      //------------------------------------------------------------------------
+      case kXR_statx:
+      {
+        if( !( req->stat.options & kXR_sxfull ) )
+          return Status();
+
+        AnyObject    *obj  = new AnyObject();
+        StatInfoList *data = new StatInfoList();
+        std::string   paths( pRequest->GetBuffer( 24 ), req->stat.dlen );
+
+        char *nullBuffer = new char[length+1];
+        nullBuffer[length] = 0;
+        memcpy( nullBuffer, buffer, length );
+
+        log->Dump( XRootDMsg, "[%s] Parsing the response to %s as "
+                   "StatInfoList: %s", pUrl.GetHostId().c_str(),
+                   pRequest->GetDescription().c_str(), nullBuffer );
+
+        if( data->ParseServerResponse( paths, nullBuffer ) == false )
+        {
+            delete obj;
+            delete data;
+            delete [] nullBuffer;
+            return Status( stError, errInvalidResponse );
+        }
+        delete [] nullBuffer;
+
+        obj->Set( data );
+        response = obj;
+        return Status();
+      }
+
       //------------------------------------------------------------------------
       // kXR_protocol
       //------------------------------------------------------------------------
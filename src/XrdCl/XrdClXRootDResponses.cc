@@ -591,6 +591,65 @@ namespace XrdCl
     return !dat.compare( 0, dStatPrefix.size(), dStatPrefix );
   }
 
+  //----------------------------------------------------------------------------
+  // StatInfoList constructor
+  //----------------------------------------------------------------------------
+  StatInfoList::StatInfoList()
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  StatInfoList::~StatInfoList()
+  {
+    for( size_t i = 0; i < pList.size(); ++i )
+      delete pList[i];
+  }
+
+  //----------------------------------------------------------------------------
+  // Parse the batched stat response, one "<errcode> <info>" line per path
+  //----------------------------------------------------------------------------
+  bool StatInfoList::ParseServerResponse( const std::string &paths,
+                                          const char        *data )
+  {
+    if( !data )
+      return false;
+
+    std::vector<std::string> pathList, entries;
+    Utils::splitString( pathList, paths, "\n" );
+    Utils::splitString( entries, data, "\n" );
+    if( pathList.size() != entries.size() )
+      return false;
+
+    for( size_t i = 0; i < entries.size(); ++i )
+    {
+      char *end;
+      const char *info = entries[i].c_str();
+      long  code = strtol( info, &end, 10 );
+      if( end == info || *end != ' ' )
+        return false;
+      ++end;
+
+      if( code == 0 )
+      {
+        StatInfo *statInfo = new StatInfo();
+        if( !statInfo->ParseServerResponse( end ) )
+        {
+          delete statInfo;
+          return false;
+        }
+        Add( new ListEntry( pathList[i], XRootDStatus(), statInfo ) );
+        continue;
+      }
+
+      XRootDStatus st( stError, errErrorResponse,
+                       XProtocol::toErrno( code ), end );
+      Add( new ListEntry( pathList[i], st ) );
+    }
+    return true;
+  }
+
   struct PageInfoImpl
   {
     PageInfoImpl( uint64_t offset = 0, uint32_t length = 0, void *buffer = 0,
@@ -855,6 +855,115 @@ namespace XrdCl
       static const std::string dStatPrefix;
   };
 
+  //----------------------------------------------------------------------------
+  //! Result of stating several paths in one request
+  //----------------------------------------------------------------------------
+  class StatInfoList
+  {
+    public:
+
+      //------------------------------------------------------------------------
+      //! Outcome for a single path
+      //------------------------------------------------------------------------
+      class ListEntry
+      {
+        public:
+          //--------------------------------------------------------------------
+          //! Constructor
+          //--------------------------------------------------------------------
+          ListEntry( const std::string  &path,
+                     const XRootDStatus &status,
+                     StatInfo           *statInfo = 0 ):
+            pPath( path ),
+            pStatus( status ),
+            pStatInfo( statInfo )
+          {}
+
+          //--------------------------------------------------------------------
+          //! Destructor
+          //--------------------------------------------------------------------
+          ~ListEntry()
+          {
+            delete pStatInfo;
+          }
+
+          //--------------------------------------------------------------------
+          //! Get the path as it was requested
+          //--------------------------------------------------------------------
+          const std::string &GetPath() const
+          {
+            return pPath;
+          }
+
+          //--------------------------------------------------------------------
+          //! Get the status of the stat for this path
+          //--------------------------------------------------------------------
+          const XRootDStatus &GetStatus() const
+          {
+            return pStatus;
+          }
+
+          //--------------------------------------------------------------------
+          //! Get the stat info object, null if the stat failed
+          //--------------------------------------------------------------------
+          const StatInfo *GetStatInfo() const
+          {
+            return pStatInfo;
+          }
+
+        private:
+          std::string   pPath;
+          XRootDStatus  pStatus;
+          StatInfo     *pStatInfo;
+      };
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      StatInfoList();
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~StatInfoList();
+
+      //------------------------------------------------------------------------
+      //! Add an entry to the list - takes ownership
+      //------------------------------------------------------------------------
+      void Add( ListEntry *entry )
+      {
+        pList.push_back( entry );
+      }
+
+      //------------------------------------------------------------------------
+      //! Get an entry at given index, entries follow the request order
+      //------------------------------------------------------------------------
+      const ListEntry *At( uint32_t index ) const
+      {
+        return pList[index];
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the number of entries
+      //------------------------------------------------------------------------
+      uint32_t GetSize() const
+      {
+        return pList.size();
+      }
+
+      //------------------------------------------------------------------------
+      //! Parse server response and fill up the object
+      //!
+      //! @param paths newline separated paths as sent in the request
+      //! @param data  the null terminated response body
+      //------------------------------------------------------------------------
+      bool ParseServerResponse( const std::string &paths,
+                                const char        *data );
+
+    private:
+      std::vector<ListEntry*> pList;
+  };
+
   //----------------------------------------------------------------------------
   //! Information returned by file open operation
   //----------------------------------------------------------------------------
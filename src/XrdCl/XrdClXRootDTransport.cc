@@ -2981,6 +2981,25 @@ namespace XrdCl
         break;
       }
 
+      //------------------------------------------------------------------------
+      // kXR_statx
+      //------------------------------------------------------------------------
+      case kXR_statx:
+      {
+        ClientStatRequest *sreq = (ClientStatRequest *)msg;
+        char *fn = GetDataAsString( msg );
+        for( char *cP = fn; *cP; ++cP )
+          if( *cP == '\n' ) *cP = ' ';
+        o << "kXR_statx (paths: " << fn << ", flags: ";
+        delete [] fn;
+        if( sreq->options & kXR_sxfull )
+          o << "kXR_sxfull";
+        else
+          o << "none";
+        o << ")";
+        break;
+      }
+
       //------------------------------------------------------------------------
       // kXR_read
       //------------------------------------------------------------------------
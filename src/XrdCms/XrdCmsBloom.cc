@@ -0,0 +1,347 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s B l o o m . c c                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include "XProtocol/YProtocol.hh"
+
+#include "XrdCms/XrdCmsBloom.hh"
+#include "XrdCms/XrdCmsConfig.hh"
+#include "XrdCms/XrdCmsManager.hh"
+#include "XrdCms/XrdCmsPList.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                        L o c a l   S t a t i c s                           */
+/******************************************************************************/
+
+namespace
+{
+typedef std::vector<std::pair<unsigned int, unsigned int> > HashVec;
+
+// Files added while a filter is being built are recorded here so that they
+// are not lost should they be created after their directory was scanned.
+//
+XrdSysMutex  addMutex;
+HashVec      addVec;
+bool         addRec = false;
+
+/******************************************************************************/
+/*                                  W a l k                                   */
+/******************************************************************************/
+  
+void Walk(const char *path, HashVec &hVec)
+{
+   struct stat sBuff;
+   std::vector<std::string> pendDirs(1, path);
+   std::string  dPath, fPath;
+   XrdOucEnv    myEnv;
+   XrdOssDF    *dP;
+   char         eName[1024];
+   unsigned int h1, h2;
+   int          plen;
+   bool         haveStat;
+
+// Directories are processed from a stack rather than by recursion so that a
+// deep namespace cannot exhaust the thread's stack. Only one directory is open
+// at any one time as subdirectories are only descended after it is closed.
+//
+   while(!pendDirs.empty())
+        {dPath = pendDirs.back(); pendDirs.pop_back();
+         plen  = dPath.size();
+
+   // Add the path itself as it may be looked up as well
+   //
+         while(plen > 1 && dPath[plen-1] == '/') plen--;
+         XrdCmsBloom::Hash(dPath.c_str(), plen, h1, h2);
+         hVec.push_back(std::make_pair(h1, h2));
+
+   // Open the directory. Should that fail, skip it but do the rest.
+   //
+         if (!(dP = Config.ossFS->newDir("cmsd")))
+            {Say.Emsg("Publish", "Unable to scan directory", dPath.c_str());
+             continue;
+            }
+         if (dP->Opendir(dPath.c_str(), myEnv)) {delete dP; continue;}
+         haveStat = (dP->StatRet(&sBuff) == 0);
+
+   // Add each entry and remember any subdirectories
+   //
+         while(!dP->Readdir(eName, sizeof(eName)) && *eName)
+              {if (*eName == '.'
+               && (!eName[1] || (eName[1] == '.' && !eName[2]))) continue;
+               fPath.assign(dPath, 0, plen);
+               if (plen > 1) fPath += '/';
+               fPath += eName;
+               if (!haveStat && Config.ossFS->Stat(fPath.c_str(), &sBuff))
+                  continue;
+               if (S_ISDIR(sBuff.st_mode)) pendDirs.push_back(fPath);
+                  else if (S_ISREG(sBuff.st_mode))
+                          {XrdCmsBloom::Hash(fPath.c_str(),fPath.size(),h1,h2);
+                           hVec.push_back(std::make_pair(h1, h2));
+                          }
+              }
+         dP->Close();
+         delete dP;
+        }
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+  
+XrdCmsBloom::XrdCmsBloom(unsigned int gen,  unsigned int words,
+                         unsigned int keys, int hashes)
+                        : Gen(gen), Words(words), Keys(keys), Hashes(hashes),
+                          nextWord(0)
+{
+   Bits    = new RAtomic_uint[Words];
+   for (unsigned int i = 0; i < Words; i++) Bits[i] = 0;
+   numBits = Words * 32;
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+  
+void XrdCmsBloom::Add(unsigned int h1, unsigned int h2)
+{
+   unsigned int bit;
+
+   for (int i = 0; i < Hashes; i++, h1 += h2)
+       {bit = h1 % numBits;
+        Bits[bit >> 5] |= (1U << (bit & 31));
+       }
+}
+
+/******************************************************************************/
+/*                                   F P R                                    */
+/******************************************************************************/
+  
+double XrdCmsBloom::FPR()
+{
+   unsigned long long bitsOn = 0;
+
+   for (unsigned int i = 0; i < Words; i++)
+       bitsOn += __builtin_popcount(static_cast<unsigned int>(Bits[i]));
+
+   return pow(static_cast<double>(bitsOn)/numBits, Hashes);
+}
+
+/******************************************************************************/
+/*                                  H a s h                                   */
+/******************************************************************************/
+  
+void XrdCmsBloom::Hash(const char *key, int klen,
+                       unsigned int &h1, unsigned int &h2)
+{
+// We use double hashing where the second hash is the step. It must be odd.
+//
+   h1 = XrdOucCRC::CRC32((const unsigned char *)key, klen);
+   h2 = XrdOucCRC::Calc32C(key, klen, 0x9e3779b9U) | 1;
+}
+
+/******************************************************************************/
+/*                                  L o a d                                   */
+/******************************************************************************/
+  
+int XrdCmsBloom::Load(unsigned int offs, const char *data, int dlen)
+{
+   unsigned int n = dlen / sizeof(kXR_unt32), word;
+
+// Verify that this is the segment we want
+//
+   if (offs != nextWord || dlen % sizeof(kXR_unt32) || !n || n > Words - offs)
+      return -1;
+
+// Merge in the words, keys may have been added while we were loading
+//
+   for (unsigned int i = 0; i < n; i++)
+       {memcpy(&word, data, sizeof(word)); data += sizeof(word);
+        Bits[offs+i] |= ntohl(word);
+       }
+
+// Indicate whether we have the complete filter
+//
+   nextWord += n;
+   return nextWord == Words;
+}
+
+/******************************************************************************/
+/*                                 N o t e                                    */
+/******************************************************************************/
+  
+void XrdCmsBloom::Note(const char *path)
+{
+   unsigned int h1, h2;
+
+// Record the file if a filter is being built
+//
+   addMutex.Lock();
+   if (addRec)
+      {Hash(path, strlen(path), h1, h2);
+       addVec.push_back(std::make_pair(h1, h2));
+      }
+   addMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                               P u b l i s h                                */
+/******************************************************************************/
+  
+void *XrdCmsBloom::Publish()
+{
+   EPNAME("Publish");
+   HashVec      hVec;
+   XrdCmsPList *pP;
+   char         buff[256];
+   double       bpk = -log(Config.BloomFPR/100.0)/(M_LN2*M_LN2);
+   unsigned int gen = static_cast<unsigned int>(time(0)), words;
+   unsigned long long maxW = Config.BloomMax / sizeof(kXR_unt32);
+   int          hashes = static_cast<int>(bpk*M_LN2 + 0.5);
+
+// Compute the number of hash functions for the wanted false positive rate
+//
+   if (hashes < 1) hashes = 1;
+      else if (hashes > maxHash) hashes = maxHash;
+   if (maxW > maxWords) maxW = maxWords;
+
+// Give our managers a chance to see our login before sending anything
+//
+   XrdSysTimer::Snooze(60);
+
+// Periodically build a filter of everything we export and send it
+//
+do{addMutex.Lock(); addVec.clear(); addRec = true; addMutex.UnLock();
+
+   hVec.clear();
+   for (pP = Config.PathList.First(); pP; pP = pP->Next())
+       Walk(pP->Path(), hVec);
+
+   addMutex.Lock();
+   hVec.insert(hVec.end(), addVec.begin(), addVec.end());
+   words = static_cast<unsigned int>((hVec.size()*bpk + 31) / 32);
+   if (!words) words = 1;
+      else if (words > maxW) words = static_cast<unsigned int>(maxW);
+
+   XrdCmsBloom theBF(gen++, words, hVec.size(), hashes);
+   for (unsigned int i = 0; i < hVec.size(); i++)
+       theBF.Add(hVec[i].first, hVec[i].second);
+
+// Files added after this point will be reported as "have" to our managers
+// after the first segment is sent and managers apply them to the new filter.
+//
+   addRec = false; addVec.clear();
+   Send(theBF, true);
+   addMutex.UnLock();
+   Send(theBF, false);
+
+   snprintf(buff, sizeof(buff), "%u entries using %u bytes; expected fpr "
+            "%.2f%%", theBF.Keys, words*4, theBF.FPR()*100.0);
+   Say.Emsg("Publish", "Namespace filter has", buff);
+   DEBUG("gen=" <<theBF.Gen <<" words=" <<words <<" hashes=" <<hashes);
+
+   hVec.clear(); hVec.shrink_to_fit();
+   XrdSysTimer::Snooze(Config.BloomInt);
+  } while(1);
+
+// Keep the compiler happy
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+  
+void XrdCmsBloom::Send(XrdCmsBloom &theBF, bool first)
+{
+   static const int hdrLen = sizeof(CmsBloomRequest) - sizeof(CmsRRHdr);
+   CmsBloomRequest bReq;
+   kXR_unt32       segData[CmsBloomRequest::maxSegWords];
+   struct iovec    ioV[2] = {{(char *)&bReq,   sizeof(bReq)},
+                             {(char *)segData, 0}};
+   unsigned int    offs = (first ? 0 : CmsBloomRequest::maxSegWords), n;
+
+// Send the first segment or all of the remaining segments
+//
+   while(offs < theBF.Words)
+        {n = theBF.Words - offs;
+         if (n > (unsigned int)CmsBloomRequest::maxSegWords)
+            n = CmsBloomRequest::maxSegWords;
+         for (unsigned int i = 0; i < n; i++)
+             segData[i] = htonl(static_cast<unsigned int>(theBF.Bits[offs+i]));
+
+         memset(&bReq, 0, sizeof(bReq));
+         bReq.Hdr.rrCode   = kYR_bloom;
+         bReq.Hdr.modifier = kYR_raw;
+         bReq.Hdr.datalen  = htons(static_cast<unsigned short>
+                                   (hdrLen + n*sizeof(kXR_unt32)));
+         bReq.Gen          = htonl(theBF.Gen);
+         bReq.Words        = htonl(theBF.Words);
+         bReq.Offset       = htonl(offs);
+         bReq.Hashes       = htons(static_cast<unsigned short>(theBF.Hashes));
+         bReq.Keys         = htonl(theBF.Keys);
+         ioV[1].iov_len    = n*sizeof(kXR_unt32);
+
+         XrdCmsManager::Inform("bloom", ioV, 2, sizeof(bReq)+ioV[1].iov_len);
+         if (first) break;
+         offs += n;
+        }
+}
+
+/******************************************************************************/
+/*                                  T e s t                                   */
+/******************************************************************************/
+  
+bool XrdCmsBloom::Test(unsigned int h1, unsigned int h2)
+{
+   unsigned int bit;
+
+   for (int i = 0; i < Hashes; i++, h1 += h2)
+       {bit = h1 % numBits;
+        if (!(Bits[bit >> 5] & (1U << (bit & 31)))) return false;
+       }
+   return true;
+}
@@ -0,0 +1,102 @@
+#ifndef __XRDCMSBLOOM_HH__
+#define __XRDCMSBLOOM_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s B l o o m . h h                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include "XrdSys/XrdSysRAtomic.hh"
+
+/******************************************************************************/
+/*                     C l a s s   X r d C m s B l o o m                      */
+/******************************************************************************/
+
+// The XrdCmsBloom object is a Bloom filter describing the files a data server
+// has. Servers periodically build one from their exported namespace and send
+// it to their managers. Managers use it to avoid asking a server about a file
+// it cannot have. The filter may return false positives but never a false
+// negative for the keys it was built with. Bits are atomic so that keys may
+// be added while the filter is being tested.
+//
+class XrdCmsBloom
+{
+public:
+
+// Add() adds a key using its hash values (see Hash()).
+//
+       void         Add(unsigned int h1, unsigned int h2);
+
+// FPR() returns the expected false positive ratio given the bits set.
+//
+       double       FPR();
+
+// Hash() computes the two hash values used to index the filter for a key.
+//
+static void         Hash(const char *key, int klen,
+                         unsigned int &h1, unsigned int &h2);
+
+// Load() copies a segment of words in network byte order into the filter.
+//        Segments must arrive in order. It returns 1 when the filter is
+//        complete, 0 if more segments are needed, and -1 upon error.
+//
+       int          Load(unsigned int offs, const char *data, int dlen);
+
+// Note() records a file added to the namespace while a filter is being built
+//        on a data server. It must be called before the file is reported.
+//
+static void         Note(const char *path);
+
+// Publish() is called in a separate thread on a data server. Every interval
+//           it builds a filter from the exported namespace and sends it to
+//           all of our managers.
+//
+static void        *Publish();
+
+// Test() returns false if the key is certainly not present, true otherwise.
+//
+       bool         Test(unsigned int h1, unsigned int h2);
+
+       unsigned int Gen;     // Generation number of the filter
+       unsigned int Words;   // Number of 32-bit words in the filter
+       unsigned int Keys;    // Number of keys added when filter was built
+       int          Hashes;  // Number of hash functions
+
+static const unsigned int maxWords = 0x01000000;  // 64MB
+static const int          maxHash  = 16;
+
+                    XrdCmsBloom(unsigned int gen,  unsigned int words,
+                                unsigned int keys, int hashes);
+                   ~XrdCmsBloom() {delete [] Bits;}
+
+private:
+
+static void         Send(XrdCmsBloom &theBF, bool first);
+
+RAtomic_uint       *Bits;
+unsigned int        numBits;
+unsigned int        nextWord; // Next word expected by Load()
+};
+#endif
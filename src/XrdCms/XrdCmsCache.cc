@@ -29,6 +29,7 @@
 /******************************************************************************/
   
 #include <cstdio>
+#include <cstring>
 #include <sys/types.h>
 
 #include "XrdCms/XrdCmsCache.hh"
@@ -63,13 +64,14 @@ public:
 
 void   DoIt() {Cache.Recycle(myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(XrdCmsKeyItem **List)
+                     : XrdJob("cache scrubber")
+                     {memcpy(myList, List, sizeof(myList));}
       ~XrdCmsCacheJob() {}
 
 private:
 
-XrdCmsKeyItem *myList;
+XrdCmsKeyItem *myList[XrdCmsCache::cStripes];
 };
 
 /******************************************************************************/
@@ -116,18 +118,19 @@ void *XrdCmsStartTickTock(void *carg)
   
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   cStripe &sP = Stripe(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   sP.sMutex.Lock();
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP.Table.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -137,6 +140,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           {iP->Loc.deadline = QDelay + time(0);
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
+           iP->Loc.sfvec = 0;
            iP->Loc.TOD_B = BClock;
            iP->Key.TOD = Tock;
           } else {
@@ -156,11 +160,12 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
                 {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                 if ((iP = sP.Table.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
                      iP->Loc.TOD_B    = BClock;
                      iP->Loc.qfvec    = 0;
+                     iP->Loc.sfvec    = 0;
                      iP->Loc.deadline = QDelay + time(0);
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
                      Sel.Path.Ref     = iP->Key.Ref;
@@ -170,7 +175,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP.sMutex.UnLock();
    return isnew;
 }
   
@@ -190,29 +195,30 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   cStripe &sP = Stripe(Sel.Path);
    XrdCmsKeyItem *iP;
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.sMutex.Lock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP.Table.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  sP.Table.Unload(iP) && !sP.Table.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP.sMutex.UnLock();
    return gone4good;
 }
   
@@ -231,20 +237,23 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   cStripe &sP = Stripe(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t bVec;
    int retc;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.sMutex.Lock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
+   if ((iP = sP.Table.Find(Sel.Path)))
+      {sP.Hits++;
+       if ((bVec = (iP->Loc.TOD_B < BClock 
                  ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
-          {iP->Loc.hfvec &= ~bVec; 
+          {sP.Bnce++;
+           iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
            iP->Loc.deadline = QDelay + time(0);
@@ -255,6 +264,18 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
                        else {iP->Loc.deadline = 0;  retc =  1;}
                     else retc = 1;
 
+// If none of the servers we asked has the file, ask the ones that we skipped
+// because their namespace filter ruled the file out as the filter may be stale.
+//
+       if (retc == 1 && iP->Loc.sfvec)
+          {if (!iP->Loc.hfvec && (bVec = iP->Loc.sfvec & mask))
+              {iP->Loc.deadline = QDelay + time(0);
+               iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
+               retc = -1;
+              }
+           iP->Loc.sfvec = 0;
+          }
+
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
@@ -262,15 +283,39 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        Sel.Vec.pf      = okVec & iP->Loc.pfvec;
        Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
-      } else retc = 0;
+      } else {sP.Miss++; retc = 0;}
 
 // All done
 //
-   myMutex.UnLock();
+   sP.sMutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
 
+/******************************************************************************/
+/* Public                        S k p F i l e                                */
+/******************************************************************************/
+  
+void XrdCmsCache::SkpFile(XrdCmsSelect &Sel, SMask_t mask)
+{
+   cStripe &sP = Stripe(Sel.Path);
+   XrdCmsKeyItem *iP;
+
+// Serialize processing
+//
+   sP.sMutex.Lock();
+
+// Look up the entry and if valid record the servers that were skipped. Note
+// that this method may only be called after GetFile() or AddFile().
+//
+   if ((iP = Sel.Path.TODRef) && iP->Key.Equiv(Sel.Path))
+      iP->Loc.sfvec = mask;
+
+// All done
+//
+   sP.sMutex.UnLock();
+}
+
 /******************************************************************************/
 /* Public                        U n k F i l e                                */
 /******************************************************************************/
@@ -278,11 +323,12 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
+   cStripe &sP = Stripe(Sel.Path);
    XrdCmsKeyItem *iP;
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   sP.sMutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +340,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.sMutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +359,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   cStripe &sP = Stripe(Sel.Path);
+   sP.sMutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +375,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.sMutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -379,7 +426,6 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
   
 int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold)
 {
-   XrdCmsKeyItem *iP;
    pthread_t tid;
 
 // Indicate whether we are a shared-everything setup as this changes how we
@@ -411,9 +457,7 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 // Get the first reserve of cache items
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   XrdCmsKeyItem::Replenish();
 
 // All done
 //
@@ -426,17 +470,28 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 void *XrdCmsCache::TickTock()
 {
-   XrdCmsKeyItem *iP;
+   XrdCmsKeyItem *iP[cStripes];
+   unsigned int newTock;
+   bool haveOld;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries. Each stripe is aged on its
+// own so that lookups in other stripes proceed while one is being trimmed.
+// The new tock is published only after every stripe has been trimmed as an
+// entry added with the new tock would otherwise be unloaded as being old.
 //
    do {XrdSysTimer::Snooze(Tick);
+       newTock = (Tock+1) & XrdCmsKeyItem::TickMask;
+       haveOld = false;
+       for (int i = 0; i < cStripes; i++)
+           {CStripe[i].sMutex.Lock();
+            if ((iP[i] = CStripe[i].Table.Unload(newTock))) haveOld = true;
+            CStripe[i].sMutex.UnLock();
+           }
        myMutex.Lock();
-       Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
-       Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
+       Bhistory[newTock].Start = Bhistory[newTock].End = 0;
+       Tock = newTock;
        myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       if (haveOld) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
       } while(1);
 
 // Keep compiler happy
@@ -508,8 +563,10 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
    SMask_t BVec(0);
    long long i;
 
-// See if we can use a previously calculated bVec
+// See if we can use a previously calculated bVec. The caller holds the stripe
+// lock so the lock order is always stripe and then bounce information.
 //
+   XrdSysMutexHelper bLock(myMutex);
    if (Bhistory[TODa].End == BClock && Bhistory[TODa].Start <= TODb)
       {Bhits++; TODb = BClock; return Bhistory[TODa].Vec;}
 
@@ -531,40 +588,46 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(XrdCmsKeyItem **theList)
 {
    XrdCmsKeyItem *iP;
-   char msgBuff[100];
+   char msgBuff[256];
+   long long numHits = 0, numMiss = 0, numBnce = 0;
    int numNull, numHave, numFree, numRecycled = 0;
 
-// Recycle the list of cache items, as needed
-//
-   while((iP = theList))
-        {theList = iP->Key.TODRef;
-         if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
-         if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
-         numRecycled++;
-        }
+// Recycle the list of cache items in each stripe, as needed. We also collect
+// the lookup statistics while we have the stripe.
+//
+   for (int i = 0; i < cStripes; i++)
+       {while((iP = theList[i]))
+             {theList[i] = iP->Key.TODRef;
+              if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
+              if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
+              CStripe[i].sMutex.Lock();
+              CStripe[i].Table.Recycle(iP);
+              CStripe[i].sMutex.UnLock();
+              numRecycled++;
+             }
+        CStripe[i].sMutex.Lock();
+        numHits += CStripe[i].Hits; CStripe[i].Hits = 0;
+        numMiss += CStripe[i].Miss; CStripe[i].Miss = 0;
+        numBnce += CStripe[i].Bnce; CStripe[i].Bnce = 0;
+        CStripe[i].sMutex.UnLock();
+       }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
    XrdCmsKeyItem::Stats(numHave, numFree, numNull);
    if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
-       if (!(numNull /= 4)) numNull = 1;
+      {if (!(numNull /= 4)) numNull = 1;
        numHave += XrdCmsKeyItem::minAlloc * numNull;
-       while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
-            }
-      } else myMutex.UnLock();
+       while(numNull--) numFree = XrdCmsKeyItem::Replenish();
+      }
 
 // Log the stats
 //
-   sprintf(msgBuff, "%d cache items; %d allocated %d free",
-           numRecycled, numHave, numFree);
+   snprintf(msgBuff, sizeof(msgBuff), "%d cache items; %d allocated %d free; "
+            "%lld hits %lld misses %lld bounced", numRecycled, numHave,
+            numFree, numHits, numMiss, numBnce);
    Say.Emsg("Recycle", msgBuff);
 }
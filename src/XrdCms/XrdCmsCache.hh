@@ -38,6 +38,7 @@
 #include "XrdCms/XrdCmsNash.hh"
 #include "XrdCms/XrdCmsPList.hh"
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 #include "XrdCms/XrdCmsSelect.hh"
 #include "XrdCms/XrdCmsTypes.hh"
   
@@ -61,6 +62,13 @@ int         DelFile(XrdCmsSelect &Sel, SMask_t mask);
 //
 int         GetFile(XrdCmsSelect &Sel, SMask_t mask);
 
+// SkpFile() records the servers that were not queried because their namespace
+//           filter rules out the file. Should no queried server have the file
+//           then GetFile() has them queried before the file is deemed missing.
+//           This may only be called after GetFile() or AddFile().
+//
+void        SkpFile(XrdCmsSelect &Sel, SMask_t mask);
+
 // UnkFile() updates the unqueried vector and returns 1 upon success, 0 o/w.
 //
 int         UnkFile(XrdCmsSelect &Sel, SMask_t mask);
@@ -80,6 +88,11 @@ void       *TickTock();
 
 static const int min_nxTime = 60;
 
+// The cache is split into stripes, each with its own lock, table, and aging
+// list. A path is always assigned to the same stripe based on its hash.
+//
+static const int cStripes   = 16;
+
             XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
                             nilTMO(0),
                             DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
@@ -91,24 +104,42 @@ static const int min_nxTime = 60;
 
 private:
 
+struct cStripe
+      {XrdSysMutex   sMutex;
+       XrdCmsNash    Table;
+       long long     Hits;     // Lookups that found the path
+       long long     Miss;     // Lookups that did not find the path
+       long long     Bnce;     // Hits that needed a bounced server refresh
+
+                     cStripe() : Table(1597, 2584), Hits(0), Miss(0), Bnce(0)
+                                 {}
+                    ~cStripe() {}
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
 SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
+void          Recycle(XrdCmsKeyItem **theList);
+
+inline
+cStripe      &Stripe(XrdCmsKey &Key)
+                    {if (!Key.Hash) Key.setHash();
+                     return CStripe[((Key.Hash * 0x9e3779b1U) >> 24) % cStripes];
+                    }
 
 struct  {SMask_t      Vec;
          unsigned int Start;
          unsigned int End;
         }             Bhistory[XrdCmsKeyItem::TickRate];
 
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
+cStripe       CStripe[cStripes];
+XrdSysMutex   myMutex;   // Serializes the bounce information below
 unsigned int  Bounced[STMax];
-SMask_t       okVec;
+RAtomic_ullong okVec;
 unsigned int  Tick;
-unsigned int  Tock;
-unsigned int  BClock;
+RAtomic_uint  Tock;
+RAtomic_uint  BClock;
          int  nilTMO;
          int  DLTime;
          int  QDelay;
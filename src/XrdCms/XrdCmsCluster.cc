@@ -28,6 +28,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <algorithm>
 #include <cerrno>
 #include <fcntl.h>
 #include <cstdio>
@@ -44,6 +45,7 @@
 
 #include "XrdCms/XrdCmsBaseFS.hh"
 #include "XrdCms/XrdCmsBlackList.hh"
+#include "XrdCms/XrdCmsBloom.hh"
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsConfig.hh"
 #include "XrdCms/XrdCmsCluster.hh"
@@ -116,6 +118,12 @@ XrdCmsCluster::XrdCmsCluster()
      SelWtot = 0;
      SelRtot = 0;
      SelTcnt = 0;
+     SelHcnt = 0;
+     SelHhit = 0;
+     BloomQry= 0;
+     BloomAsk= 0;
+     BloomSkp= 0;
+     BloomHit= 0;
      peerHost  = 0;
      peerMask  = ~peerHost;
 }
@@ -172,6 +180,8 @@ XrdCmsNode *XrdCmsCluster::Add(XrdLink *lp, int port, int Status, int sport,
            nP->isConn    = 1;
            nP->Instance++;
            nP->setName(lp, theIF, port);  // Just in case it changed
+           if (nP->bloomP)   {delete nP->bloomP;   nP->bloomP   = 0;}
+           if (nP->bloomNew) {delete nP->bloomNew; nP->bloomNew = 0;}
            act = "Reconnect ";
           }
       }
@@ -270,6 +280,24 @@ XrdCmsNode *XrdCmsCluster::Add(XrdLink *lp, int port, int Status, int sport,
    return nP;
 }
   
+/******************************************************************************/
+/*                              A d d B l o o m                               */
+/******************************************************************************/
+
+void XrdCmsCluster::AddBloom(XrdCmsNode *nP, const char *path)
+{
+   XrdSysRWLockHelper STMHelper(STMutex); // Filters are internally atomic
+   unsigned int h1, h2;
+
+// Add the file to the filter in effect and the one being received, if any.
+// The latter may have been built before the file was created.
+//
+   if (!nP->bloomP && !nP->bloomNew) return;
+   XrdCmsBloom::Hash(path, strlen(path), h1, h2);
+   if (nP->bloomP)   {nP->bloomP->Add(h1, h2); BloomHit++;}
+   if (nP->bloomNew)  nP->bloomNew->Add(h1, h2);
+}
+
 /******************************************************************************/
 /* Private:                       A d d A l t                                 */
 /******************************************************************************/
@@ -651,11 +679,17 @@ int XrdCmsCluster::Locate(XrdCmsSelect &Sel)
 // A Refresh request kills this because it's as if we hadn't seen it before.
 // If the file was found but either a query is in progress or we have a server
 // bounce; the client must wait.
+//
+// When we have namespace filters, only nodes that may have the file are asked
+// at first. The others are asked later should none of these have the file.
 //
    if (Sel.Opts & XrdCmsSelect::Refresh 
    || !(retc = Cache.GetFile(Sel, pinfo.rovec)))
       {Cache.AddFile(Sel, 0);
-       qfVec = pinfo.rovec; Sel.Vec.hf = 0;
+       if (Sel.Opts & XrdCmsSelect::Refresh) qfVec = pinfo.rovec;
+          else if ((qfVec = Prune(Sel.Path, pinfo.rovec)) != pinfo.rovec)
+                  Cache.SkpFile(Sel, pinfo.rovec & ~qfVec);
+       Sel.Vec.hf = 0;
       } else qfVec = Sel.Vec.bf;
 
 // Compute the delay, if any
@@ -744,6 +778,50 @@ void *XrdCmsCluster::MonRefs()
    return (void *)0;
 }
 
+/******************************************************************************/
+/*                                 P r u n e                                  */
+/******************************************************************************/
+  
+SMask_t XrdCmsCluster::Prune(XrdCmsKey &Path, SMask_t qVec)
+{
+   XrdCmsNode *nP;
+   SMask_t bitVec, oVec = qVec;
+   unsigned int h1, h2;
+   int i, nAsk = 0, nSkp = 0;
+
+// Filters hold paths exactly as servers list them, so we cannot use them
+// for paths that are not in that form.
+//
+   if (!Config.BloomInt || !qVec || Path.Len < 2 || Path.Val[Path.Len-1] == '/'
+   ||  strstr(Path.Val, "//") || strstr(Path.Val, "/./")
+   ||  strstr(Path.Val, "/../")) return qVec;
+
+// Remove any node whose filter says it certainly does not have the path. Nodes
+// without a filter must always be asked. A filter only reflects the namespace
+// as of its last scan, so a negative result never decides that the file is
+// missing. Should every filter exclude the file, all of the nodes are asked.
+// Otherwise, the caller records the skipped nodes and these are asked should
+// none of the others have the file (see XrdCmsCache::GetFile()).
+//
+   XrdCmsBloom::Hash(Path.Val, Path.Len, h1, h2);
+   STMutex.ReadLock();
+   for (i = 0; i <= STHi; i++)
+       {bitVec = (SMask_t)1 << i;
+        if (!(oVec & bitVec) || !(nP = NodeTab[i])) continue;
+        if (!nP->bloomP) continue;
+        if (nP->bloomP->Test(h1, h2)) nAsk++;
+           else {qVec &= ~bitVec; nSkp++;}
+       }
+   STMutex.UnLock();
+
+// Update statistics
+//
+   BloomQry++;
+   if (nAsk) BloomAsk += nAsk;
+   if (nSkp) BloomSkp += nSkp;
+   return (qVec ? qVec : oVec);
+}
+
 /******************************************************************************/
 /*                                R e m o v e                                 */
 /******************************************************************************/
@@ -933,7 +1011,7 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
    XrdCmsPInfo  pinfo;
    const char  *Amode;
    int dowt = 0, retc = 0, isRW, fRD, noSel = (Sel.Opts & XrdCmsSelect::Defer);
-   SMask_t amask, smask, pmask;
+   SMask_t amask, smask, pmask, bfVec = 0;
 
 // Establish some local options
 //
@@ -990,10 +1068,18 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
 // meta-operation (e.g., remove) in which case the file itself remain unmodified
 // or a replica request, in which case we select a new target server.
 //
-   if (!(Sel.Opts & XrdCmsSelect::Refresh)
-   &&   (retc = Cache.GetFile(Sel, pinfo.rovec)))
+// When we have namespace filters, only servers that may have the file are asked
+// at first. The others are asked later should none of these have the file, in
+// which case a query is again in progress and the skipped servers are in bf.
+//
+   if (Sel.Opts & XrdCmsSelect::Refresh) {retc = 0; bfVec = pinfo.rovec;}
+      else if (!(retc = Cache.GetFile(Sel, pinfo.rovec)))
+              bfVec = Prune(Sel.Path, pinfo.rovec);
+
+   if (retc)
       {if (isRW)
-          {     if (retc<0) return Config.LUPDelay;
+          {     if (retc<0 && !Sel.Vec.bf) return Config.LUPDelay;
+           else if (retc<0) pmask = smask = 0;
               else if (Sel.Opts & XrdCmsSelect::Replica)
                    {pmask = amask & ~(Sel.Vec.hf | Sel.Vec.bf); smask = 0;
                     if (!pmask && !Sel.Vec.bf) return SelFail(Sel,eNoRep);
@@ -1022,7 +1108,8 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
        if (Sel.Vec.hf & Sel.nmask) Cache.UnkFile(Sel, Sel.nmask);
       } else {
        Cache.AddFile(Sel, 0); 
-       Sel.Vec.bf = pinfo.rovec; 
+       if (bfVec != pinfo.rovec) Cache.SkpFile(Sel, pinfo.rovec & ~bfVec);
+       Sel.Vec.bf = bfVec; 
        Sel.Vec.hf = Sel.Vec.pf = pmask = smask = 0;
        retc = 0;
       }
@@ -1204,6 +1291,27 @@ int XrdCmsCluster::SelFail(XrdCmsSelect &Sel, int rc)
     return EReplete;
 }
   
+/******************************************************************************/
+/*                              S e t B l o o m                               */
+/******************************************************************************/
+  
+void XrdCmsCluster::SetBloom(XrdCmsNode *nP, XrdCmsBloom *bP, bool install)
+{
+   XrdCmsBloom *oldP;
+
+// Either install the filter we just received or replace the one being built
+//
+   STMutex.WriteLock();
+   if (install) {oldP = nP->bloomP;   nP->bloomP = nP->bloomNew;}
+      else       oldP = nP->bloomNew;
+   nP->bloomNew = bP;
+   STMutex.UnLock();
+
+// Delete the old filter outside of the lock as it may be large
+//
+   if (oldP) delete oldP;
+}
+
 /******************************************************************************/
 /*                                 S p a c e                                  */
 /******************************************************************************/
@@ -1275,7 +1383,7 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
    static const char statfmt0[] = "</stats>";
    static const char statfmt1[] = "<stats id=\"cmsm\">"
           "<role>%s</role><sel><t>%lld</t><r>%lld</r><w>%lld</w></sel>"
-          "<node>%d";
+          "%s%s<node>%d";
    static const char statfmt2[] = "<stats id=\"%d\">"
           "<host>%s</host><role>%s</role>"
           "<run>%s</run><ref><r>%d</r><w>%d</w></ref>%s</stats>";
@@ -1284,6 +1392,9 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
    static const char statfmt5[] =
           "<frq><add>%lld<d>%lld</d></add><rsp>%lld<m>%lld</m></rsp>"
           "<lf>%lld</lf><ls>%lld</ls><rf>%lld</rf><rs>%lld</rs></frq>";
+   static const char statfmt6[] = "<aff><t>%lld</t><h>%lld</h></aff>";
+   static const char statfmt7[] = "<bloom><q>%lld</q><a>%lld</a>"
+                                  "<s>%lld</s><h>%lld</h></bloom>";
 
    static int AddFrq = (Config.RepStats & XrdCmsConfig::RepStat_frq);
    static int AddShr = (Config.RepStats & XrdCmsConfig::RepStat_shr)
@@ -1292,7 +1403,7 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
    XrdCmsRRQ::Info Frq;
    XrdCmsSelected *sp;
    int mlen, tlen, n = 0;
-   char shrBuff[80], stat[6], *stp;
+   char shrBuff[80], affBuff[80], blmBuff[128], stat[6], *stp;
    bool oksel;
 
    class spmngr {
@@ -1311,6 +1422,8 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
            sizeof(statfmt1) + 12*3 + 3 + 3 +
           (sizeof(statfmt2) + 10*2 + 256 + 16) * STMax + sizeof(statfmt4);
        if (AddShr) n += sizeof(statfmt3) + 12;
+       if (Config.sched_Hash) n += sizeof(statfmt6) + 12*2;
+       if (Config.BloomInt)   n += sizeof(statfmt7) + 12*4;
        if (AddFrq) n += sizeof(statfmt4) + (10*8);
        return n;
       }
@@ -1328,8 +1441,18 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
 // Format the statistics
 //
    long long lclTcnt = SelTcnt, lclRtot = SelRtot, lclWtot = SelWtot;
+   if (!Config.sched_Hash) *affBuff = 0;
+      else {long long lclHcnt = SelHcnt, lclHhit = SelHhit;
+            snprintf(affBuff, sizeof(affBuff), statfmt6, lclHcnt, lclHhit);
+           }
+   if (!Config.BloomInt) *blmBuff = 0;
+      else {long long lclBQry = BloomQry, lclBAsk = BloomAsk,
+                      lclBSkp = BloomSkp, lclBHit = BloomHit;
+            snprintf(blmBuff, sizeof(blmBuff), statfmt7,
+                     lclBQry, lclBAsk, lclBSkp, lclBHit);
+           }
    mlen = snprintf(bfr, bln, statfmt1,
-          Config.myRType, lclTcnt, lclRtot, lclWtot, n);
+          Config.myRType, lclTcnt, lclRtot, lclWtot, affBuff, blmBuff, n);
 
    if ((bln -= mlen) <= 0) return 0;
    tlen = mlen; bfr += mlen; n = 0; *shrBuff = 0;
@@ -1569,6 +1692,8 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
     EPNAME("SelNode")
     const char *act=0;
     int affsel = 1, count = 0, isalt = 0, pass = 2;
+    unsigned int theHash = 0;
+    bool byHash = false;
     SMask_t mask;
     XrdCmsNode *nP = 0;
     XrdCmsSelector selR;
@@ -1581,12 +1706,13 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
 // Indicate whether or not stable selection is required
 //
    if (!(Sel.Opts & XrdCmsSelect::Pack)) selR.selPack = 0;
-      else {unsigned int theHash = (Sel.Opts & XrdCmsSelect::UseAH
-                                 ?  Sel.AltHash : Sel.Path.Hash);
+      else {theHash = (Sel.Opts & XrdCmsSelect::UseAH
+                    ?  Sel.AltHash : Sel.Path.Hash);
             SMask_t sVec = pmask;
             for (count = 0; sVec; count++) sVec &= (sVec - 1);
             if (count > 1) selR.selPack = affsel = (theHash % count) + 1;
                else        selR.selPack = 0;
+            byHash = Config.sched_Hash && !(Sel.Opts & XrdCmsSelect::UseRef);
            }
 
 // There is a difference bwteen needing space and needing r/w access. The former
@@ -1604,8 +1730,10 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
    mask = pmask & peerMask;
    while(pass--)
         {if (mask)
-            {nP = (Config.sched_RR || (Sel.Opts & XrdCmsSelect::UseRef)
-                ?  SelbyRef(mask,selR) : SelbyLoad(mask,selR));
+            {     if (byHash) nP = SelbyHash(mask, selR, theHash);
+             else if (Config.sched_RR || (Sel.Opts & XrdCmsSelect::UseRef))
+                     nP = SelbyRef(mask,selR);
+             else    nP = SelbyLoad(mask,selR);
              if (nP || (selR.nPick && selR.delay)
              ||  NodeCnt < Config.SUPCount) break;
             }
@@ -1775,6 +1903,91 @@ XrdCmsNode *XrdCmsCluster::SelbyCost(SMask_t mask, XrdCmsSelector &selR)
    return sp;
 }
   
+/******************************************************************************/
+/*                             S e l b y H a s h                              */
+/******************************************************************************/
+
+// Hash selection ranks every eligible node by a rendezvous (highest random
+// weight) score of the path hash and the node's identity so that a path keeps
+// going to the same node as nodes come and go. Nodes are screened exactly as
+// SelbyLoad does. The highest ranked node is used unless its load (its mass when
+// space is needed) exceeds the average by more than the affbound; then the next
+// highest ranked node within the bound is used instead.
+
+// Caller must have the STMutex locked. The returned node, if any, is unlocked.
+
+namespace
+{
+inline unsigned long long hrwScore(unsigned int pHash, unsigned int nHash)
+{
+   unsigned long long x = (static_cast<unsigned long long>(pHash) << 32) | nHash;
+
+// This is the splitmix64 finalizer which gives us a well distributed score
+//
+   x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+   x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+   x ^= x >> 31;
+   return x;
+}
+}
+
+XrdCmsNode *XrdCmsCluster::SelbyHash(SMask_t mask, XrdCmsSelector &selR,
+                                     unsigned int theHash)
+{
+    XrdCmsNode *np, *sp = 0, *pref = 0, *eligible[STMax];
+    unsigned long long score, prefScore = 0, spScore = 0;
+    long long loadSum = 0;
+    int n = 0, loadMax;
+    bool reqSS = (selR.needSpace & XrdCmsNode::allowsSS) != 0;
+
+// Like SelbyLoad, writers are balanced by the node's mass (space utilization)
+// and readers by the node's load.
+//
+   auto Weight = [&selR](XrdCmsNode *xp)
+                 {return (selR.needSpace ? xp->myMass : xp->myLoad);};
+
+// Scan for eligible nodes while noting the preferred node for this path
+//
+   selR.Reset(); SelTcnt++; SelHcnt++;
+   for (int i = 0; i <= STHi; i++)
+       if ((np = NodeTab[i]) && (np->NodeMask & mask))
+          {if (!(selR.needNet & np->hasNet))      {selR.xNoNet= true; continue;}
+           selR.nPick++;
+           score = hrwScore(theHash, np->myHash);
+           if (!pref || score > prefScore) {pref = np; prefScore = score;}
+           if (np->isOffline)                     {selR.xOff  = true; continue;}
+           if (np->isBad)                         {selR.xSusp = true; continue;}
+           if (np->myLoad > Config.MaxLoad)       {selR.xOvld = true; continue;}
+           if (selR.needSpace && (np->DiskFree < np->DiskMinF
+                                  || (reqSS && np->isNoStage)))
+              {selR.xFull = true; continue;}
+           eligible[n++] = np; loadSum += Weight(np);
+          }
+
+// Compute the highest load (or mass when space is needed) we will tolerate.
+// Values within the fuzz factor are always considered equal to the average.
+//
+   if (!n) return calcDelay(selR);
+   loadMax = static_cast<int>(loadSum / n);
+   loadMax += std::max(loadMax * Config.P_bound / 100, Config.P_fuzz);
+
+// Pick the highest ranked node within the load bound
+//
+   for (int i = 0; i < n; i++)
+       {np = eligible[i];
+        if (Weight(np) > loadMax) continue;
+        score = hrwScore(theHash, np->myHash);
+        if (!sp || score > spScore) {sp = np; spScore = score;}
+       }
+
+// The lightest node is always within the bound so we always have a node
+//
+   if (!sp) sp = eligible[0];
+   if (sp == pref) SelHhit++;
+   RefCount(sp, (n > 1), selR.needSpace);
+   return sp;
+}
+
 /******************************************************************************/
 /*                             S e l b y L o a d                              */
 /******************************************************************************/
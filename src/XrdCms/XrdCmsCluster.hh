@@ -42,6 +42,8 @@
 #include "XrdSys/XrdSysRAtomic.hh"
 
 class XrdLink;
+class XrdCmsBloom;
+class XrdCmsKey;
 class XrdCmsDrop;
 class XrdCmsNode;
 class XrdCmsSelect;
@@ -123,6 +125,10 @@ int             NodeCnt;       // Number of active nodes
 XrdCmsNode     *Add(XrdLink *lp, int dport, int Status,
                     int sport, const char *theNID, const char *theIF);
 
+// Called to add a newly created file to a node's namespace filters
+//
+void            AddBloom(XrdCmsNode *nP, const char *path);
+
 // Put nodes in or remove from a blacklist
 //
 virtual void    BlackList(XrdOucTList *blP);
@@ -173,6 +179,11 @@ void           *MonRefs();
 //
 long long       Refs() {return SelWtot+SelRtot;}
 
+// Returns the subset of qVec whose namespace filters may hold the path or all
+// of qVec should none of them hold it.
+//
+SMask_t         Prune(XrdCmsKey &Path, SMask_t qVec);
+
 // Called to remove a node from the cluster
 //
 void            Remove(XrdCmsNode *theNode);
@@ -195,6 +206,11 @@ int             Select(XrdCmsSelect &Sel);
 int             Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
                        int isrw, int isMulti, int ifWant);
 
+// Called to replace the filter being received from a node or, when install is
+// true, to make the received filter the one in effect. Filters are adopted.
+//
+void            SetBloom(XrdCmsNode *nP, XrdCmsBloom *bP, bool install=false);
+
 // Manipulate the global selection lock
 //
 void            SLock(bool dolock, bool wrmode=true)
@@ -229,6 +245,7 @@ enum        {eExists, eDups, eROfs, eNoRep, eNoSel, eNoEnt}; // Passed to SelFai
 int         SelFail(XrdCmsSelect &Sel, int rc);
 int         SelNode(XrdCmsSelect &Sel, SMask_t  pmask, SMask_t  amask);
 XrdCmsNode *SelbyCost(SMask_t, XrdCmsSelector &selR);
+XrdCmsNode *SelbyHash(SMask_t, XrdCmsSelector &selR, unsigned int theHash);
 XrdCmsNode *SelbyLoad(SMask_t, XrdCmsSelector &selR);
 XrdCmsNode *SelbyRef (SMask_t, XrdCmsSelector &selR);
 int         SelDFS(XrdCmsSelect &Sel, SMask_t amask,
@@ -250,6 +267,12 @@ int           Reserved;
 RAtomic_llong SelWtot;          // Total number of r/w selections (successful)
 RAtomic_llong SelRtot;          // Total number of r/o selections (successful)
 RAtomic_llong SelTcnt;          // Total number of all selections
+RAtomic_llong SelHcnt;          // Total number of hashed selections
+RAtomic_llong SelHhit;          // Hashed selections given the preferred node
+RAtomic_llong BloomQry;         // Number of queries checked against filters
+RAtomic_llong BloomAsk;         // Number of nodes queried after filtering
+RAtomic_llong BloomSkp;         // Number of nodes not queried due to filters
+RAtomic_llong BloomHit;         // Number of new files added to a filter
 
 // The following is a list of IP:Port tokens that identify supervisor nodes.
 // The information is sent via the try request to redirect nodes; as needed.
@@ -52,6 +52,7 @@
 #include "XrdCms/XrdCmsAdmin.hh"
 #include "XrdCms/XrdCmsBaseFS.hh"
 #include "XrdCms/XrdCmsBlackList.hh"
+#include "XrdCms/XrdCmsBloom.hh"
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsCluster.hh"
 #include "XrdCms/XrdCmsConfig.hh"
@@ -139,6 +140,8 @@ void *XrdCmsStartMonRefs(void *carg) { return Cluster.MonRefs(); }
 
 void *XrdCmsStartMonStat(void *carg) { return CmsState.Monitor(); }
 
+void *XrdCmsStartBloom(void *carg) { return XrdCmsBloom::Publish(); }
+
 void *XrdCmsStartAdmin(void *carg)
       {return XrdCms::Admin.Start((XrdNetSocket *)carg);
       }
@@ -551,6 +554,7 @@ int XrdCmsConfig::ConfigXeq(char *var, XrdOucStream &CFile, XrdSysError *eDest)
    TS_Xeq("allow",         xallow);  // Manager, non-dynamic
    TS_Xeq("altds",         xaltds);  // Server,  non-dynamic
    TS_Xeq("blacklist",     xblk);    // Manager, non-dynamic
+   TS_Xeq("bloom",         xbloom);  // Any,     non-dynamic
    TS_Xeq("cidtag",        xcid);    // Any,     non-dynamic
    TS_Xeq("defaults",      xdefs);   // Server,  non-dynamic
    TS_Xeq("dfs",           xdfs);    // Any,     non-dynamic
@@ -661,6 +665,18 @@ void XrdCmsConfig::DoIt()
        return;
       }
 
+// Start the namespace filter publisher if we are a plain data server. Managers
+// and supervisors have no namespace of their own; their subordinates publish
+// the filters and a supervisor is always asked. A proxy's namespace is remote
+// so scanning it would be costly and inexact. With a distributed file system
+// every node shares the namespace and servers are not queried for files.
+//
+   if (BloomInt && isServer && !isManager && !isProxy && !baseFS.isDFS())
+      {if (XrdSysThread::Run(&tid, XrdCmsStartBloom, (void *)0,
+                                   0, "Namespace filter"))
+          Say.Emsg("Config", errno, "create namespace filter thread");
+      }
+
 // If we are a manager then we must do a service enable after a service delay
 //
    if ((isManager || isPeer) && SRVDelay)
@@ -727,6 +743,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    MultiSrc = 1;
    PortTCP  = 0;
    PortSUP  = 0;
+   P_bound  = 25;
    P_cpu    = 0;
    P_fuzz   = 20;
    P_gsdf   = 0;
@@ -742,6 +759,9 @@ void XrdCmsConfig::ConfigDefaults(void)
    DoHnTry  = 1;
    MaxDelay = -1;
    LogPerf  = 10;         // Every 10 usage requests
+   BloomInt = 0;          // No namespace filters
+   BloomFPR = 1;
+   BloomMax = 16*1024*1024;
    DiskMin  = 10240;      // 10GB*1024 (Min partition space) in MB
    DiskHWM  = 11264;      // 11GB*1024 (High Water Mark SUO) in MB
    DiskMinP = 2;
@@ -753,6 +773,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    myPaths  = (char *)""; // Default is 'r /'
    ConfigFN = 0;
    sched_RR = sched_Pack = sched_AffPC = sched_Level = 0; sched_Force = 1;
+   sched_Hash = 0;
    isManager= 0;
    isMeta   = 0;
    isPeer   = 0;
@@ -1489,6 +1510,64 @@ int XrdCmsConfig::xblk(XrdSysError *eDest, XrdOucStream &CFile, bool iswl)
    return 0;
 }
   
+/******************************************************************************/
+/*                                x b l o o m                                 */
+/******************************************************************************/
+
+/* Function: xbloom
+
+   Purpose:  To parse the directive: bloom [int <sec>] [fpr <pct>] [maxsz <sz>]
+
+         int <sec>   the interval between namespace filter updates sent by a
+                     data server to its managers (default 10m). A manager uses
+                     the filters to first ask only servers that may have a file
+                     that is not in its cache. The remaining servers are asked
+                     should none of these have it. Only plain data servers
+                     publish filters; supervisors are always asked and proxy
+                     or distributed file system nodes are never filtered.
+         fpr <pct>   the targeted false positive rate as a percentage. The
+                     default is 1.
+         maxsz <sz>  the maximum size of a server's filter. The default is 16m.
+
+   Type: Any, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int XrdCmsConfig::xbloom(XrdSysError *eDest, XrdOucStream &CFile)
+{   char *val;
+
+    BloomInt = 10*60;
+    while((val = CFile.GetWord()))
+         {     if (!strcmp("int", val))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "bloom int value not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2tm(*eDest,"bloom int",val,&BloomInt,60))
+                      return 1;
+                  }
+          else if (!strcmp("fpr", val))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "bloom fpr value not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(*eDest,"bloom fpr",val,&BloomFPR,1,50))
+                      return 1;
+                  }
+          else if (!strcmp("maxsz", val))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "bloom maxsz value not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2sz(*eDest,"bloom maxsz",val,&BloomMax,
+                                       4096, 64*1024*1024)) return 1;
+                  }
+          else eDest->Say("Config warning: ignoring invalid bloom option '",
+                          val, "'.");
+         }
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x c i d                                   */
 /******************************************************************************/
@@ -2613,8 +2692,8 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                                        [fuzz <p>] [maxload <p>] [refreset <sec>]
                                        [maxretries <n>[@<host>:<port>]]
                                        [nomultisrc[@<host>:<port>]]
-                [affinity [default] {none | weak | strong | strict}]
-                [affpath {all | first m | last n}]
+                [affinity [default] {none | weak | strong | strict | hash}]
+                [affbound <p>] [affpath {all | first m | last n}]
 
              <p>      is the percentage to include in the load as a value
                       between 0 and 100. For fuzz this is the largest
@@ -2624,7 +2703,11 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                       between reference counter resets. gshr is the percentage
                       share of requests that should be redirected here via the 
                       metamanager (i.e. global share). The gsdflt is the
-                      default to be used by the metamanager.
+                      default to be used by the metamanager. The affbound
+                      is how far above the average load (as a percentage of
+                      the average) the preferred server of a hashed affinity
+                      selection may be before a lower ranked server is used.
+                      For writes the average space utilization is used.
 
    Type: Any, dynamic.
 
@@ -2649,6 +2732,7 @@ int XrdCmsConfig::xsched(XrdSysError *eDest, XrdOucStream &CFile)
         {"space",    100, &P_dsk},
         {"maxload",  100, &MaxLoad},
         {"refreset", -1,  &RefReset},
+        {"affbound", 1000,&P_bound},
         {"affinity", -2,  0},
         {"affpath",  -3,  0},
         {"tryhname",   1, &V_hntry}
@@ -2710,6 +2794,8 @@ int XrdCmsConfig::xschedm(char *val, XrdSysError *eDest, XrdOucStream &CFile)
           {eDest->Emsg("Config", "sched affinity not specified"); return 0;}
       } else sched_Force = 1;
 
+   sched_Hash = 0;
+
    if (!strcmp(val, "none"))
       {sched_Pack = sched_Level = 0;
        return 1;
@@ -2717,6 +2803,11 @@ int XrdCmsConfig::xschedm(char *val, XrdSysError *eDest, XrdOucStream &CFile)
 
    sched_Pack = sched_Level = 1;
 
+   if (!strcmp(val, "hash"))
+      {sched_Hash = 1;
+       return 1;
+      }
+
    if (!strcmp(val, "weak")) return 1;
 
    sched_Pack = 2;
@@ -93,11 +93,15 @@ int         AskPerf;      // Seconds between perf queries
 int         AskPing;      // Number of ping requests per AskPerf window
 int         PingTick;     // Ping clock value
 int         LogPerf;      // AskPerf intervals before logging perf
+int         BloomInt;     // Seconds between namespace filter updates (0 -> off)
+int         BloomFPR;     // Namespace filter false positive target in percent
+long long   BloomMax;     // Namespace filter maximum size in bytes
 
 int         PortTCP;      // TCP Port to  listen on
 int         PortSUP;      // TCP Port to  listen on (supervisor)
 XrdInet    *NetTCP;       // -> Network Object
 
+int         P_bound;      // %     Load above average allowed for hashed pick
 int         P_cpu;        // % CPU Capacity in load factor
 int         P_dsk;        // % DSK Capacity in load factor
 int         P_fuzz;       // %     Capacity to fuzz when comparing
@@ -130,6 +134,7 @@ char        sched_Pack;   // 1 -> Pick with affinity (>1 same but wait for resps
 char        sched_AffPC;  // Affinity path component count (-255 <= n <= 255)
 char        sched_Level;  // 1 -> Use load-based level for "pack" selection
 char        sched_Force;  // 1 -> Client cannot select mode
+char        sched_Hash;   // 1 -> Use rendezvous hashing for "pack" selection
 int         doWait;       // 1 -> Wait for a data end-point
 
 int         adsPort;      // Alternate server port
@@ -222,6 +227,7 @@ void Usage(int rc);
 int  xapath(XrdSysError *edest, XrdOucStream &CFile);
 int  xallow(XrdSysError *edest, XrdOucStream &CFile);
 int  xaltds(XrdSysError *edest, XrdOucStream &CFile);
+int  xbloom(XrdSysError *edest, XrdOucStream &CFile);
 int  Fsysadd(XrdSysError *edest, int chk, char *fn);
 int  xblk(XrdSysError *edest, XrdOucStream &CFile, bool iswl=false);
 int  xcid(XrdSysError *edest, XrdOucStream &CFile);
@@ -58,7 +58,7 @@ void XrdCmsKey::setHash()
 /*                           S t a t i c   D a t a                            */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::TockTable[TickRate] = {0};
+XrdSysMutex    XrdCmsKeyItem::fMutex;
 XrdCmsKeyItem *XrdCmsKeyItem::Free    = 0;
 int            XrdCmsKeyItem::numFree = 0;
 int            XrdCmsKeyItem::numHave = 0;
@@ -68,24 +68,28 @@ int            XrdCmsKeyItem::numNull = 0;
 /* static public                   A l l o c                                  */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyItem::Alloc(XrdCmsKeyItem **tockTab,
+                                    unsigned int    theTock)
 {
   XrdCmsKeyItem *kP;
 
 // Try to allocate an existing item or replenish the list
 //
-   do {if ((kP = Free))
+   do {fMutex.Lock();
+       if ((kP = Free))
           {Free = kP->Next;
            numFree--;
+           fMutex.UnLock();
            theTock &= TickMask;
            kP->Key.TOD    = theTock;
-           kP->Key.TODRef = TockTable[theTock];
-           TockTable[theTock] = kP;
+           kP->Key.TODRef = tockTab[theTock];
+           tockTab[theTock] = kP;
            if (!(kP->Key.Ref++)) kP->Key.Ref = 1;
             kP->Loc.roPend = kP->Loc.rwPend = 0;
            return kP;
           }
        numNull++;
+       fMutex.UnLock();
        } while(Replenish());
 
 // We failed
@@ -109,19 +113,21 @@ void XrdCmsKeyItem::Recycle()
 
 // Put entry on the free list
 //
+   fMutex.Lock();
    Next = Free; Free = this;
    numFree++;
+   fMutex.UnLock();
 }
 
 /******************************************************************************/
 /* public                         R e l o a d                                 */
 /******************************************************************************/
   
-void XrdCmsKeyItem::Reload()
+void XrdCmsKeyItem::Reload(XrdCmsKeyItem **tockTab)
 {
    Key.TOD &= static_cast<unsigned char>(TickMask);
-   Key.TODRef = TockTable[Key.TOD];
-   TockTable[Key.TOD] = this;
+   Key.TODRef = tockTab[Key.TOD];
+   tockTab[Key.TOD] = this;
 }
 
 /******************************************************************************/
@@ -131,25 +137,30 @@ void XrdCmsKeyItem::Reload()
 int XrdCmsKeyItem::Replenish()
 {
    EPNAME("Replenish");
-   XrdCmsKeyItem *kP;
-   int i;
+   XrdCmsKeyItem *kP, *fP;
+   int i, nFree;
 
-// Allocate a quantum of free elements and chain them into the free list
+// Allocate a quantum of free elements
 //
    if (!(kP = new XrdCmsKeyItem[minAlloc])) return 0;
-   DEBUG("old free " <<numFree <<" + " <<minAlloc <<" = " <<numHave+minAlloc);
 
 // We would do this in an initializer but that causes problems when alloacting
-// temporary items on the stack. So, manually put these on the free list.
+// temporary items on the stack. So, manually chain these together and then
+// put the chain on the free list.
 //
-   i = minAlloc;
-   while(i--) {kP->Next = Free; Free = kP; kP++;}
+   fP = kP; kP->Next = 0;
+   for (i = 1; i < minAlloc; i++) {kP[i].Next = fP; fP = &kP[i];}
+
+   fMutex.Lock();
+   DEBUG("old free " <<numFree <<" + " <<minAlloc <<" = " <<numHave+minAlloc);
+   kP->Next = Free; Free = fP;
   
 // Return the number we have free
 //
    numHave += minAlloc;
-   numFree += minAlloc;
-   return numFree;
+   nFree = (numFree += minAlloc);
+   fMutex.UnLock();
+   return nFree;
 }
 
 /******************************************************************************/
@@ -159,17 +170,20 @@ int XrdCmsKeyItem::Replenish()
 void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 {
 
+   fMutex.Lock();
    isAlloc  = numHave;
    isFree   = numFree;
    wasNull  = numNull;
    numNull  = 0;
+   fMutex.UnLock();
 }
 
 /******************************************************************************/
 /* static public                  U n l o a d                                 */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem **tockTab,
+                                     unsigned int    theTock)
 {
    XrdCmsKeyItem myItem, *nP, *pP = &myItem;
 
@@ -179,31 +193,32 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
 // requires knowing the hash code, we save it elsewhere in the object.
 //
    theTock &= TickMask;
-   myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
+   myItem.Key.TODRef = tockTab[theTock]; tockTab[theTock] = 0;
    while((nP = pP->Key.TODRef))
          if (nP->Key.TOD == theTock) 
             {nP->Loc.HashSave = nP->Key.Hash; nP->Key.Hash = 0; pP = nP;}
             else {pP->Key.TODRef = nP->Key.TODRef;
-                  nP->Key.TODRef = TockTable[nP->Key.TOD];
-                  TockTable[nP->Key.TOD] = nP;
+                  nP->Key.TODRef = tockTab[nP->Key.TOD];
+                  tockTab[nP->Key.TOD] = nP;
                  }
    return myItem.Key.TODRef;
 }
 
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem *theItem)
+XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem **tockTab,
+                                     XrdCmsKeyItem  *theItem)
 {
    XrdCmsKeyItem *kP, *pP = 0;
    unsigned int theTock = theItem->Key.TOD & TickMask;
 
 // Remove the entry from the right list
 //
-   kP = TockTable[theTock];
+   kP = tockTab[theTock];
    while(kP && kP != theItem) {pP = kP; kP = kP->Key.TODRef;}
    if (kP)
       {if (pP) pP->Key.TODRef     = kP->Key.TODRef;
-          else TockTable[theTock] = kP->Key.TODRef;
+          else tockTab[theTock]   = kP->Key.TODRef;
        kP->Loc.HashSave = kP->Key.Hash; kP->Key.Hash = 0;
       }
    return kP;
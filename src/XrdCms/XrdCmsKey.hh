@@ -33,6 +33,7 @@
 #include <cstring>
 
 #include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
 /*                       C l a s s   X r d C m s K e y                        */
@@ -92,6 +93,7 @@ public:
 SMask_t        hfvec;    // Servers that are staging or have the file
 SMask_t        pfvec;    // Servers that are staging         the file
 SMask_t        qfvec;    // Servers that are not yet queried
+SMask_t        sfvec;    // Servers skipped as their filter rules the file out
 unsigned int   TOD_B;    // Server currency clock
 int            lifeline; // TOD when nil entry should expire
 union {
@@ -120,7 +122,9 @@ XrdCmsKeyLoc&  operator=(const XrdCmsKeyLoc &rhs)
   
 // The XrdCmsKeyItem object marries the XrdCmsKey and XrdCmsKeyLoc objects in
 // the key cache. It is only used by logical manipulator, XrdCmsCache, which
-// always front-ends the physical manipulator, XrdCmsNash.
+// always front-ends the physical manipulator, XrdCmsNash. The aging list
+// (i.e. the tock table) is supplied by the caller and must be serialized by
+// it. The free list is shared by all callers and is serialized internally.
 //
 class XrdCmsKeyItem
 {
@@ -130,19 +134,19 @@ public:
        XrdCmsKey      Key;
        XrdCmsKeyItem *Next;
 
-static XrdCmsKeyItem *Alloc(unsigned int theTock);
+static XrdCmsKeyItem *Alloc(XrdCmsKeyItem **tockTab, unsigned int theTock);
 
        void           Recycle();
 
-       void           Reload();
+       void           Reload(XrdCmsKeyItem **tockTab);
 
 static int            Replenish();
 
 static void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
 
-static XrdCmsKeyItem *Unload(unsigned int   theTock);
+static XrdCmsKeyItem *Unload(XrdCmsKeyItem **tockTab, unsigned int theTock);
 
-static XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+static XrdCmsKeyItem *Unload(XrdCmsKeyItem **tockTab, XrdCmsKeyItem *theItem);
 
        XrdCmsKeyItem() {}  // Warning see the constructor!
       ~XrdCmsKeyItem() {}  // These are usually never deleted
@@ -154,7 +158,7 @@ static const          int minFree  = 1024;
 
 private:
 
-static XrdCmsKeyItem *TockTable[TickRate];
+static XrdSysMutex    fMutex;
 static XrdCmsKeyItem *Free;
 static int            numFree;
 static int            numHave;
@@ -38,6 +38,10 @@
   
 XrdCmsNash::XrdCmsNash(int psize, int csize)
 {
+     memset((void *)TockTable, 0, sizeof(TockTable));
+     oldtable      = 0;
+     oldtablesize  = 0;
+     oldnext       = 0;
      prevtablesize = psize;
      nashtablesize = csize;
      Threshold     = (csize * LoadMax) / 100;
@@ -58,11 +62,14 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 
 // Allocate the entry
 //
-   if (!(hip = XrdCmsKeyItem::Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
+   if (!(hip = XrdCmsKeyItem::Alloc(TockTable, Key.TOD)))
+      return (XrdCmsKeyItem *)0;
 
-// Check if we should expand the table
+// Check if we should expand the table. Otherwise, move a few more entries out
+// of the table being replaced by a previous expansion.
 //
    if (++nashnum > Threshold) Expand();
+      else if (oldtable) Migrate(MoveMax);
 
 // Fill out the key data
 //
@@ -80,12 +87,20 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 /******************************************************************************/
 /* private                        E x p a n d                                 */
 /******************************************************************************/
+
+// Expansion is incremental. The new table replaces the current one and the
+// entries in the old table are moved a few at a time as entries are added.
+// Lookups consult both tables until the old one has been drained.
   
 void XrdCmsNash::Expand()
 {
-   int newsize, newent, i;
+   int newsize;
    size_t memlen;
-   XrdCmsKeyItem **newtab, *nip, *nextnip;
+   XrdCmsKeyItem **newtab;
+
+// If a previous expansion has not completed, complete it now
+//
+   if (oldtable) Migrate(oldtablesize);
 
 // Compute new size for table using a fibonacci series
 //
@@ -97,22 +112,11 @@ void XrdCmsNash::Expand()
    if (!(newtab = (XrdCmsKeyItem **) malloc(memlen))) return;
    memset((void *)newtab, 0, memlen);
 
-// Redistribute all of the current items
-//
-   for (i = 0; i < nashtablesize; i++)
-       {nip = nashtable[i];
-        while(nip)
-             {nextnip = nip->Next;
-              newent  = nip->Key.Hash % newsize;
-              nip->Next = newtab[newent];
-              newtab[newent] = nip;
-              nip = nextnip;
-             }
-       }
-
-// Free the old table and plug in the new table
+// Retire the current table and plug in the new table
 //
-   free((void *)nashtable);
+   oldtable      = nashtable;
+   oldtablesize  = nashtablesize;
+   oldnext       = 0;
    nashtable     = newtab;
    prevtablesize = nashtablesize;
    nashtablesize = newsize;
@@ -143,9 +147,49 @@ XrdCmsKeyItem *XrdCmsNash::Find(XrdCmsKey &Key)
 //
    nip = nashtable[kent];
    while(nip && nip->Key != Key) nip = nip->Next;
+
+// If the entry was not found it may not yet have been moved to the new table
+//
+   if (!nip && oldtable)
+      {nip = oldtable[Key.Hash%oldtablesize];
+       while(nip && nip->Key != Key) nip = nip->Next;
+      }
    return nip;
 }
 
+/******************************************************************************/
+/* private                        M i g r a t e                               */
+/******************************************************************************/
+  
+void XrdCmsNash::Migrate(int numMove)
+{
+   XrdCmsKeyItem *nip, *nextnip;
+   unsigned int hval;
+   int newent;
+
+// Redistribute the indicated number of old table entries. Items that have
+// been unloaded carry their hash value in Loc.HashSave.
+//
+   while(numMove-- && oldnext < oldtablesize)
+        {nip = oldtable[oldnext]; oldtable[oldnext++] = 0;
+         while(nip)
+              {nextnip = nip->Next;
+               hval    = (nip->Key.Hash ? nip->Key.Hash : nip->Loc.HashSave);
+               newent  = hval % nashtablesize;
+               nip->Next = nashtable[newent];
+               nashtable[newent] = nip;
+               nip = nextnip;
+              }
+        }
+
+// Free the old table if it has been drained
+//
+   if (oldnext >= oldtablesize)
+      {free((void *)oldtable);
+       oldtable = 0; oldtablesize = 0; oldnext = 0;
+      }
+}
+
 /******************************************************************************/
 /* public                        R e c y c l e                                */
 /******************************************************************************/
@@ -155,23 +199,28 @@ XrdCmsKeyItem *XrdCmsNash::Find(XrdCmsKey &Key)
 //
 int XrdCmsNash::Recycle(XrdCmsKeyItem *rip)
 {
-   XrdCmsKeyItem *nip, *pip = 0;
+   XrdCmsKeyItem *nip, *pip = 0, **tab = nashtable;
    unsigned int kent;
 
 // Compute position of the hash table entry
 //
    kent = rip->Loc.HashSave%nashtablesize;
 
-// Find the entry
+// Find the entry, it may still be in the table being drained
 //
    nip = nashtable[kent];
    while(nip && nip != rip) {pip = nip; nip = nip->Next;}
+   if (!nip && oldtable)
+      {kent = rip->Loc.HashSave%oldtablesize; tab = oldtable; pip = 0;
+       nip  = oldtable[kent];
+       while(nip && nip != rip) {pip = nip; nip = nip->Next;}
+      }
 
 // Remove and recycle if found
 //
    if (nip)
       {if (pip) pip->Next = nip->Next;
-          else nashtable[kent] = nip->Next;
+          else tab[kent] = nip->Next;
           rip->Recycle();
           nashnum--;
       }
@@ -41,6 +41,15 @@ XrdCmsKeyItem *Find(XrdCmsKey &Key);
 
 int            Recycle(XrdCmsKeyItem *rip);
 
+// Unload() removes items from the aging list (see XrdCmsKeyItem::Unload()).
+// Each nash has its own aging list so that it can be aged independently.
+//
+XrdCmsKeyItem *Unload(unsigned int theTock)
+                     {return XrdCmsKeyItem::Unload(TockTable, theTock);}
+
+XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem)
+                     {return XrdCmsKeyItem::Unload(TockTable, theItem);}
+
 // When allocateing a new nash, specify the required starting size. Make
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
@@ -51,10 +60,16 @@ int            Recycle(XrdCmsKeyItem *rip);
 private:
 
 static const int LoadMax = 80;
+static const int MoveMax =  4;
 
 void               Expand();
+void               Migrate(int numMove);
 
+XrdCmsKeyItem   *TockTable[XrdCmsKeyItem::TickRate];
 XrdCmsKeyItem  **nashtable;
+XrdCmsKeyItem  **oldtable;   // Table being drained after an expansion
+int              oldtablesize;
+int              oldnext;    // Next oldtable entry to be moved
 int              prevtablesize;
 int              nashtablesize;
 int              nashnum;
@@ -41,6 +41,7 @@
 #include "XProtocol/YProtocol.hh"
 
 #include "XrdCms/XrdCmsBaseFS.hh"
+#include "XrdCms/XrdCmsBloom.hh"
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsCluster.hh"
 #include "XrdCms/XrdCmsClustID.hh"
@@ -110,6 +111,7 @@ XrdCmsNode::XrdCmsNode(XrdLink *lnkp, const char *theIF, const char *nid,
     myNID    = strdup(nid ? nid : "?");
     if ((myCID = index(myNID, ' '))) myCID++;
        else myCID = myNID;
+    myHash   = XrdOucCRC::Calc32C(myNID, strlen(myNID));
     myLevel  = lvl;
     myVersion= kYR_Version;
 
@@ -133,6 +135,8 @@ XrdCmsNode::~XrdCmsNode()
 // Delete other appendages
 //
    if (cidP) {cidP->RemNode(this); cidP = 0;}
+   if (bloomP)   delete bloomP;
+   if (bloomNew) delete bloomNew;
    if (Ident) free(Ident);
    if (myNID) free(myNID);
    if (myName)free(myName);
@@ -296,6 +300,65 @@ const char *XrdCmsNode::do_Avail(XrdCmsRRData &Arg)
    return 0;
 }
 
+/******************************************************************************/
+/*                              d o _ B l o o m                               */
+/******************************************************************************/
+  
+// Process: bloom <gen> <words> <offset> <hashes> <keys> <data>
+
+const char *XrdCmsNode::do_Bloom(XrdCmsRRData &Arg)
+{
+   EPNAME("do_Bloom")
+   static const int hdrLen = sizeof(CmsBloomRequest) - sizeof(CmsRRHdr);
+   CmsBloomRequest bReq;
+   XrdCmsBloom *bP;
+   unsigned int gen, words, offs, keys;
+   int hashes, rc;
+
+// Ignore filters unless we have been configured to use them
+//
+   if (!Config.BloomInt || Arg.Dlen < hdrLen) return 0;
+
+// Extract the segment information
+//
+   memcpy(&bReq.Gen, Arg.Buff, hdrLen);
+   gen    = ntohl(bReq.Gen);
+   words  = ntohl(bReq.Words);
+   offs   = ntohl(bReq.Offset);
+   hashes = ntohs(bReq.Hashes);
+   keys   = ntohl(bReq.Keys);
+
+// The first segment starts a new filter
+//
+   if (!offs)
+      {if (!words || words > XrdCmsBloom::maxWords
+       ||  hashes < 1 || hashes > XrdCmsBloom::maxHash)
+          {Say.Emsg("do_Bloom", "Invalid namespace filter from", Ident);
+           return 0;
+          }
+       Cluster.SetBloom(this, new XrdCmsBloom(gen, words, keys, hashes));
+      }
+
+// Add the segment to the filter being received. Only this thread replaces the
+// filter being received so we need not lock it here.
+//
+   if (!(bP = bloomNew) || bP->Gen != gen
+   ||  (rc = bP->Load(offs, Arg.Buff+hdrLen, Arg.Dlen-hdrLen)) < 0)
+      {if (bP) Cluster.SetBloom(this, 0);
+       DEBUGR("discarded out of sequence segment " <<offs <<" gen " <<gen);
+       return 0;
+      }
+
+// If the filter is complete, make it the one in effect
+//
+   if (rc)
+      {DEBUGR("filter gen " <<gen <<" keys=" <<keys <<" words=" <<words
+              <<" hashes=" <<hashes <<" fpr=" <<bP->FPR());
+       Cluster.SetBloom(this, 0, true);
+      }
+   return 0;
+}
+
 /******************************************************************************/
 /*                              d o _ C h m o d                               */
 /******************************************************************************/
@@ -432,7 +495,9 @@ const char *XrdCmsNode::do_Have(XrdCmsRRData &Arg)
             if (baseFS.isDFS())
                {Sel.Vec.hf = pinfo.rovec; Sel.Vec.wf = pinfo.rwvec;
                 isnew       = Cache.AddFile(Sel, allNodes);
-               } else isnew = Cache.AddFile(Sel, NodeMask);
+               } else {isnew = Cache.AddFile(Sel, NodeMask);
+                       if (Config.BloomInt) Cluster.AddBloom(this, Arg.Path);
+                      }
            }
 
 // Return if we have no managers or we already informed the managers
@@ -1458,9 +1523,16 @@ int XrdCmsNode::do_StateFWD(XrdCmsRRData &Arg)
 // whether they have the file.
 //
    if (!retc || Sel.Vec.bf != 0)
-      {if (!retc) Cache.AddFile(Sel, 0);
-       Cluster.Broadcast((retc ? Sel.Vec.bf : pinfo.rovec), Arg.Request,
-                         (void *)Arg.Buff, Arg.Dlen);
+      {SMask_t qVec = Sel.Vec.bf;
+       if (!retc)
+          {Cache.AddFile(Sel, 0);
+           if (Arg.Request.modifier & CmsStateRequest::kYR_refresh)
+              qVec = pinfo.rovec;
+              else if ((qVec = Cluster.Prune(Sel.Path, pinfo.rovec))
+                   != pinfo.rovec) Cache.SkpFile(Sel, pinfo.rovec & ~qVec);
+          }
+       if (qVec) Cluster.Broadcast(qVec, Arg.Request,
+                                   (void *)Arg.Buff, Arg.Dlen);
       }
 
 // Return true if anyone has the file at this point. In shared-nothing systems
@@ -45,6 +45,7 @@
 
 class XrdCmsBaseFR;
 class XrdCmsBaseFS;
+class XrdCmsBloom;
 class XrdCmsClustID;
 class XrdCmsDrop;
 class XrdCmsManager;
@@ -92,6 +93,7 @@ unsigned int    DiskTotal = 0;// Total disk space in GB
 unsigned int    ConfigID  = 0;// Configuration identifier
 
 const  char  *do_Avail(XrdCmsRRData &Arg);
+const  char  *do_Bloom(XrdCmsRRData &Arg);
 const  char  *do_Chmod(XrdCmsRRData &Arg);
 const  char  *do_Disc(XrdCmsRRData &Arg);
 const  char  *do_Gone(XrdCmsRRData &Arg);
@@ -237,6 +239,8 @@ time_t             DropTime = 0;
 XrdCmsDrop        *DropJob  = 0;
 
 XrdCmsClustID     *cidP     = 0;
+XrdCmsBloom       *bloomP   = 0; // Namespace filter in effect (STMutex)
+XrdCmsBloom       *bloomNew = 0; // Namespace filter being received (STMutex)
 SMask_t            NodeMask;
 int                NodeID;
 int                Instance;
@@ -247,6 +251,7 @@ char              *myCID;        // Constructor
 char              *myNID;        // Constructor
 char              *myName   = 0;
 int                myNlen   = 0;
+unsigned int       myHash;       // Constructor (hash of myNID)
 
 int                logload;
 int                myCost   = 0; // Overall cost (determined by location)
@@ -59,6 +59,7 @@ XrdCmsRouter::theRoute initRouter[] =
        {kYR_trunc,   "trunc",  &XrdCmsNode::do_Trunc},
 /* Server */
        {kYR_avail,   "avail",  &XrdCmsNode::do_Avail},
+       {kYR_bloom,   "bloom",  &XrdCmsNode::do_Bloom},
        {kYR_disc,    "disc",   &XrdCmsNode::do_Disc},
        {kYR_gone,    "gone",   &XrdCmsNode::do_Gone},
        {kYR_have,    "have",   &XrdCmsNode::do_Have},
@@ -153,6 +154,7 @@ namespace XrdCms
 {
 XrdCmsRouting::theRouting initRSProuting[] =
      {{kYR_avail,   XrdCmsRouting::isSync},
+      {kYR_bloom,   XrdCmsRouting::isSync},
       {kYR_disc,    XrdCmsRouting::isSync | XrdCmsRouting::noArgs},
       {kYR_gone,    XrdCmsRouting::isSync},
       {kYR_have,    XrdCmsRouting::AsyncQ0},
@@ -56,7 +56,8 @@ set_target_properties(
 
 set( XrdCryptoLiteSources
      XrdCrypto/XrdCryptoLite.cc      XrdCrypto/XrdCryptoLite.hh
-     XrdCrypto/XrdCryptoLite_bf32.cc )
+     XrdCrypto/XrdCryptoLite_bf32.cc
+     XrdCrypto/XrdCryptoLite_aesgcm.cc )
 
 add_library(
   XrdCryptoLite
@@ -48,6 +48,7 @@ public:
 
 //           Supported names:
 //           bf32      Blowfish with CRC32 validation.
+//           aesgcm    AES-256 in GCM mode (authenticated).
 //
 static XrdCryptoLite *
              Create(int        &rc,        // errno when Create(...) == 0
@@ -0,0 +1,189 @@
+/******************************************************************************/
+/*                                                                            */
+/*               X r d C r y p t o L i t e _ a e s g c m . c c                */
+/*                                                                            */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdCrypto/XrdCryptoLite.hh"
+
+#ifdef HAVE_SSL
+
+#include <cerrno>
+#include <cstring>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+/******************************************************************************/
+/*            C l a s s   X r d C r y p t o L i t e _ a e s g c m             */
+/******************************************************************************/
+
+// Each message is laid out as <iv><ciphertext><tag>. The iv is random and the
+// tag authenticates the data, so no separate checksum is needed. The cipher
+// is AES-256; keys that are not 256 bits long are hashed with SHA-256.
+//
+class XrdCryptoLite_aesgcm : public XrdCryptoLite
+{
+public:
+
+virtual int  Decrypt(const char *key,      // Decryption key
+                     int         keyLen,   // Decryption key byte length
+                     const char *src,      // Buffer to be decrypted
+                     int         srcLen,   // Bytes length of src  buffer
+                     char       *dst,      // Buffer to hold decrypted result
+                     int         dstLen);  // Bytes length of dst  buffer
+
+virtual int  Encrypt(const char *key,      // Encryption key
+                     int         keyLen,   // Encryption key byte length
+                     const char *src,      // Buffer to be encrypted
+                     int         srcLen,   // Bytes length of src  buffer
+                     char       *dst,      // Buffer to hold encrypted result
+                     int         dstLen);  // Bytes length of dst  buffer
+
+         XrdCryptoLite_aesgcm(const char deType)
+                             : XrdCryptoLite(deType, ivLen+tagLen) {}
+        ~XrdCryptoLite_aesgcm() {}
+
+private:
+
+static const int ivLen  = 12;
+static const int tagLen = 16;
+static const int keySZ  = 32;
+
+const unsigned char *setKey(const char *key, int keyLen, unsigned char *buff);
+};
+
+/******************************************************************************/
+/*                               D e c r y p t                                */
+/******************************************************************************/
+
+int XrdCryptoLite_aesgcm::Decrypt(const char *key,
+                                  int         keyLen,
+                                  const char *src,
+                                  int         srcLen,
+                                  char       *dst,
+                                  int         dstLen)
+{
+   const unsigned char *iv = (const unsigned char *)src, *kP;
+   unsigned char kBuff[keySZ];
+   int wLen, fLen, dLen = srcLen - ivLen - tagLen;
+   bool aOK;
+
+// Make sure we have data
+//
+   if (dLen <= 0 || dstLen < dLen || keyLen <= 0) return -EINVAL;
+   kP = setKey(key, keyLen, kBuff);
+
+// Decrypt and verify the tag
+//
+   EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+   if (!ctx) return -ENOMEM;
+   aOK = EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, kP, iv) == 1
+      && EVP_DecryptUpdate(ctx, (unsigned char *)dst, &wLen,
+                           iv+ivLen, dLen) == 1
+      && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, tagLen,
+                             (void *)(src+ivLen+dLen)) == 1
+      && EVP_DecryptFinal_ex(ctx, (unsigned char *)dst+wLen, &fLen) == 1;
+   EVP_CIPHER_CTX_free(ctx);
+   memset(kBuff, 0, sizeof(kBuff));
+
+// A tag mismatch means the data was altered or the key is wrong
+//
+   return (aOK ? dLen : -EPROTO);
+}
+
+/******************************************************************************/
+/*                               E n c r y p t                                */
+/******************************************************************************/
+
+int XrdCryptoLite_aesgcm::Encrypt(const char *key,
+                                  int         keyLen,
+                                  const char *src,
+                                  int         srcLen,
+                                  char       *dst,
+                                  int         dstLen)
+{
+   unsigned char *iv = (unsigned char *)dst, kBuff[keySZ];
+   const unsigned char *kP;
+   int wLen, fLen;
+   bool aOK;
+
+// Make sure the destination can hold the iv and tag and we have data
+//
+   if (dstLen-srcLen < ivLen+tagLen || srcLen <= 0 || keyLen <= 0)
+      return -EINVAL;
+
+// Generate a fresh iv for this message
+//
+   if (RAND_bytes(iv, ivLen) != 1) return -EIO;
+   kP = setKey(key, keyLen, kBuff);
+
+// Encrypt and append the tag
+//
+   EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+   if (!ctx) return -ENOMEM;
+   aOK = EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, kP, iv) == 1
+      && EVP_EncryptUpdate(ctx, iv+ivLen, &wLen,
+                           (const unsigned char *)src, srcLen) == 1
+      && EVP_EncryptFinal_ex(ctx, iv+ivLen+wLen, &fLen) == 1
+      && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, tagLen,
+                             iv+ivLen+srcLen) == 1;
+   EVP_CIPHER_CTX_free(ctx);
+   memset(kBuff, 0, sizeof(kBuff));
+
+// Return the full length of the message
+//
+   return (aOK ? srcLen+ivLen+tagLen : -EIO);
+}
+
+/******************************************************************************/
+/*                                s e t K e y                                 */
+/******************************************************************************/
+
+const unsigned char *XrdCryptoLite_aesgcm::setKey(const char *key, int keyLen,
+                                                  unsigned char *buff)
+{
+   unsigned int mdLen;
+
+// Keys of the right size are used as is, others are hashed to fit
+//
+   if (keyLen == keySZ) return (const unsigned char *)key;
+   EVP_Digest(key, keyLen, buff, &mdLen, EVP_sha256(), 0);
+   return buff;
+}
+#endif
+
+/******************************************************************************/
+/*              X r d C r y p t o L i t e _ N e w _ a e s g c m               */
+/******************************************************************************/
+
+XrdCryptoLite *XrdCryptoLite_New_aesgcm(const char Type)
+{
+#ifdef HAVE_SSL
+   return (XrdCryptoLite *)(new XrdCryptoLite_aesgcm(Type));
+#else
+   return (XrdCryptoLite *)0;
+#endif
+}
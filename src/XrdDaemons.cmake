@@ -31,6 +31,7 @@ add_executable(
   Xrd/XrdMain.cc
   XrdCms/XrdCmsAdmin.cc           XrdCms/XrdCmsAdmin.hh
   XrdCms/XrdCmsBaseFS.cc          XrdCms/XrdCmsBaseFS.hh
+  XrdCms/XrdCmsBloom.cc           XrdCms/XrdCmsBloom.hh
   XrdCms/XrdCmsCache.cc           XrdCms/XrdCmsCache.hh
   XrdCms/XrdCmsCluster.cc         XrdCms/XrdCmsCluster.hh
   XrdCms/XrdCmsClustID.cc         XrdCms/XrdCmsClustID.hh
@@ -29,6 +29,8 @@
 #include "XrdOuc/XrdOucStream.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucGMap.hh"
+#include "XrdOuc/XrdOucLatency.hh"
+#include "XrdOuc/XrdOuca2x.hh"
 #include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
@@ -79,6 +81,9 @@ int XrdHttpProtocol::crlRefIntervalSec = XrdTlsContext::DEFAULT_CRL_REF_INT_SEC;
 char *XrdHttpProtocol::sslcipherfilter = 0;
 char *XrdHttpProtocol::listredir = 0;
 bool XrdHttpProtocol::listdeny = false;
+int XrdHttpProtocol::putdirect = 0;
+char *XrdHttpProtocol::metricspath = 0;
+XrdOucLatency *XrdHttpProtocol::latTab[4] = {0, 0, 0, 0};
 bool XrdHttpProtocol::embeddedstatic = true;
 char *XrdHttpProtocol::staticredir = 0;
 XrdOucHash<XrdHttpProtocol::StaticPreloadInfo> *XrdHttpProtocol::staticpreload = 0;
@@ -562,6 +567,10 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
 
 
 
+  // While a direct PUT write is pending the bridge owns the socket, so we
+  // must neither read from it nor advance the request state machine.
+  if (CurrentReq.putDirectActive()) return 0;
+
   if (!DoingLogin) {
     // Re-invocations triggered by the bridge have lp==0
     // In this case we keep track of a different request state
@@ -607,6 +616,8 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
           TRACE(DEBUG, " Parsing of first line failed with " << result);
           return -1;
         }
+        CurrentReq.latBeg = XrdOucLatency::Start(Latency(CurrentReq.request),
+                                                 Link->getReadyTime(), latRdy);
       }
       else
         CurrentReq.parseLine((char *)tmpline.c_str(), rc);
@@ -901,6 +912,16 @@ void XrdHttpProtocol::Recycle(XrdLink *lp, int csec, const char *reason) {
   ProtStack.Push(&ProtLink);
 }
 
+XrdOucLatency *XrdHttpProtocol::Latency(int reqType) {
+  switch (reqType) {
+    case XrdHttpReq::rtGET:      return latTab[0];
+    case XrdHttpReq::rtHEAD:     return latTab[1];
+    case XrdHttpReq::rtPUT:      return latTab[2];
+    case XrdHttpReq::rtPROPFIND: return latTab[3];
+    default:                     return 0;
+  }
+}
+
 int XrdHttpProtocol::Stats(char *buff, int blen, int do_sync) {
   // Synchronize statistics if need be
   //
@@ -929,7 +950,7 @@ int XrdHttpProtocol::Stats(char *buff, int blen, int do_sync) {
   //  //
   //  return SI->Stats(buff, blen, do_sync);
 
-  return 0;
+  return XrdOucLatency::Report("http", buff, blen);
 }
 
 /******************************************************************************/
@@ -1034,6 +1055,8 @@ int XrdHttpProtocol::Config(const char *ConfigFN, XrdOucEnv *myEnv) {
       else if TS_Xeq("staticredir", xstaticredir);
       else if TS_Xeq("staticpreload", xstaticpreload);
       else if TS_Xeq("listingdeny", xlistdeny);
+      else if TS_Xeq("putdirect", xputdirect);
+      else if TS_Xeq("metrics", xmetrics);
       else if TS_Xeq("header2cgi", xheader2cgi);
       else if TS_Xeq("httpsmode", xhttpsmode);
       else if TS_Xeq("tlsreuse", xtlsreuse);
@@ -1360,10 +1383,11 @@ int XrdHttpProtocol::getDataOneShot(int blen, bool wait) {
 int XrdHttpProtocol::BuffAvailable() {
   int r;
 
+  // When wrapped, one byte is left free as a full buffer would look empty
   if (myBuffEnd >= myBuffStart)
     r = myBuff->buff + myBuff->bsize - myBuffEnd;
   else
-    r = myBuffStart - myBuffEnd;
+    r = myBuffStart - myBuffEnd - 1;
 
   if ((r < 0) || (r > myBuff->bsize)) {
     TRACE(REQ, "internal error, myBuffAvailable: " << r << " myBuff->bsize " << myBuff->bsize);
@@ -1660,6 +1684,15 @@ int XrdHttpProtocol::Configure(char *parms, XrdProtocol_Config * pi) {
   XrdHttpTrace.SetLogger(pi->eDest->logger());
   //  SI = new XrdXrootdStats(pi->Stats);
   Sched = pi->Sched;
+
+  // Allocate the latency histograms for the requests we time
+  //
+  if (!latTab[0]) {
+    latTab[0] = new XrdOucLatency("http", "get");
+    latTab[1] = new XrdOucLatency("http", "head");
+    latTab[2] = new XrdOucLatency("http", "put");
+    latTab[3] = new XrdOucLatency("http", "propfind");
+  }
   BPool = pi->BPool;
   hailWait = 10000;
   readWait = 30000;
@@ -1843,6 +1876,7 @@ void XrdHttpProtocol::Reset() {
 
   ResumeBytes = 0;
   Resume = 0;
+  latRdy = 0;
 
   //
   //  numReads = 0;
@@ -2226,6 +2260,91 @@ int XrdHttpProtocol::xlistdeny(XrdOucStream & Config) {
   return 0;
 }
 
+/******************************************************************************/
+/*                                x p u t d i r e c t                         */
+/******************************************************************************/
+
+/* Function: xputdirect
+
+   Purpose:  To parse the directive: putdirect {off | <blen>}
+
+             off      stage all PUT data in the protocol buffer (default)
+             <blen>   the maximum number of bytes a single PUT write may read
+                      directly from the socket into the server's buffers,
+                      bypassing the protocol buffer. Only used for plain
+                      http uploads that are not chunk encoded.
+
+   Output: 0 upon success or !0 upon failure.
+ */
+
+int XrdHttpProtocol::xputdirect(XrdOucStream & Config) {
+  char *val;
+  long long blen;
+
+  // Get the value
+  //
+  val = Config.GetWord();
+  if (!val || !val[0]) {
+    eDest.Emsg("Config", "putdirect value not specified");
+    return 1;
+  }
+
+  // Record the value
+  //
+  if (!strcmp(val, "off")) {
+    putdirect = 0;
+    return 0;
+  }
+
+  if (XrdOuca2x::a2sz(eDest, "putdirect size", val, &blen, 65536, 0x40000000))
+    return 1;
+  putdirect = static_cast<int>(blen);
+
+  return 0;
+}
+
+/******************************************************************************/
+/*                                 x m e t r i c s                            */
+/******************************************************************************/
+
+/* Function: xmetrics
+
+   Purpose:  To parse the directive: metrics {off | <path>}
+
+             off      do not serve metrics (default)
+             <path>   the path at which a GET returns the request latency
+                      histograms of all protocols in Prometheus text format.
+
+   Output: 0 upon success or !0 upon failure.
+ */
+
+int XrdHttpProtocol::xmetrics(XrdOucStream & Config) {
+  char *val;
+
+  // Get the path
+  //
+  val = Config.GetWord();
+  if (!val || !val[0]) {
+    eDest.Emsg("Config", "metrics path not specified");
+    return 1;
+  }
+
+  // Record the path
+  //
+  if (metricspath) free(metricspath);
+  if (!strcmp(val, "off")) {
+    metricspath = 0;
+    return 0;
+  }
+  if (*val != '/') {
+    eDest.Emsg("Config", "metrics path is not absolute -", val);
+    return 1;
+  }
+  metricspath = strdup(val);
+
+  return 0;
+}
+
 /******************************************************************************/
 /*                                 x l i s t r e d i r                        */
 /******************************************************************************/
@@ -2733,7 +2852,9 @@ int XrdHttpProtocol::xsslcipherfilter(XrdOucStream & Config) {
 
 /* Function: xtlsreuse
 
-   Purpose:  To parse the directive: tlsreuse {on | off}
+   Purpose:  To parse the directive: tlsreuse {on [notickets] | off}
+
+             notickets does not issue session tickets to clients.
 
    Output: 0 upon success or 1 upon failure.
  */
@@ -2759,7 +2880,11 @@ int XrdHttpProtocol::xtlsreuse(XrdOucStream & Config) {
 //
    if (!strcmp(val, "on"))
       {tlsCache = XrdTlsContext::scSrvr;
-       return 0;
+       if (!(val = Config.GetWord())) return 0;
+       if (!strcmp(val, "notickets"))
+          {tlsCache |= XrdTlsContext::scNoTk;
+           return 0;
+          }
       }
 
 // Bad argument
@@ -72,6 +72,7 @@ class XrdHttpSecXtractor;
 class XrdHttpExtHandler;
 struct XrdVersionInfo;
 class XrdOucGMap;
+class XrdOucLatency;
 class XrdCryptoFactory;
 
 class XrdHttpProtocol : public XrdProtocol {
@@ -202,6 +203,8 @@ private:
   static int xsslcipherfilter(XrdOucStream &Config);
   static int xdesthttps(XrdOucStream &Config);
   static int xlistdeny(XrdOucStream &Config);
+  static int xputdirect(XrdOucStream &Config);
+  static int xmetrics(XrdOucStream &Config);
   static int xlistredir(XrdOucStream &Config);
   static int xselfhttps2http(XrdOucStream &Config);
   static int xembeddedstatic(XrdOucStream &Config);
@@ -296,6 +299,9 @@ private:
   
   /// Tells that we are just waiting to have N bytes in the buffer
   long ResumeBytes;
+
+  /// Dispatch time of the link when the last request was started
+  long long latRdy;
   
   /// Private SSL context
   SSL *ssl;
@@ -398,6 +404,19 @@ protected:
   
   /// If true, any form of listing is denied
   static bool listdeny;
+
+  /// Max bytes per PUT write that the bridge reads directly from the socket
+  /// into its own buffers (plain http only), 0 to always stage in myBuff
+  static int putdirect;
+
+  /// Path at which request latency metrics are served, if any
+  static char *metricspath;
+
+  /// Latency histograms for the requests that we time
+  static XrdOucLatency *latTab[4];
+
+  /// Return the latency histograms for a request type or nil if not timed
+  static XrdOucLatency *Latency(int reqType);
   
   /// If client is HTTPS, self-redirect with HTTP+token
   static bool selfhttps2http;
@@ -45,6 +45,7 @@
 #include <sstream>
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucLatency.hh"
 #include "XrdHttpProtocol.hh"
 #include "Xrd/XrdLink.hh"
 #include "XrdXrootd/XrdXrootdBridge.hh"
@@ -1046,6 +1047,16 @@ int XrdHttpReq::ProcessHTTPReq() {
     case XrdHttpReq::rtGET:
     {
 
+        if (prot->metricspath && resource == prot->metricspath) {
+          std::string mText;
+          XrdOucLatency::Export(mText);
+          prot->SendSimpleResp(200, NULL,
+                               "Content-Type: text/plain; version=0.0.4",
+                               mText.c_str(), mText.size(), keepalive);
+          reset();
+          return keepalive ? 1 : -1;
+        }
+
         if (resource.beginswith("/static/")) {
 
             // This is a request for a /static resource
@@ -1462,6 +1473,39 @@ int XrdHttpReq::ProcessHTTPReq() {
             // write is finished; otherwise, wait for data.
             return (prot->BuffUsed() > chunk_bytes_remaining) ? 0 : 1;
           }
+        } else if (writtenbytes < length && XrdHttpProtocol::putdirect && !prot->ishttps) {
+
+          // --------- DIRECT WRITE
+          // Only what we already buffered is passed along; the bridge reads the
+          // remainder of the write straight from the socket into its own
+          // buffers. Writes are cut at putdirect boundaries so that, after the
+          // first one, they are all aligned to that size. Should the buffered
+          // data wrap, the write is limited to the contiguous part.
+          long long inbuff = (prot->myBuffEnd >= prot->myBuffStart ?
+                  prot->myBuffEnd - prot->myBuffStart :
+                  prot->myBuff->buff + prot->myBuff->bsize - prot->myBuffStart);
+          long long buffered;
+          long long bytes_to_write = putDirectLength(writtenbytes, length,
+                  XrdHttpProtocol::putdirect, inbuff, prot->BuffUsed(), buffered);
+
+          memset(&xrdreq, 0, sizeof (xrdreq));
+          xrdreq.write.requestid = htons(kXR_write);
+          memcpy(xrdreq.write.fhandle, fhandle, 4);
+          xrdreq.write.offset = htonll(writtenbytes);
+          xrdreq.write.dlen = htonl(bytes_to_write);
+          m_put_direct_buffered = buffered;
+
+          TRACEI(REQ, "Writing " << bytes_to_write << " directly, " << m_put_direct_buffered << " buffered");
+          if (!prot->Bridge->Run((char *) &xrdreq, prot->myBuffStart, m_put_direct_buffered)) {
+            prot->SendSimpleResp(500, NULL, NULL, (char *) "Could not run write request.", 0, false);
+            return -1;
+          }
+
+          // The socket now belongs to the bridge until the write completes and
+          // we must be reinvoked right after that.
+          m_put_direct = true;
+          return 0;
+
         } else if (writtenbytes < length) {
 
 
@@ -2418,8 +2462,12 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
         getfhandle();
         fopened = true;
 
-        // We try to completely fill up our buffer before flushing
-        prot->ResumeBytes = std::min(length - writtenbytes, (long long) prot->BuffAvailable());
+        // We try to completely fill up our buffer before flushing unless the
+        // bridge will read the data from the socket itself
+        if (XrdHttpProtocol::putdirect && !prot->ishttps && !m_transfer_encoding_chunked)
+          prot->ResumeBytes = 0;
+        else
+          prot->ResumeBytes = std::min(length - writtenbytes, (long long) prot->BuffAvailable());
 
         if (sendcontinue) {
           prot->SendSimpleResp(100, NULL, NULL, 0, 0, keepalive);
@@ -2436,7 +2484,15 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
         if (ntohs(xrdreq.header.requestid) == kXR_write) {
           int l = ntohl(xrdreq.write.dlen);
 
-          // Consume the written bytes
+          // Consume the written bytes. A direct write only used what we had
+          // buffered, the bridge read the rest from the socket.
+          if (m_put_direct) {
+            prot->BuffConsume(m_put_direct_buffered);
+            writtenbytes += l;
+            m_put_direct = false;
+            prot->ResumeBytes = 0;
+            return 0;
+          }
           prot->BuffConsume(ntohl(xrdreq.write.dlen));
           writtenbytes += l;
 
@@ -2809,6 +2865,13 @@ void XrdHttpReq::reset() {
 
   TRACE(REQ, " XrdHttpReq request ended.");
 
+  // Record how long the request took if it is one that we time
+  if (latBeg) {
+    XrdOucLatency *lP = XrdHttpProtocol::Latency(request);
+    if (lP) lP->Service(XrdOucLatency::Now() - latBeg);
+    latBeg = 0;
+  }
+
   //if (xmlbody) xmlFreeDoc(xmlbody);
   rwOps.clear();
   rwOps_split.clear();
@@ -2854,6 +2917,9 @@ void XrdHttpReq::reset() {
   m_current_chunk_size = -1;
   m_current_chunk_offset = 0;
 
+  m_put_direct = false;
+  m_put_direct_buffered = 0;
+
   m_trailer_headers = false;
   m_status_trailer = false;
 
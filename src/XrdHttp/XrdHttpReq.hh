@@ -86,6 +86,11 @@ private:
   long long m_current_chunk_offset;
   long long m_current_chunk_size;
 
+  // Whether a PUT write whose tail is read by the bridge directly from the
+  // socket is pending, and how much of it was taken from our buffer.
+  bool m_put_direct{false};
+  int m_put_direct_buffered{0};
+
   // Whether trailer headers were enabled
   bool m_trailer_headers{false};
 
@@ -153,12 +158,16 @@ public:
     writtenbytes = 0;
     fopened = false;
     headerok = false;
+    latBeg = 0;
   };
 
   virtual ~XrdHttpReq();
 
   virtual void reset();
 
+  /// True while a direct PUT write owns the socket
+  bool putDirectActive() const { return m_put_direct; }
+
   /// Parse the header
   int parseLine(char *line, int len);
 
@@ -299,6 +308,9 @@ public:
   /// In a long write, we track where we have arrived
   long long writtenbytes;
 
+  /// Time the request started, for the latency statistics
+  long long latBeg;
+
 
 
 
@@ -103,7 +103,7 @@ XrdHttpProtocol::HandleAuthentication(XrdLink* lp)
     return 1;
   }
 
-  XrdTlsPeerCerts pc(SSL_get_peer_certificate(ssl),SSL_get_peer_cert_chain(ssl));
+  XrdTlsPeerCerts pc(SSL_get_peer_certificate(ssl),XrdTlsPeerCerts::getChain(ssl));
   XrdCryptoX509Chain chain;
 
   if ((!pc.hasCert()) ||
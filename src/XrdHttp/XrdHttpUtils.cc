@@ -494,4 +494,13 @@ char *escapeXML(const char *str) {
 }
 
 
-
+// Size the next direct PUT write
+long long putDirectLength(long long written, long long length, long long align,
+                          long long contig, long long used,
+                          long long &buffered) {
+  long long wlen = std::min(length - written, align - written % align);
+
+  if (used > contig) wlen = std::min(wlen, contig);
+  buffered = std::min(contig, wlen);
+  return wlen;
+}
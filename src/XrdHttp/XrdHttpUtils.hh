@@ -89,6 +89,17 @@ char *unquote(char *str);
 // Escape a string and return a new one
 char *escapeXML(const char *str);
 
+// Size the next direct PUT write. written and length give the progress of the
+// upload, align the write boundary, contig the buffered bytes that are
+// contiguous from the buffer start and used all buffered bytes. Returns the
+// write length and sets buffered to how much of it comes from the buffer; the
+// rest is read from the socket. When the buffered data wraps around the end
+// of the buffer, only the contiguous part is written so that no buffered
+// bytes are skipped.
+long long putDirectLength(long long written, long long length, long long align,
+                          long long contig, long long used,
+                          long long &buffered);
+
 
  
 #endif	/* XRDHTTPUTILS_HH */
@@ -134,6 +134,55 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
    return Send(buff, (int)(bp-buff), dest, -1);
 }
   
+/******************************************************************************/
+/*                              S e n d M a n y                               */
+/******************************************************************************/
+
+int XrdNetMsg::SendMany(const struct iovec msgs[], int msgcnt, int tmo)
+{
+   int retc = 0;
+
+   if (!destOK)
+      {eDest->Emsg("Msg", "Destination not specified."); return -1;}
+
+   if (tmo >= 0 && !OK2Send(tmo, 0)) return 1;
+
+#if defined(__linux__)
+   static const int maxMsgs = 64;
+   struct mmsghdr mVec[maxMsgs];
+   int i, n, sent;
+
+// Send up to maxMsgs at a time. Should a message fail, report it and continue
+// with the next one as would happen were each message sent individually.
+//
+   while(msgcnt > 0)
+        {n = (msgcnt > maxMsgs ? maxMsgs : msgcnt);
+         memset(mVec, 0, sizeof(struct mmsghdr) * n);
+         for (i = 0; i < n; i++)
+             {mVec[i].msg_hdr.msg_name    = (void *)dfltDest.SockAddr();
+              mVec[i].msg_hdr.msg_namelen = dfltDest.SockSize();
+              mVec[i].msg_hdr.msg_iov     = (struct iovec *)&msgs[i];
+              mVec[i].msg_hdr.msg_iovlen  = 1;
+             }
+         do {sent = sendmmsg(FD, mVec, n, 0);}
+            while (sent < 0 && errno == EINTR);
+         if (sent <= 0)
+            {retc = retErr((sent < 0 ? errno : EAGAIN), &dfltDest);
+             sent = 1;
+            }
+         msgs += sent; msgcnt -= sent;
+        }
+#else
+   int rc;
+
+   for (int i = 0; i < msgcnt; i++)
+       {if ((rc = Send((const char *)msgs[i].iov_base, msgs[i].iov_len)))
+           retc = rc;
+       }
+#endif
+   return retc;
+}
+
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
@@ -110,6 +110,23 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
 //------------------------------------------------------------------------------
+//! Send several UDP messages to the default endpoint. Where supported, they
+//! are sent with as few system calls as possible.
+//!
+//! @param  msgs     The messages to send. Each element is one full message.
+//! @param  msgcnt   The number of elements in msgs.
+//! @param  tmo      maximum seconds to wait for a idle socket. When negative,
+//!                  the default, no time limit applies.
+//! @return <0       At least one message not sent due to error.
+//! @return =0       All messages sent (well as defined by UDP)
+//! @return >0       At least one message not sent, timeout occurred.
+//------------------------------------------------------------------------------
+
+int           SendMany(const struct iovec msgs[], // One message per element
+                             int    msgcnt,       // Number of elements in msgs
+                             int    tmo=-1);      // Timeout in ms (-1 = none)
+
+//------------------------------------------------------------------------------
 //! Constructor
 //!
 //! @param  erp      The error message object for routing error messages.
@@ -48,6 +48,7 @@
 #include "XrdCks/XrdCks.hh"
 #include "XrdCks/XrdCksConfig.hh"
 #include "XrdCks/XrdCksData.hh"
+#include "XrdCks/XrdCksManager.hh"
 
 #include "XrdNet/XrdNetAddr.hh"
 #include "XrdNet/XrdNetIF.hh"
@@ -793,6 +794,15 @@ int XrdOfsFile::close()  // In
 
   Output:   Returns SFS_OK upon success and SFS_ERROR upon failure.
 */
+{
+   return closeFile(true);
+}
+
+/******************************************************************************/
+/* Protected:                  c l o s e F i l e                              */
+/******************************************************************************/
+
+int XrdOfsFile::closeFile(bool doPosc)
 {
    EPNAME("close");
 
@@ -840,7 +850,7 @@ int XrdOfsFile::close()  // In
 // entry was via delete then we ignore the close return code as there is no
 // one to handle it on the other side.
 //
-   if ((poscNum = hP->PoscGet(theMode, !viaDel)))
+   if (doPosc && (poscNum = hP->PoscGet(theMode, !viaDel)))
       {if (viaDel)
           {if (hP->Inactive() || !XrdOfsFS->poscHold)
               {XrdOfsFS->Unpersist(hP, !hP->Inactive()); hP->Retire(cRetc);}
@@ -1777,6 +1787,9 @@ int XrdOfs::chksum(      csFunc            Func,   // In
                         csCalc   - Return precomputed or computed checksum.
                         csGet    - Return precomputed checksum.
                         csSize   - Verify csName and get its size.
+            csName    - Name of the checksum. For csCalc and csGet this may
+                        be a comma separated list of names, in which case
+                        the result holds "<name> <value>" for each one.
             Path      - Pathname of file for csCalc and csSize.
             einfo     - Error information object to hold error details.
             client    - Authentication credentials, if any.
@@ -1790,6 +1803,7 @@ int XrdOfs::chksum(      csFunc            Func,   // In
    XrdCksData cksData;
    const char *tident = einfo.getErrUser();
    char buff[MAXPATHLEN+8];
+   bool isList = index(csName, ',') != 0;
    int rc;
 
 // Check if we support checksumming
@@ -1800,9 +1814,10 @@ int XrdOfs::chksum(      csFunc            Func,   // In
       }
 
 // A csSize request is issued usually once to verify everything is working. We
-// take this opportunity to also verify the checksum name.
+// take this opportunity to also verify the checksum name. A list of names is
+// verified when it is split up.
 //
-   rc = cksData.Set(csName);
+   rc = (isList && Func != XrdSfsFileSystem::csSize ? 1 : cksData.Set(csName));
    if (!rc || Func == XrdSfsFileSystem::csSize)
       {if (rc && (rc = Cks->Size(csName)))
           {einfo.setErrCode(rc); return SFS_OK;}
@@ -1845,6 +1860,10 @@ int XrdOfs::chksum(      csFunc            Func,   // In
           else cksData.envP = (einfo.getEnv() ? einfo.getEnv() : &cksEnv);
       }
 
+// A list of checksums is handled elsewhere
+//
+   if (isList) return chksums(Func, csName, Path, einfo, cksData.envP);
+
 // Now determine what to do
 //
         if (Func == XrdSfsFileSystem::csCalc) rc = Cks->Calc(Path, cksData);
@@ -1871,6 +1890,81 @@ int XrdOfs::chksum(      csFunc            Func,   // In
    return Emsg(epname, einfo, rc, "checksum", Path);
 }
   
+/******************************************************************************/
+/*                               c h k s u m s                                */
+/******************************************************************************/
+
+// All of the checksums in the list are computed reading the file only once,
+// provided the checksum manager is ours (or derived from it). Otherwise, they
+// are computed one after the other.
+//
+int XrdOfs::chksums(csFunc Func, const char *csList, const char *Path,
+                    XrdOucErrInfo &einfo, XrdOucEnv *envP)
+{
+   EPNAME("chksum");
+   static const int maxNum = 8;
+   XrdCksManager *cksMan;
+   XrdCksData cksData[maxNum];
+   char buff[MAXPATHLEN+8], nBuff[256], *name, *lasts;
+   int csNum = 0, i, n, rc = 0;
+
+// Split the list into its names
+//
+   if (strlcpy(nBuff, csList, sizeof(nBuff)) >= sizeof(nBuff))
+      {einfo.setErrInfo(EINVAL, "checksum list too long.");
+       return SFS_ERROR;
+      }
+   name = strtok_r(nBuff, ",", &lasts);
+   while(name)
+        {if (csNum >= maxNum)
+            {einfo.setErrInfo(EINVAL, "too many checksums requested.");
+             return SFS_ERROR;
+            }
+         if (!cksData[csNum].Set(name) || !Cks->Size(name))
+            {snprintf(buff, sizeof(buff), "%s checksum not supported.", name);
+             einfo.setErrInfo(ENOTSUP, buff);
+             return SFS_ERROR;
+            }
+         cksData[csNum++].envP = envP;
+         name = strtok_r(0, ",", &lasts);
+        }
+
+// Now determine what to do
+//
+   if (Func == XrdSfsFileSystem::csCalc)
+      {if ((cksMan = dynamic_cast<XrdCksManager *>(Cks)))
+          rc = cksMan->Calc(Path, cksData, csNum);
+          else for (i = 0; i < csNum; i++)
+                   if ((rc = Cks->Calc(Path, cksData[i])) < 0) break;
+      } else {
+       for (i = 0; i < csNum; i++)
+           if ((rc = Cks->Get(Path, cksData[i])) < 0) break;
+      }
+
+// See if all went well. The result lists each name and its value.
+//
+#ifdef ENOATTR
+   if (rc >= 0 || rc == -ENOATTR || rc == -ESTALE || rc == -ESRCH)
+#else
+   if (rc >= 0 || rc == -ENODATA || rc == -ESTALE || rc == -ESRCH)
+#endif
+      {if (rc >= 0)
+          {for (i = 0, n = 0; i < csNum; i++)
+               {n += snprintf(buff+n, sizeof(buff)-n, "%s%s ",
+                              (i ? " " : ""), cksData[i].Name);
+                n += cksData[i].Get(buff+n, sizeof(buff)-n);
+               }
+           rc = 0;
+          } else {*buff = 0; rc = -rc;}
+       einfo.setErrInfo(rc, buff);
+       return SFS_OK;
+      }
+
+// We failed
+//
+   return Emsg(epname, einfo, rc, "checksum", Path);
+}
+
 /******************************************************************************/
 /*                                 c h m o d                                  */
 /******************************************************************************/
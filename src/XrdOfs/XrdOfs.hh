@@ -193,6 +193,11 @@ public:
 
 protected:
 
+// Close the file; when doPosc is false a persist-on-close file is left to be
+// persisted (or removed) by the close of the client that created it.
+//
+int            closeFile(bool doPosc);
+
 const char    *tident;
 XrdOfsHandle  *oh;
 XrdOfsTPC     *myTPC;
@@ -495,6 +500,8 @@ int ctlFASet(XrdSfsFACtl &faCtl, XrdOucEnv &faEnv, XrdOucErrInfo &einfo);
 
 // Common functions
 //
+int   chksums(csFunc Func, const char *csList, const char *Path,
+              XrdOucErrInfo &einfo, XrdOucEnv *envP);
 int   remove(const char type, const char *path, XrdOucErrInfo &out_error,
              const XrdSecEntity *client, const char *opaque);
 
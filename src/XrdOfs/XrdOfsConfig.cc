@@ -1605,6 +1605,7 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
                                          [streams <num>[,<max>]]
                                          [echo] [scan {stderr | stdout}]
                                          [autorm] [pgm <path> [parms]]
+                                         [lib <path> [parms]]
                                          [fcreds  [?]<auth> =<evar>]
                                          [fcpath <path>] [oids]
 
@@ -1635,6 +1636,9 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
                      default is to scan both.
              pgm     specifies the transfer command with optional paramaters.
                      It must be the last parameter on the line.
+             lib     specifies the in-process copy engine with optional
+                     parameters. Transfers that cannot be done in-process use
+                     the pgm. It must be the last parameter on the line.
              fcreds  Forward destination credentials for protocol <auth>. The
                      request fails if thee are no credentials for <auth>. If a
                      question mark preceeds <auth> then if the client has not
@@ -1699,6 +1703,22 @@ int XrdOfs::xtpc(XrdOucStream &Config, XrdSysError &Eroute)
              Parms.XfrProg = strdup( pgm );
              break;
             }
+         if (!strcmp(val, "lib"))
+            {if (!Config.GetRest(pgm, sizeof(pgm)))
+                {Eroute.Emsg("Config", "tpc lib parameters too long"); return 1;}
+             if (!*pgm)
+                {Eroute.Emsg("Config", "tpc lib not specified"); return 1;}
+             if (Parms.XfrLib) free(Parms.XfrLib);
+             if (Parms.XfrParms) {free(Parms.XfrParms); Parms.XfrParms = 0;}
+             char *parms = pgm;
+             while(*parms && *parms != ' ') parms++;
+             if (*parms) {*parms++ = 0;
+                          while(*parms == ' ') parms++;
+                          if (*parms) Parms.XfrParms = strdup(parms);
+                         }
+             Parms.XfrLib = strdup(pgm);
+             break;
+            }
          if (!strcmp(val, "require"))
             {if (!(val = Config.GetWord()))
                 {Eroute.Emsg("Config","tpc require parameter not specified"); return 1;}
@@ -244,9 +244,8 @@ extern XrdOfsStats OfsStats;
 /*                        S t a t i c   O b j e c t s                         */
 /******************************************************************************/
   
+XrdOfsHandle::HanShard XrdOfsHandle::hanShard[1 << XrdOfsHandle::hsBits];
 XrdSysMutex   XrdOfsHandle::myMutex;
-XrdOfsHanTab  XrdOfsHandle::roTable;
-XrdOfsHanTab  XrdOfsHandle::rwTable;
 XrdOssDF     *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
 XrdOfsHandle *XrdOfsHandle::Free = 0;
 
@@ -260,22 +259,24 @@ XrdOfsHandle *XrdOfsHandle::Free = 0;
 int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 {
    XrdOfsHandle *hP;
-   XrdOfsHanTab *theTable = (Opts & opRW ? &rwTable : &roTable);
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   HanShard     &theShard = Shard(theKey);
+   XrdOfsHanTab *theTable = (Opts & opRW ? &theShard.rwTable
+                                         : &theShard.roTable);
    int          retc;
 
 // Lock the search table and try to find the key. If found, increment the
-// the link count (can only be done with the global lock) then release the
+// the link count (can only be done with the shard lock) then release the
 // lock and try to lock the handle. It can't escape between lock calls because
 // the link count is positive. If we can't lock the handle then it must be the
 // that a long running operation is occuring. Return the handle to its former
 // state and return a delay. Otherwise, return the handle.
 //
-   myMutex.Lock();
+   theShard.Mutex.Lock();
    if ((hP = theTable->Find(theKey)))
-      {hP->Path.Links++; myMutex.UnLock();
+      {hP->Path.Links++; theShard.Mutex.UnLock();
        if (hP->WaitLock()) {*Handle = hP; return 0;}
-       myMutex.Lock(); hP->Path.Links--; myMutex.UnLock();
+       theShard.Mutex.Lock(); hP->Path.Links--; theShard.Mutex.UnLock();
        return nolokDelay;
       }
 
@@ -286,7 +287,7 @@ int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 
 // All done
 //
-   myMutex.UnLock();
+   theShard.Mutex.UnLock();
    return retc;
 }
 
@@ -299,10 +300,8 @@ int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
     XrdOfsHanKey myKey("dummy", 5);
     int retc;
 
-    myMutex.Lock();
     if (!(retc = Alloc(myKey, 0, Handle))) 
        {(*Handle)->Path.Links = 0; (*Handle)->UnLock();}
-    myMutex.UnLock();
     return retc;
 }
 
@@ -315,11 +314,14 @@ int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
    static const int minAlloc = 4096/sizeof(XrdOfsHandle);
    XrdOfsHandle *hP;
 
-// No handle currently in the table. Get a new one off the free list
+// No handle currently in the table. Get a new one off the free list. Handles
+// are never deleted, only placed back on this list.
 //
+   myMutex.Lock();
    if (!Free && (hP = new XrdOfsHandle[minAlloc]))
       {int i = minAlloc; while(i--) {hP->Next = Free; Free = hP; hP++;}}
    if ((hP = Free)) Free = hP->Next;
+   myMutex.UnLock();
 
 // Initialize the new handle, if we have one, and add it to the table
 //
@@ -347,14 +349,15 @@ void XrdOfsHandle::Hide(const char *thePath)
 {
    XrdOfsHandle *hP;
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   HanShard    &theShard = Shard(theKey);
 
 // Lock the search table and try to find the key in each table. If found,
 // clear the length field to effectively hide the item.
 //
-   myMutex.Lock();
-   if ((hP = roTable.Find(theKey))) hP->Path.Len = 0;
-   if ((hP = rwTable.Find(theKey))) hP->Path.Len = 0;
-   myMutex.UnLock();
+   theShard.Mutex.Lock();
+   if ((hP = theShard.roTable.Find(theKey))) hP->Path.Len = 0;
+   if ((hP = theShard.rwTable.Find(theKey))) hP->Path.Len = 0;
+   theShard.Mutex.UnLock();
 }
 
 /******************************************************************************/
@@ -373,7 +376,10 @@ int XrdOfsHandle::PoscGet(short &Mode, int Done)
        Mode = Posc->Mode;
        if (Done)
           {pP = Posc; Posc = 0;
-           if (pP->xprP) {myMutex.Lock(); Path.Links--; myMutex.UnLock();}
+           if (pP->xprP)
+              {HanShard &theShard = Shard(Path);
+               theShard.Mutex.Lock(); Path.Links--; theShard.Mutex.UnLock();
+              }
            pP->Recycle();
           }
        return pnum;
@@ -457,30 +463,33 @@ const char *XrdOfsHandle::PoscUsr()
 
 int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 {
+   HanShard &theShard = Shard(Path);
    XrdOssDF *mySSI;
    int numLeft;
 
-// Get the global lock as the links field can only be manipulated with it.
+// Get the shard lock as the links field can only be manipulated with it.
 // Decrement the links count and if zero, remove it from the table and
 // place it on the free list. Otherwise, it is still in use.
 //
    retc = 0;
-   myMutex.Lock();
+   theShard.Mutex.Lock();
    if (Path.Links == 1)
       {if (buff) strlcpy(buff, Path.Val, blen);
        numLeft = 0; OfsStats.Dec(OfsStats.Data.numHandles);
-       if ( (isRW ? rwTable.Remove(this) : roTable.Remove(this)) )
+       if ( (isRW ? theShard.rwTable.Remove(this)
+                  : theShard.roTable.Remove(this)) )
          {if (Posc) {Posc->Recycle(); Posc = 0;}
           if (Path.Val) {free((void *)Path.Val); Path.Val = (char *)"";}
           Path.Len = 0; mySSI = ssi; ssi = ossDF;
-          Next = Free; Free = this; UnLock(); myMutex.UnLock();
+          theShard.Mutex.UnLock();
+          myMutex.Lock(); Next = Free; Free = this; UnLock(); myMutex.UnLock();
           if (mySSI && mySSI != ossDF)
              {retc = mySSI->Close(retsz); delete mySSI;}
          } else {
-          UnLock(); myMutex.UnLock();
+          UnLock(); theShard.Mutex.UnLock();
           OfsEroute.Emsg("Retire", "Lost handle to", buff);
         }
-      } else {numLeft = --Path.Links; UnLock(); myMutex.UnLock();}
+      } else {numLeft = --Path.Links; UnLock(); theShard.Mutex.UnLock();}
    return numLeft;
 }
 
@@ -489,20 +498,21 @@ int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 int XrdOfsHandle::Retire(XrdOfsHanCB *cbP, int hTime)
 {
    static int allOK = StartXpr(1);
+   HanShard &theShard = Shard(Path);
    XrdOfsHanXpr *xP;
    int retc;
 
 // The handle can only be held by one reference and only if it's a POSC and
 // deferred handling was properly set up.
 //
-   myMutex.Lock();
+   theShard.Mutex.Lock();
    if (!Posc || !allOK)
       {OfsEroute.Emsg("Retire", "ignoring deferred retire of", Path.Val);
-       if (Path.Links != 1 || !Posc || !cbP) myMutex.UnLock();
-          else {myMutex.UnLock(); cbP->Retired(this);}
+       if (Path.Links != 1 || !Posc || !cbP) theShard.Mutex.UnLock();
+          else {theShard.Mutex.UnLock(); cbP->Retired(this);}
        return Retire(retc);
       }
-   myMutex.UnLock();
+   theShard.Mutex.UnLock();
 
 // If this object already has an xpr object (happens for bouncing connections)
 // then reuse that object. Otherwise create a new one and put it on the queue.
@@ -554,16 +564,18 @@ do{xP = XrdOfsHanXpr::Get(); hP = xP->Handle;
             hP->UnLock(); delete xP; continue;
            }
 
-// As the handle is locked we can get the global handle lock to prevent
-// additions and removals of handles as we need a stable reference count to
-// effect the callout, if any. Do so only if the reference count is one (for us)
-// and the handle is active. In all cases, drop the global lock.
+// As the handle is locked we can get its shard lock to prevent additions and
+// removals of references as we need a stable reference count to effect the
+// callout, if any. Do so only if the reference count is one (for us) and the
+// handle is active. In all cases, drop the shard lock.
 //
-   myMutex.Lock();
-   if (hP->Path.Links != 1 || !xP->Call) myMutex.UnLock();
-      else {myMutex.UnLock();
+  {HanShard &theShard = Shard(hP->Path);
+   theShard.Mutex.Lock();
+   if (hP->Path.Links != 1 || !xP->Call) theShard.Mutex.UnLock();
+      else {theShard.Mutex.UnLock();
             xP->Call->Retired(hP);
            }
+  }
 
 // We can now officially retire the handle and delete the xpr object
 //
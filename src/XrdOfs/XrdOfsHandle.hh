@@ -182,9 +182,24 @@ static const int     LockWait  = 333; // Mills to wait between tries
 static const int     nolokDelay=   3; // Secs to delay client when lock failed
 static const int     nomemDelay=  15; // Secs to delay client when ENOMEM
 
-static XrdSysMutex   myMutex;
-static XrdOfsHanTab  roTable;    // File handles open r/o
-static XrdOfsHanTab  rwTable;    // File Handles open r/w
+// Handles are spread across shards by path hash so that opens and closes of
+// different files do not contend for a single lock. A shard's mutex guards
+// its tables as well as the link count of every handle in them.
+//
+struct HanShard
+      {XrdSysMutex   Mutex;
+       XrdOfsHanTab  roTable;    // File handles open r/o
+       XrdOfsHanTab  rwTable;    // File Handles open r/w
+                     HanShard() : roTable(89, 144), rwTable(89, 144) {}
+      };
+
+static const int     hsBits = 5;  // Number of shards is 2**hsBits
+
+static HanShard     &Shard(const XrdOfsHanKey &Key)
+                          {return hanShard[Key.Hash >> (32-hsBits)];}
+
+static HanShard      hanShard[1 << hsBits];
+static XrdSysMutex   myMutex;    // Guards the free list
 static XrdOssDF     *ossDF;      // Dummy storage sysem
 static XrdOfsHandle *Free;       // List of free handles
 
@@ -0,0 +1,477 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O f s T P C C l . c c                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+/* This is the in-process copy engine for the ofs third party copy. It is
+   loaded via "ofs.tpc lib libXrdOfsTPCCl.so [parms]" where parms are:
+
+   [chunks <n>] [chunksize <sz>] [maxrate <rate>]
+
+   chunks    the number of chunks per stream read ahead from the source while
+             earlier chunks are being written (default 8).
+   chunksize the size of each chunk (default 8m).
+   maxrate   the aggregate bytes per second allowed across all concurrent
+             in-process transfers. Every read from a source draws from one
+             shared token bucket (default is no limit).
+
+   The number of concurrent transfers is governed by "ofs.tpc xfr". Data is
+   written through the destination file opened by the ofs, so it passes the
+   same ofs and oss layers as a client write. The streams requested for a
+   transfer apply to that transfer alone: each stream adds its own set of
+   chunks to the reads kept in flight. The number of substreams of the
+   connection to the source host is left to the client configuration as it is
+   shared by every transfer from that host. The source is read via xroots
+   whenever the source or the client's connection to us used xroots.
+*/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdCl/XrdClCheckSumHelper.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClFile.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+#include "XrdCl/XrdClPostMasterInterfaces.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdCl/XrdClUtils.hh"
+#include "XrdOfs/XrdOfsTPCCopy.hh"
+#include "XrdOuc/XrdOuca2x.hh"
+#include "XrdOuc/XrdOucTokenizer.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+#include "XrdVersion.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+/******************************************************************************/
+/*                         R a t e L i m i t e r                              */
+/******************************************************************************/
+
+// The rate limiter is a token bucket shared by all transfers. Each read takes
+// its size in tokens before it is issued; when the bucket is empty the
+// caller sleeps until the tokens it took have accrued. Since tokens are taken
+// in arrival order the configured rate is shared amongst active transfers.
+//
+class RateLimiter
+{
+public:
+
+bool      Acquire(long long bytes, std::atomic<bool> &cancel)
+                 {if (!maxRate) return true;
+                  long long waitUS;
+                  rMutex.Lock();
+                  Refill();
+                  tokens -= bytes;
+                  waitUS  = (tokens < 0 ? (-tokens * 1000000) / maxRate : 0);
+                  rMutex.UnLock();
+                  while(waitUS > 0)
+                       {if (cancel) return false;
+                        long long ms = (waitUS > 100000 ? 100 : waitUS/1000+1);
+                        XrdSysTimer::Wait(static_cast<int>(ms));
+                        waitUS -= ms*1000;
+                       }
+                  return !cancel;
+                 }
+
+          RateLimiter(long long rate) : maxRate(rate), tokens(rate)
+                     {lastT = Now();}
+         ~RateLimiter() {}
+
+private:
+
+static long long Now()
+                 {struct timespec ts;
+                  clock_gettime(CLOCK_MONOTONIC, &ts);
+                  return ts.tv_sec*1000000LL + ts.tv_nsec/1000;
+                 }
+
+void      Refill() // Mutex must be held
+                 {long long nowT = Now(), addT = nowT - lastT;
+                  if (addT <= 0) return;
+                  tokens += addT * maxRate / 1000000;
+                  if (tokens > maxRate) tokens = maxRate; // One second burst
+                  lastT = nowT;
+                 }
+
+XrdSysMutex rMutex;
+long long   maxRate;
+long long   tokens;
+long long   lastT;
+};
+
+/******************************************************************************/
+/*                                 C h u n k                                  */
+/******************************************************************************/
+
+// A chunk is one outstanding read from the source. The reply is posted to the
+// condition variable shared by all of the chunks of a transfer.
+//
+class Chunk : public XrdCl::ResponseHandler
+{
+public:
+
+void HandleResponse(XrdCl::XRootDStatus *st, XrdCl::AnyObject *rsp) override
+                   {XrdCl::ChunkInfo *info = 0;
+                    if (rsp) rsp->Get(info);
+                    xCond.Lock();
+                    status = *st;
+                    rdLen  = (st->IsOK() && info ? info->length : 0);
+                    isDone = true;
+                    xCond.Signal();
+                    xCond.UnLock();
+                    delete st;
+                    delete rsp;
+                   }
+
+std::vector<char>   buff;
+uint64_t            offset;
+uint32_t            length;
+uint32_t            rdLen;
+XrdCl::XRootDStatus status;
+bool                isDone;
+bool                inUse;
+
+     Chunk(XrdSysCondVar &cv, int csize)
+          : buff(csize), offset(0), length(0), rdLen(0), isDone(false),
+            inUse(false), xCond(cv) {}
+    ~Chunk() {}
+
+private:
+
+XrdSysCondVar &xCond;
+};
+
+/******************************************************************************/
+/*                          X r d O f s T P C C l                             */
+/******************************************************************************/
+
+class XrdOfsTPCCl : public XrdOfsTPCCopy
+{
+public:
+
+int  Copy(const Args &args, Result &result, std::atomic<bool> &cancel) override;
+
+     XrdOfsTPCCl(XrdSysError *eP, int chunks, int csize, long long rate)
+                : eDest(eP), limiter(rate), pChunks(chunks), cSize(csize) {}
+
+    ~XrdOfsTPCCl() {}
+
+private:
+
+int  Fail(Result &result, int rc, const char *what, const char *why);
+int  Fail(Result &result, const XrdCl::XRootDStatus &st, const char *what);
+bool IpStack(XrdCl::File &srcFile);
+
+XrdSysError *eDest;
+RateLimiter  limiter;
+int          pChunks;
+int          cSize;
+};
+
+/******************************************************************************/
+/*                                  C o p y                                   */
+/******************************************************************************/
+
+int XrdOfsTPCCl::Copy(const Args &args, Result &result,
+                      std::atomic<bool> &cancel)
+{
+   XrdCl::File         srcFile;
+   XrdCl::StatInfo    *sInfo = 0;
+   XrdCl::XRootDStatus st;
+   XrdSysCondVar       xCond(0);
+   std::string         cksType, cksVal;
+   std::unique_ptr<XrdCl::CheckSumHelper> cksHelp;
+   long long           fSize;
+   uint64_t            nextOff = 0;
+   int                 nStrm = (args.streams > 0 ? args.streams : 1), rc = 0;
+
+// Reading via xroots is required if either the source was specified with it or
+// the client reached us with it.
+//
+   XrdCl::URL srcURL(args.srcURL);
+   if ((args.sProt && !strcmp(args.sProt, "xroots"))
+   ||  (args.tProt && !strcmp(args.tProt, "xroots")))
+      srcURL.SetProtocol("xroots");
+
+// Set checksum processing, the argument is "<type>[:<value>]"
+//
+   if (args.cksType && *args.cksType)
+      {cksType = args.cksType;
+       std::string::size_type colon = cksType.find(':');
+       if (colon != std::string::npos)
+          {cksVal = cksType.substr(colon+1);
+           cksType.erase(colon);
+          }
+       if (cksVal == "print") cksVal.clear();
+       cksHelp.reset(new XrdCl::CheckSumHelper(args.dstLfn, cksType));
+       if (!(st = cksHelp->Initialize()).IsOK())
+          return Fail(result, st, "initialize checksum");
+      }
+
+// Open the source file
+//
+   if (!(st = srcFile.Open(srcURL.GetURL(), XrdCl::OpenFlags::Read)).IsOK())
+      return Fail(result, st, "open source");
+   result.isIPv4 = IpStack(srcFile);
+
+// Get the size of the source file
+//
+   if (!(st = srcFile.Stat(false, sInfo)).IsOK() || !sInfo)
+      {XrdCl::XRootDStatus cst = srcFile.Close();
+       return Fail(result, st, "stat source");
+      }
+   fSize = static_cast<long long>(sInfo->GetSize());
+   delete sInfo;
+
+// Allocate the read-ahead window; each stream gets its own set of chunks
+//
+   int nChunks = pChunks * nStrm;
+   if (fSize < static_cast<long long>(nChunks) * cSize)
+      nChunks = static_cast<int>((fSize + cSize - 1) / cSize);
+   std::vector<std::unique_ptr<Chunk> > window;
+   for (int i = 0; i < nChunks; i++)
+       window.emplace_back(new Chunk(xCond, cSize));
+
+// Start a read into each chunk, the rate limiter paces how fast reads go out
+//
+   auto Issue = [&](Chunk &ck) -> bool
+              {if (nextOff >= static_cast<uint64_t>(fSize)) return true;
+               uint64_t left = static_cast<uint64_t>(fSize) - nextOff;
+               ck.offset = nextOff;
+               ck.length = static_cast<uint32_t>(
+                           left < static_cast<uint64_t>(cSize) ? left : cSize);
+               if (!limiter.Acquire(ck.length, cancel)) return false;
+               ck.isDone = false;
+               ck.inUse  = true;
+               st = srcFile.Read(ck.offset, ck.length, ck.buff.data(), &ck);
+               if (!st.IsOK()) {ck.inUse = false; return false;}
+               nextOff += ck.length;
+               return true;
+              };
+
+   for (int i = 0; i < nChunks && !rc; i++)
+       if (!Issue(*window[i])) rc = (cancel ? ECANCELED : -1);
+
+// Write completed chunks in order. Each written chunk is reused for the next
+// read. We stop at the first error or when we are cancelled.
+//
+   for (int i = 0; !rc && window.size(); i = (i+1) % nChunks)
+       {Chunk &ck = *window[i];
+        if (!ck.inUse) break;
+        xCond.Lock();
+        while(!ck.isDone) xCond.Wait();
+        xCond.UnLock();
+        ck.inUse = false;
+        if (cancel) {rc = ECANCELED; break;}
+        if (!ck.status.IsOK()) {st = ck.status; rc = -1; break;}
+        if (ck.rdLen != ck.length)
+           {rc = Fail(result, EIO, "read source", "unexpected end of file");
+            break;
+           }
+        XrdSfsXferSize wlen = args.dstFile->write(ck.offset, ck.buff.data(),
+                                                  ck.rdLen);
+        if (wlen != static_cast<XrdSfsXferSize>(ck.rdLen))
+           {rc = args.dstFile->error.getErrInfo();
+            rc = Fail(result, (rc > 0 ? rc : EIO), "write destination",
+                      (wlen < 0 ? args.dstFile->error.getErrText()
+                                : "short write"));
+            break;
+           }
+        if (cksHelp) cksHelp->Update(ck.buff.data(), ck.rdLen);
+        result.bytes += ck.rdLen;
+        if (!Issue(ck)) rc = (cancel ? ECANCELED : -1);
+       }
+
+// Wait for any reads still in flight as they refer to our buffers
+//
+   xCond.Lock();
+   for (auto &ck : window) while(ck->inUse && !ck->isDone) xCond.Wait();
+   xCond.UnLock();
+   XrdCl::XRootDStatus cst = srcFile.Close();
+
+// Handle any errors
+//
+   if (rc == ECANCELED)
+      return Fail(result, ECANCELED, "copy", "transfer cancelled");
+   if (rc < 0) return Fail(result, st, "read source");
+   if (rc) return rc;
+
+// Set the final size of the destination
+//
+   if (args.dstFile->truncate(fSize))
+      {rc = args.dstFile->error.getErrInfo();
+       return Fail(result, (rc > 0 ? rc : EIO), "truncate destination",
+                   args.dstFile->error.getErrText());
+      }
+
+// Verify the checksum of the data we received against the specified value or,
+// lacking that, the checksum of the source file.
+//
+   if (cksHelp)
+      {std::string ourCks, srcCks;
+       if (!(st = cksHelp->GetCheckSum(ourCks, cksType)).IsOK())
+          return Fail(result, st, "calculate checksum");
+       if (cksVal.size())
+          srcCks = cksType + ":" + XrdCl::Utils::NormalizeChecksum(cksType,
+                                                                  cksVal);
+          else if (!(st = XrdCl::Utils::GetRemoteCheckSum(srcCks, cksType,
+                                                          srcURL)).IsOK())
+                  return Fail(result, st, "get source checksum");
+       if (ourCks != srcCks)
+          {std::string why = "checksum mismatch; source " + srcCks
+                           + " target " + ourCks;
+           return Fail(result, EIO, "verify checksum", why.c_str());
+          }
+      }
+
+// All done
+//
+   return 0;
+}
+
+/******************************************************************************/
+/* Private:                         F a i l                                   */
+/******************************************************************************/
+
+int XrdOfsTPCCl::Fail(Result &result, int rc, const char *what,
+                      const char *why)
+{
+   std::string msg = std::string("Unable to ") + what + "; " + why;
+
+   snprintf(result.eText, sizeof(result.eText), "%s", msg.c_str());
+   return rc;
+}
+
+/******************************************************************************/
+
+int XrdOfsTPCCl::Fail(Result &result, const XrdCl::XRootDStatus &st,
+                      const char *what)
+{
+   int rc;
+
+   if (st.code == XrdCl::errErrorResponse) rc = XProtocol::toErrno(st.errNo);
+      else rc = (st.errNo ? static_cast<int>(st.errNo) : EIO);
+   return Fail(result, rc, what, st.ToStr().c_str());
+}
+
+/******************************************************************************/
+/* Private:                      I p S t a c k                                */
+/******************************************************************************/
+
+bool XrdOfsTPCCl::IpStack(XrdCl::File &srcFile)
+{
+   XrdCl::AnyObject obj;
+   std::string *ipstack = 0, dataServer;
+   bool isIPv4 = false;
+
+// Ask the transport how we reached the server actually serving the data
+//
+   if (!srcFile.GetProperty("DataServer", dataServer)) return false;
+   if (!XrdCl::DefaultEnv::GetPostMaster()->QueryTransport(
+        XrdCl::URL(dataServer), XrdCl::StreamQuery::IpStack, obj).IsOK())
+      return false;
+   obj.Get(ipstack);
+   if (ipstack) {isIPv4 = (*ipstack == "IPv4"); delete ipstack;}
+   return isIPv4;
+}
+
+}
+
+/******************************************************************************/
+/*                   X r d O f s T P C C o p y O b j e c t                    */
+/******************************************************************************/
+
+extern "C"
+{
+XrdOfsTPCCopy *XrdOfsTPCCopyObject(XrdSysError *eDest,
+                                   const char  *parms,
+                                   int          xfrMax)
+{
+   long long maxRate = 0, cSize = 8*1024*1024;
+   int chunks = 8;
+   char *tokP;
+   bool isBad = false;
+
+// Parse the parameters, if any
+//
+   if (parms && *parms)
+      {char *pBuff = strdup(parms);
+       XrdOucTokenizer pTok(pBuff);
+       pTok.GetLine();
+       while((tokP = pTok.GetToken()))
+            {if (!strcmp(tokP, "chunks"))
+                {if (!(tokP = pTok.GetToken())
+                 ||  XrdOuca2x::a2i(*eDest, "tpc lib chunks", tokP,
+                                    &chunks, 1, 255)) {isBad = true; break;}
+                }
+             else if (!strcmp(tokP, "chunksize"))
+                {if (!(tokP = pTok.GetToken())
+                 ||  XrdOuca2x::a2sz(*eDest, "tpc lib chunksize", tokP,
+                                     &cSize, 4096, 0x40000000)) {isBad = true; break;}
+                }
+             else if (!strcmp(tokP, "maxrate"))
+                {if (!(tokP = pTok.GetToken())
+                 ||  XrdOuca2x::a2sz(*eDest, "tpc lib maxrate", tokP,
+                                     &maxRate, 1)) {isBad = true; break;}
+                }
+             else {eDest->Emsg("TPC", "invalid tpc lib parameter -", tokP);
+                   isBad = true; break;
+                  }
+            }
+       free(pBuff);
+       if (isBad)
+          {eDest->Emsg("TPC", "tpc lib parameters invalid or incomplete.");
+           return 0;
+          }
+      }
+
+// Indicate what we will be doing
+//
+   char buff[256];
+   snprintf(buff, sizeof(buff), "%d transfers using %d chunks of %lld bytes",
+            xfrMax, chunks, cSize);
+   eDest->Say("Config tpc in-process copy allows ", buff,
+              (maxRate ? " with a rate limit." : "."));
+
+// Return the copy engine
+//
+   return new XrdOfsTPCCl(eDest, chunks, static_cast<int>(cSize), maxRate);
+}
+}
+
+XrdVERSIONINFO(XrdOfsTPCCopyObject,XrdOfsTPCCl);
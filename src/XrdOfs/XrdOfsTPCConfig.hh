@@ -37,6 +37,8 @@ struct XrdOfsTPCConfig
 XrdXrootdTpcMon* tpcMon;
 
 char  *XfrProg;
+char  *XfrLib;
+char  *XfrParms;
 char  *cksType;
 char  *cPath;
 char  *rPath;
@@ -52,7 +54,8 @@ bool   autoRM;
 bool   noids;
 bool   fCreds;
 
-       XrdOfsTPCConfig() : tpcMon(0), XfrProg(0), cksType(0), cPath(0), rPath(0),
+       XrdOfsTPCConfig() : tpcMon(0), XfrProg(0), XfrLib(0),
+                           XfrParms(0), cksType(0), cPath(0), rPath(0),
                            maxTTL(15), dflTTL(7),  tcpSTRM(0),   tcpSMax(15),
                            xfrMax(9),  errMon(-3), LogOK(false), doEcho(false),
                            autoRM(false), noids(true), fCreds(false)
@@ -0,0 +1,112 @@
+#ifndef __XRDOFSTPCCOPY_HH__
+#define __XRDOFSTPCCOPY_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O f s T P C C o p y . h h                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+//! The XrdOfsTPCCopy class defines an in-process copy engine that may be used
+//! by the ofs third party copy instead of running the copy program for each
+//! transfer (see "ofs.tpc lib"). The engine is called on the thread that
+//! would have otherwise waited for the copy program to end. Transfers that
+//! need a per-process environment (i.e. forwarded credentials or a reproxy
+//! target) are always handed to the copy program. The destination is opened
+//! by the ofs and handed to the engine so that all data is written through
+//! the ofs and oss layers just as a client write would be.
+//-----------------------------------------------------------------------------
+
+class XrdSfsFile;
+
+class XrdOfsTPCCopy
+{
+public:
+
+struct Args
+{
+const char *srcURL;  //!< Source URL including the tpc rendezvous cgi
+const char *dstLfn;  //!< Logical path of the destination file
+XrdSfsFile *dstFile; //!< The open destination file to be written
+const char *cksType; //!< Checksum as "type[:value]" to verify or nil
+const char *tident;  //!< Trace identifier of the original issuer
+const char *sProt;   //!< Protocol the source was specified with or nil
+const char *tProt;   //!< Protocol the client used to reach us or nil
+int         streams; //!< Number of streams requested (0 -> default)
+};
+
+struct Result
+{
+long long   bytes;   //!< Number of bytes copied
+bool        isIPv4;  //!< True if the source was reached via IPv4
+char        eText[1024]; //!< Reason for failure, if any
+};
+
+//-----------------------------------------------------------------------------
+//! Copy a file.
+//!
+//! @param  args   - Reference to the copy arguments.
+//! @param  result - Reference to where the result is to be placed.
+//! @param  cancel - Reference to a flag that is set when the copy is to be
+//!                  cancelled. It should be checked periodically.
+//!
+//! @return 0 upon success and a positive errno value upon failure.
+//-----------------------------------------------------------------------------
+
+virtual int  Copy(const Args &args, Result &result,
+                  std::atomic<bool> &cancel) = 0;
+
+             XrdOfsTPCCopy() {}
+virtual     ~XrdOfsTPCCopy() {}
+};
+
+/******************************************************************************/
+/*                   X r d O f s T P C C o p y O b j e c t                    */
+/******************************************************************************/
+
+//-----------------------------------------------------------------------------
+//! Obtain an instance of the copy engine. This extern "C" function must be
+//! defined in the shared library specified by "ofs.tpc lib".
+//!
+//! @param  eDest  - Pointer to the error message object.
+//! @param  parms  - Pointer to the parameters specified after the library
+//!                  path or nil if there are none.
+//! @param  xfrMax - The maximum number of concurrent transfers ("ofs.tpc xfr").
+//!
+//! @return Pointer to the copy engine or nil upon failure.
+//-----------------------------------------------------------------------------
+
+class XrdSysError;
+
+typedef XrdOfsTPCCopy *(*XrdOfsTPCCopyObject_t)(XrdSysError *eDest,
+                                                const char  *parms,
+                                                int          xfrMax);
+
+/*! extern "C" XrdOfsTPCCopy *XrdOfsTPCCopyObject(XrdSysError *eDest,
+                                                  const char  *parms,
+                                                  int          xfrMax);
+*/
+#endif
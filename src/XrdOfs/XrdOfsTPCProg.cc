@@ -34,17 +34,21 @@
 #include <sys/stat.h>
   
 #include "XrdNet/XrdNetIdentity.hh"
+#include "XrdOfs/XrdOfs.hh"
 #include "XrdOfs/XrdOfsTPC.hh"
 #include "XrdOfs/XrdOfsTPCConfig.hh"
+#include "XrdOfs/XrdOfsTPCCopy.hh"
 #include "XrdOfs/XrdOfsTPCJob.hh"
 #include "XrdOfs/XrdOfsTPCProg.hh"
 #include "XrdOfs/XrdOfsTrace.hh"
 #include "XrdOss/XrdOss.hh"
 #include "XrdOuc/XrdOucCallBack.hh"
+#include "XrdOuc/XrdOucPinLoader.hh"
 #include "XrdOuc/XrdOucProg.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysHeaders.hh"
+#include "XrdVersion.hh"
 
 #include "XrdXrootd/XrdXrootdTpcMon.hh"
 
@@ -56,6 +60,8 @@ extern XrdSysError  OfsEroute;
 extern XrdSysTrace  OfsTrace;
 extern XrdOss      *XrdOfsOss;
 
+XrdVERSIONINFOREF(XrdOfs);
+
 namespace XrdOfsTPCParms
 {
 extern XrdOfsTPCConfig Cfg;
@@ -69,6 +75,7 @@ using namespace XrdOfsTPCParms;
   
 XrdSysMutex        XrdOfsTPCProg::pgmMutex;
 XrdOfsTPCProg     *XrdOfsTPCProg::pgmIdle  = 0;
+XrdOfsTPCCopy     *XrdOfsTPCProg::xfrEngine= 0;
 
 /******************************************************************************/
 /*                     E x t e r n a l   L i n k a g e s                      */
@@ -113,6 +120,24 @@ static int         cSeq;
 
 XrdSysMutex credFile::csMutex;
 int         credFile::cSeq = 0;
+
+// The destination file of an in-process copy is opened through the ofs and
+// attaches to the handle of the client's open. It is closed without any
+// persist-on-close processing as that belongs to the client's close.
+//
+class tpcFile : public XrdOfsFile
+{
+public:
+
+int  Close() {return closeFile(false);}
+
+     tpcFile(const char *user) : XrdOfsFile(myEInfo, user), myEInfo(user) {}
+
+    ~tpcFile() {}
+
+private:
+XrdOucErrInfo myEInfo; // Accessible only by reference error
+};
 }
   
 /******************************************************************************/
@@ -122,7 +147,7 @@ int         credFile::cSeq = 0;
 XrdOfsTPCProg::XrdOfsTPCProg(XrdOfsTPCProg *Prev, int num, int errMon)
              : Prog(&OfsEroute, errMon),
                JobStream(&OfsEroute),
-               Next(Prev), Job(0)
+               Next(Prev), Job(0), xfrBytes(-1), xfrCancel(false)
              {snprintf(Pname, sizeof(Pname), "TPC job %d: ", num);
               Pname[sizeof(Pname)-1] = 0;
              }
@@ -175,6 +200,17 @@ int XrdOfsTPCProg::Init()
         if (pgmIdle->Prog.Setup(Cfg.XfrProg, &OfsEroute)) return 0;
        }
 
+// Load the in-process copy engine if one was specified
+//
+   if (Cfg.XfrLib)
+      {XrdOucPinLoader myLib(&OfsEroute, &XrdVERSIONINFOVAR(XrdOfs),
+                             "ofs.tpc", Cfg.XfrLib);
+       XrdOfsTPCCopyObject_t ep = (XrdOfsTPCCopyObject_t)
+                                  (myLib.Resolve("XrdOfsTPCCopyObject"));
+       if (!ep || !(xfrEngine = ep(&OfsEroute, Cfg.XfrParms, Cfg.xfrMax)))
+          return 0;
+      }
+
 // All done
 //
    Cfg.doEcho = Cfg.doEcho || GTRACE(debug);
@@ -203,6 +239,7 @@ do{if (doMon)
        gettimeofday(&monInfo.begT, 0);
       }
 
+   xfrBytes = -1;
    rc = Xeq(isIPv4);
 
    if (doMon)
@@ -226,7 +263,9 @@ do{if (doMon)
        monInfo.clID = clID;
 
        if ((questDst = index(Job->Info.Dst, '?'))) *questDst = 0;
-       if (!XrdOfsOss->Stat(Job->Info.Dst, &Stat)) monInfo.fSize = Stat.st_size;
+       if (xfrBytes >= 0) monInfo.fSize = xfrBytes;
+          else if (!XrdOfsOss->Stat(Job->Info.Dst, &Stat))
+                  monInfo.fSize = Stat.st_size;
        if (questDst) *questDst = '?';
        Cfg.tpcMon->Report(monInfo);
        if (questLfn) *questLfn = '?';
@@ -234,6 +273,7 @@ do{if (doMon)
       }
 
    Job = Job->Done(this, eRec, rc);
+   xfrCancel = false;
 
   } while(Job);
 
@@ -260,6 +300,7 @@ XrdOfsTPCProg *XrdOfsTPCProg::Start(XrdOfsTPCJob *jP, int &rc)
 //
    if (!(pgmP = pgmIdle)) {rc = 0; return 0;}
    pgmP->Job = jP;
+   pgmP->xfrCancel = false;
 
 // Start a thread to run the job
 //
@@ -293,6 +334,10 @@ int XrdOfsTPCProg::Xeq(bool &isIPv4)
        return rc;
       }
 
+// Use the in-process copy engine unless the copy needs its own environment
+//
+   if (xfrEngine && !cFile.Path && !Job->Info.Rpx) return XeqLib(isIPv4);
+
 // Echo out what we are doing if so desired
 //
    if (Cfg.doEcho)
@@ -402,3 +447,79 @@ int XrdOfsTPCProg::Xeq(bool &isIPv4)
 //
    return rc;
 }
+
+/******************************************************************************/
+/* Private:                       X e q L i b                                 */
+/******************************************************************************/
+
+int XrdOfsTPCProg::XeqLib(bool &isIPv4)
+{
+   EPNAME("XeqLib");
+   XrdOfsTPCCopy::Args   cpArgs;
+   XrdOfsTPCCopy::Result cpResult;
+   char *Quest = index(Job->Info.Key, '?'), *tident = Job->Info.Org;
+   int rc;
+
+// Echo out what we are doing if so desired
+//
+   if (Cfg.doEcho)
+      {if (Quest) *Quest = 0;
+       OfsEroute.Say(Pname, tident, " copying ", Job->Info.Key,
+                     " in-process to ", Job->Info.Dst);
+       if (Quest) *Quest = '?';
+      }
+
+// Open the destination so that the copy writes through the ofs and oss layers
+//
+   tpcFile dstFile(tident);
+   if (dstFile.open(Job->Info.Lfn, SFS_O_RDWR, 0, 0) != SFS_OK)
+      {rc = dstFile.error.getErrInfo();
+       snprintf(eRec, sizeof(eRec), "Copy failed; unable to open "
+                "destination; %.960s", dstFile.error.getErrText());
+       OfsEroute.Emsg("TPC", Job->Info.Org, Job->Info.Lfn, eRec);
+       isIPv4 = false;
+       return (rc > 0 ? rc : EIO);
+      }
+
+// Fill out the arguments
+//
+   cpArgs.srcURL  = Job->Info.Key;
+   cpArgs.dstLfn  = Job->Info.Lfn;
+   cpArgs.dstFile = &dstFile;
+   cpArgs.cksType = (Job->Info.Cks ? Job->Info.Cks : Cfg.cksType);
+   cpArgs.tident  = tident;
+   cpArgs.sProt   = Job->Info.Spr;
+   cpArgs.tProt   = Job->Info.Tpr;
+   cpArgs.streams = Job->Info.Str;
+
+// Run the copy and close the destination
+//
+   cpResult.bytes  = 0;
+   cpResult.isIPv4 = false;
+  *cpResult.eText  = 0;
+   rc = xfrEngine->Copy(cpArgs, cpResult, xfrCancel);
+   if (dstFile.Close() != SFS_OK && !rc)
+      {rc = dstFile.error.getErrInfo();
+       if (rc <= 0) rc = EIO;
+       snprintf(cpResult.eText, sizeof(cpResult.eText),
+                "Unable to close destination; %.960s", dstFile.error.getErrText());
+      }
+   DEBUG(Pname <<"ended with rc=" <<rc);
+
+// Return the results
+//
+   isIPv4   = cpResult.isIPv4;
+   xfrBytes = cpResult.bytes;
+   if (rc)
+      {if (*cpResult.eText)
+          {strncpy(eRec, cpResult.eText, sizeof(eRec)-1);
+           eRec[sizeof(eRec)-1] = 0;
+          } else sprintf(eRec, "Copy failed with return code %d", rc);
+       OfsEroute.Emsg("TPC", Job->Info.Org, Job->Info.Lfn, eRec);
+       if (Cfg.autoRM) XrdOfsOss->Unlink(Job->Info.Lfn);
+      } else {*eRec = 0; Job->Info.Success();}
+
+// All done
+//
+   return rc;
+}
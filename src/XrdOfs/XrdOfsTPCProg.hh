@@ -30,10 +30,13 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
+
 #include "XrdOuc/XrdOucProg.hh"
 #include "XrdOuc/XrdOucStream.hh"
 #include "XrdSys/XrdSysPthread.hh"
   
+class XrdOfsTPCCopy;
 class XrdOfsTPCJob;
 class XrdOucProg;
   
@@ -41,7 +44,7 @@ class XrdOfsTPCProg
 {
 public:
 
-       void      Cancel() {JobStream.Drain();}
+       void      Cancel() {xfrCancel = true; JobStream.Drain();}
 
 static int       Init();
 
@@ -57,13 +60,17 @@ XrdOfsTPCProg   *Start(XrdOfsTPCJob *jP, int &rc);
                 ~XrdOfsTPCProg() {}
 private:
        int            ExportCreds(const char *path);
+       int            XeqLib(bool &isIPv4);
 static XrdSysMutex    pgmMutex;
 static XrdOfsTPCProg *pgmIdle;
+static XrdOfsTPCCopy *xfrEngine;
 
        XrdOucProg     Prog;
        XrdOucStream   JobStream;
        XrdOfsTPCProg *Next;
        XrdOfsTPCJob  *Job;
+       long long      xfrBytes;
+std::atomic<bool>     xfrCancel;
        char           Pname[32];
        char           eRec[1024];
 };
@@ -771,6 +771,8 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
                    {close(fd); fd=-ETXTBSY;}
                 FSize = -1; cacheP = 0;
                }
+       if (fd >= 0 && XrdOssCache::ioTrack)
+          ioFSD = XrdOssCache::FindFS(buf.st_dev);
       } else if (fd == -EEXIST)
                 {do {retc = stat(local_path,&buf);} while(retc && errno==EINTR);
                  if (!retc && (buf.st_mode & S_IFDIR)) fd = -EISDIR;
@@ -826,7 +828,7 @@ int XrdOssFile::Close(long long *retsz)
 #ifdef XRDOSSCX
     if (cxobj) {delete cxobj; cxobj = 0;}
 #endif
-    fd = -1; FSize = -1; cacheP = 0;
+    fd = -1; FSize = -1; cacheP = 0; ioFSD = 0;
     return XrdOssOK;
 }
 
@@ -874,18 +876,23 @@ ssize_t XrdOssFile::Read(off_t offset, size_t blen)
 
 ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 {
+     struct timespec ioT;
      ssize_t retval;
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
 #ifdef XRDOSSCX
-     if (cxobj)  
-        if (XrdOssSS->DirFlags & XrdOssNOSSDEC) return (ssize_t)-XRDOSS_E8021;
-           else   retval = cxobj->Read((char *)buff, blen, offset);
+     if (cxobj && (XrdOssSS->DirFlags & XrdOssNOSSDEC))
+        return (ssize_t)-XRDOSS_E8021;
+#endif
+     if (ioFSD) ioFSD->ioBeg(ioT);
+#ifdef XRDOSSCX
+     if (cxobj)   retval = cxobj->Read((char *)buff, blen, offset);
         else 
 #endif
              do { retval = pread(fd, buff, blen, offset); }
                 while(retval < 0 && errno == EINTR);
+     if (ioFSD) ioFSD->ioEnd(ioT);
 
      return (retval >= 0 ? retval : (ssize_t)-errno);
 }
@@ -909,6 +916,7 @@ ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 
 ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 {
+   struct timespec ioT;
    ssize_t rdsz, totBytes = 0;
    int i;
 
@@ -942,6 +950,7 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 
 // Read in the vector and do a pre-advise if we support that
 //
+   if (ioFSD) ioFSD->ioBeg(ioT);
    for (i = 0; i < n; i++)
        {do {rdsz = pread(fd, readV[i].data, readV[i].size, readV[i].offset);}
            while(rdsz < 0 && errno == EINTR);
@@ -966,6 +975,7 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 
 // All done, return bytes read.
 //
+   if (ioFSD) ioFSD->ioEnd(ioT);
 #if (defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))) && defined(HAVE_ATOMICS)
    if (XrdOssSS->prDepth) AtomicDec((XrdOssSS->prActive));
 #endif
@@ -990,16 +1000,19 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 
 ssize_t XrdOssFile::ReadRaw(void *buff, off_t offset, size_t blen)
 {
+     struct timespec ioT;
      ssize_t retval;
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (ioFSD) ioFSD->ioBeg(ioT);
 #ifdef XRDOSSCX
      if (cxobj)   retval = cxobj->ReadRaw((char *)buff, blen, offset);
         else 
 #endif
              do { retval = pread(fd, buff, blen, offset); }
                 while(retval < 0 && errno == EINTR);
+     if (ioFSD) ioFSD->ioEnd(ioT);
 
      return (retval >= 0 ? retval : (ssize_t)-errno);
 }
@@ -1021,6 +1034,7 @@ ssize_t XrdOssFile::ReadRaw(void *buff, off_t offset, size_t blen)
 
 ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
 {
+     struct timespec ioT;
      ssize_t retval;
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
@@ -1028,8 +1042,10 @@ ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
      if (XrdOssSS->MaxSize && (long long)(offset+blen) > XrdOssSS->MaxSize)
         return (ssize_t)-XRDOSS_E8007;
 
+     if (ioFSD) ioFSD->ioBeg(ioT);
      do { retval = pwrite(fd, buff, blen, offset); }
           while(retval < 0 && errno == EINTR);
+     if (ioFSD) ioFSD->ioEnd(ioT);
 
      if (retval < 0) retval = (retval == EBADF && cxobj ? -XRDOSS_E8022 : -errno);
      return retval;
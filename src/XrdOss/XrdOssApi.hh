@@ -83,6 +83,7 @@ static const int    noDread  = 0x04;
 class oocx_CXFile;
 class XrdSfsAio;
 class XrdOssCache_FS;
+class XrdOssCache_FSData;
 class XrdOssMioFile;
   
 class XrdOssFile : public XrdOssDF
@@ -116,7 +117,7 @@ int     Write(XrdSfsAio *aiop);
         // Constructor and destructor
         XrdOssFile(const char *tid, int fdnum=-1)
                   : XrdOssDF(tid, DF_isFile, fdnum),
-                    cxobj(0), cacheP(0), mmFile(0),
+                    cxobj(0), cacheP(0), ioFSD(0), mmFile(0),
                     rawio(0), cxpgsz(0) {cxid[0] = '\0';}
 
 virtual ~XrdOssFile() {if (fd >= 0) Close();}
@@ -127,6 +128,7 @@ int     Open_ufs(const char *, int, int, unsigned long long);
 static int      AioFailure;
 oocx_CXFile    *cxobj;
 XrdOssCache_FS *cacheP;
+XrdOssCache_FSData *ioFSD;
 XrdOssMioFile  *mmFile;
 long long       FSize;
 int             rawio;
@@ -290,6 +292,7 @@ protected:
 long long minalloc;          //    Minimum allocation
 int       ovhalloc;          //    Allocation overage
 int       fuzalloc;          //    Allocation fuzz
+int       ldalloc;           //    Allocation load weight
 int       cscanint;          //    Seconds between cache scans
 int       xfrspeed;          //    Average transfer speed (bytes/second)
 int       xfrovhd;           //    Minimum seconds to get a file
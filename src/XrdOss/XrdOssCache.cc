@@ -78,7 +78,9 @@ XrdOssCache_FS     *XrdOssCache::fslast  = 0;
 XrdOssCache_FSData *XrdOssCache::fsdata  = 0;
 double              XrdOssCache::fuzAlloc= 0.0;
 long long           XrdOssCache::minAlloc= 0;
+int                 XrdOssCache::ldAlloc = 0;
 int                 XrdOssCache::fsCount = 0;
+bool                XrdOssCache::ioTrack = false;
 int                 XrdOssCache::ovhAlloc= 0;
 int                 XrdOssCache::Quotas  = 0;
 int                 XrdOssCache::Usage   = 0;
@@ -121,6 +123,11 @@ XrdOssCache_FSData::XrdOssCache_FSData(const char *fsp,
      updt = time(0);
      next = 0;
      stat = 0;
+     ioActive  = 0;
+     ioLatency = 0;
+     ioCount   = 0;
+     ioSelect  = 0;
+     ioLast    = 0;
 
 // This is created only for new partitions!
 //
@@ -137,6 +144,25 @@ XrdOssCache_FSData::XrdOssCache_FSData(const char *fsp,
         }
 }
   
+/******************************************************************************/
+
+void XrdOssCache_FSData::ioEnd(struct timespec &tBeg)
+{
+   struct timespec tEnd;
+   long long usec, oldLat = ioLatency;
+
+// Compute how long the I/O took and fold it into the decaying average. We
+// don't care that concurrent updates may occasionally lose a sample.
+//
+   clock_gettime(CLOCK_MONOTONIC, &tEnd);
+   usec = (tEnd.tv_sec - tBeg.tv_sec)*1000000LL
+        + (tEnd.tv_nsec - tBeg.tv_nsec)/1000;
+   if (usec < 0) usec = 0;
+   ioLatency = static_cast<unsigned int>(oldLat + (usec - oldLat)/8);
+   ioCount++;
+   ioActive--;
+}
+
 /******************************************************************************/
 /*            X r d O s s C a c h e _ F S   C o n s t r u c t o r             */
 /******************************************************************************/
@@ -515,26 +541,28 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
 
 // Find a cache that will fit this allocation request. We start with the next
 // entry past the last one we selected and go full round looking for a
-// compatable entry (enough space and in the right space group).
+// compatable entry (enough space and in the right space group). When I/O load
+// is to be considered, that is done separately.
 //
    fsp_sel = 0; maxfree = 0;
    fsp = cgp->curr->next; fspend = fsp; // End when we hit the start again
-   do {
-       if (strcmp(aInfo.cgName, fsp->group)
-       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
-                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))) continue;
-       curfree = fsp->fsdata->frsz;
-       if (size > curfree) continue;
-
-             if (fuzAlloc > 0.999) {fsp_sel = fsp; break;}
-       else  if (!fuzAlloc || !fsp_sel)
-                {if (curfree > maxfree) {fsp_sel = fsp; maxfree = curfree;}}
-       else {diffree = (!(curfree + maxfree) ? 0.0
-                     : static_cast<double>(XRDABS(maxfree - curfree)) /
-                       static_cast<double>(       maxfree + curfree));
-             if (diffree > fuzAlloc) {fsp_sel = fsp; maxfree = curfree;}
-            }
-      } while((fsp = fsp->next) != fspend);
+   if (ldAlloc) fsp_sel = SelectLD(cgp, aInfo, size);
+      else do {if (strcmp(aInfo.cgName, fsp->group)
+               || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                                ||  strncmp(aInfo.cgPath, fsp->path,
+                                            aInfo.cgPlen)))) continue;
+               curfree = fsp->fsdata->frsz;
+               if (size > curfree) continue;
+
+                     if (fuzAlloc > 0.999) {fsp_sel = fsp; break;}
+               else  if (!fuzAlloc || !fsp_sel)
+                        {if (curfree > maxfree) {fsp_sel = fsp; maxfree = curfree;}}
+               else {diffree = (!(curfree + maxfree) ? 0.0
+                             : static_cast<double>(XRDABS(maxfree - curfree)) /
+                               static_cast<double>(       maxfree + curfree));
+                     if (diffree > fuzAlloc) {fsp_sel = fsp; maxfree = curfree;}
+                    }
+              } while((fsp = fsp->next) != fspend);
 
 // Check if we can realy fit this file. If so, update current scan pointer
 //
@@ -572,6 +600,7 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
                  <<fsp_sel->fsdata->path);
    fsp_sel->fsdata->frsz -= size;
    fsp_sel->fsdata->stat |= XrdOssFSData_REFRESH;
+   fsp_sel->fsdata->ioSelect++;
    aInfo.cgFSp  = fsp_sel;
    return datfd;
 }
@@ -635,6 +664,20 @@ XrdOssCache_FS *XrdOssCache::Find(const char *Path, int lnklen)
    return fsp;
 }
 
+/******************************************************************************/
+/*                                F i n d F S                                 */
+/******************************************************************************/
+  
+XrdOssCache_FSData *XrdOssCache::FindFS(dev_t devid)
+{
+   XrdOssCache_FSData *fsdp = fsdata;
+
+// Partitions are only added during configuration so no lock is needed here
+//
+   while(fsdp && fsdp->fsid != devid) fsdp = fsdp->next;
+   return fsdp;
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -665,13 +708,15 @@ int XrdOssCache::Init(const char *UPath, const char *Qfile, int isSOL, int us)
 
 /******************************************************************************/
 
-int XrdOssCache::Init(long long aMin, int ovhd, int aFuzz)
+int XrdOssCache::Init(long long aMin, int ovhd, int aFuzz, int aLoad)
 {
 // Set values
 //
    minAlloc = aMin;
    ovhAlloc = ovhd;
    fuzAlloc = static_cast<double>(aFuzz)/100.0;
+   ldAlloc  = aLoad;
+   ioTrack  = (aLoad != 0);
    return 0;
 }
 
@@ -836,6 +881,53 @@ char *XrdOssCache::Parse(const char *token, char *cbuff, int cblen)
    return Path;
 }
 
+/******************************************************************************/
+/* Private:                     S e l e c t L D                               */
+/******************************************************************************/
+
+// SelectLD() is called with the cache mutex held.
+
+XrdOssCache_FS *XrdOssCache::SelectLD(XrdOssCache_Group *cgp,
+                                      allocInfo &aInfo, long long size)
+{
+   XrdOssCache_FS *fsp, *fspend, *fsp_sel = 0;
+   XrdOssCache_FSData *fsdp;
+   double cost, maxcost = 0.0, score, maxscore = -1.0;
+   long long curfree, maxfree = 0;
+
+// Weigh each eligible partition by its free space and by its expected I/O
+// service time (the number of requests in progress times recent latency),
+// each relative to the best of them. The first pass finds the reference.
+//
+   fsp = cgp->curr->next; fspend = fsp;
+   do {if (strcmp(aInfo.cgName, fsp->group)
+       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))
+       || size > (curfree = fsp->fsdata->frsz)) continue;
+       fsdp = fsp->fsdata;
+       cost = static_cast<double>(fsdp->ioActive + 1) * fsdp->ioLatency;
+       if (curfree > maxfree) maxfree = curfree;
+       if (cost    > maxcost) maxcost = cost;
+      } while((fsp = fsp->next) != fspend);
+   if (!maxfree) return 0;
+
+// Now select the partition with the best score. Ties go to the first one seen
+// so that we still round-robin across otherwise equivalent partitions.
+//
+   do {if (strcmp(aInfo.cgName, fsp->group)
+       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))
+       || size > (curfree = fsp->fsdata->frsz)) continue;
+       fsdp = fsp->fsdata;
+       cost = static_cast<double>(fsdp->ioActive + 1) * fsdp->ioLatency;
+       score = (100 - ldAlloc) * static_cast<double>(curfree) / maxfree
+             + ldAlloc * (maxcost > 0.0 ? 1.0 - cost/maxcost : 1.0);
+       if (score > maxscore) {fsp_sel = fsp; maxscore = score;}
+      } while((fsp = fsp->next) != fspend);
+
+   return fsp_sel;
+}
+
 /******************************************************************************/
 /*                                  S c a n                                   */
 /******************************************************************************/
@@ -892,6 +984,15 @@ void *XrdOssCache::Scan(int cscanint)
                         {fsFree = fsdp->frsz; fsSize = fsdp->size;}
                      fsTotFr += fsdp->frsz;
                     }
+
+             // Age the latency of idle partitions so that a past burst of
+             // slow I/O does not keep them from being selected forever.
+             //
+                 if (ioTrack)
+                    {if (fsdp->ioCount == fsdp->ioLast && !fsdp->ioActive)
+                        fsdp->ioLatency = fsdp->ioLatency / 2;
+                     fsdp->ioLast = fsdp->ioCount;
+                    }
                  fsdp = fsdp->next;
                 }
 
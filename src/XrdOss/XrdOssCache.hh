@@ -36,6 +36,7 @@
 #include "XrdOss/XrdOssVS.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 
 /******************************************************************************/
 /*              O S   D e p e n d e n t   D e f i n i t i o n s               */
@@ -119,6 +120,20 @@ int                 stat;
 unsigned short      bdevID;
 unsigned short      partID;
 
+// The following track the I/O load on the partition when allocation takes
+// it into account. The latency is a decaying average in microseconds.
+//
+RAtomic_int         ioActive; // I/O requests in progress
+RAtomic_uint        ioLatency;// Recent I/O service time
+RAtomic_ullong      ioCount;  // I/O requests completed
+RAtomic_ullong      ioSelect; // Times selected for a new file
+unsigned long long  ioLast;   // ioCount as of the last cache scan
+
+inline void         ioBeg(struct timespec &tBeg)
+                         {ioActive++; clock_gettime(CLOCK_MONOTONIC, &tBeg);}
+
+       void         ioEnd(struct timespec &tBeg);
+
        XrdOssCache_FSData(const char *, STATFS_t &, dev_t);
       ~XrdOssCache_FSData() {if (path) free((void *)path);}
 };
@@ -243,10 +258,13 @@ static void            DevInfo(struct stat &buf, bool limits=false);
 
 static XrdOssCache_FS *Find(const char *Path, int lklen=0);
 
+static
+XrdOssCache_FSData    *FindFS(dev_t devid);
+
 static int             Init(const char *UDir, const char *Qfile,
                             int isSOL, int usync=0);
 
-static int             Init(long long aMin, int ovhd, int aFuzz);
+static int             Init(long long aMin, int ovhd, int aFuzz, int aLoad=0);
 
 static void            List(const char *lname, XrdSysError &Eroute);
 
@@ -270,12 +288,17 @@ static XrdOssCache_FS     *fsfirst;  // -> First  filesystem
 static XrdOssCache_FS     *fslast;   // -> Last   filesystem
 static XrdOssCache_FSData *fsdata;   // -> Filesystem data
 static int                 fsCount;  // Number of file systems
+static bool                ioTrack;  // Track partition I/O load
 
 private:
 static bool MapDM(const char *ldm, char *buff, int blen);
+static
+XrdOssCache_FS *SelectLD(XrdOssCache_Group *cgp, allocInfo &aInfo,
+                         long long size);
 
 static long long           minAlloc;
 static double              fuzAlloc;
+static int                 ldAlloc;
 static int                 ovhAlloc;
 static int                 Quotas;
 static int                 Usage;
@@ -187,6 +187,7 @@ XrdOssSys::XrdOssSys()
    minalloc      = 0;
    ovhalloc      = 0;
    fuzalloc      = 0;
+   ldalloc       = 0;
    xfrspeed      = 9*1024*1024;
    xfrovhd       = 30;
    xfrhold       =  3*60*60;
@@ -312,7 +313,7 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
    if (m1 || m2) Eroute.Say("++++++ Configuring ", m1, m2, "mode . . .");
   }
    NoGo |= XrdOssCache::Init(UDir, QFile, Solitary, USync)
-          |XrdOssCache::Init(minalloc, ovhalloc, fuzalloc);
+          |XrdOssCache::Init(minalloc, ovhalloc, fuzalloc, ldalloc);
 
 // Configure the MSS interface including staging
 //
@@ -412,7 +413,7 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
         else cloc = ConfigFN;
 
      snprintf(buff, sizeof(buff), "Config effective %s oss configuration:\n"
-                                  "       oss.alloc        %lld %d %d\n"
+                                  "       oss.alloc        %lld %d %d %d\n"
                                   "       oss.spacescan    %d\n"
                                   "       oss.fdlimit      %d %d\n"
                                   "       oss.maxsize      %lld\n"
@@ -425,7 +426,7 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
                                   "       oss.trace        %x\n"
                                   "       oss.xfr          %d deny %d keep %d",
              cloc,
-             minalloc, ovhalloc, fuzalloc,
+             minalloc, ovhalloc, fuzalloc, ldalloc,
              cscanint,
              FDFence, FDLimit, MaxSize,
              XrdOssConfig_Val(N2N_Lib,    namelib),
@@ -1120,7 +1121,9 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
 
 /* Function: aalloc
 
-   Purpose:  To parse the directive: alloc <min> [<headroom> [<fuzz>]]
+   Purpose:  To parse the directive:
+
+             alloc <min> [<headroom> [<fuzz> [<load>]]]
 
              <min>       minimum amount of free space needed in a partition.
                          (asterisk uses default).
@@ -1130,6 +1133,11 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
                          quantities that may be ignored when selecting a space
                            0 - reduces to finding the largest free space
                          100 - reduces to simple round-robin allocation
+             <load>      the percentage weight given to the current I/O load
+                         of a partition, as opposed to its free space, when
+                         selecting a space. The fuzz is then not used.
+                           0 - I/O load is not considered (the default)
+                         100 - reduces to finding the least loaded partition
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1140,6 +1148,7 @@ int XrdOssSys::xalloc(XrdOucStream &Config, XrdSysError &Eroute)
     long long mina = 0;
     int       fuzz = 0;
     int       hdrm = 0;
+    int       load = 0;
 
     if (!(val = Config.GetWord()))
        {Eroute.Emsg("Config", "alloc minfree not specified"); return 1;}
@@ -1153,12 +1162,19 @@ int XrdOssSys::xalloc(XrdOucStream &Config, XrdSysError &Eroute)
         if ((val = Config.GetWord()))
            {if (strcmp(val, "*") &&
             XrdOuca2x::a2i(Eroute, "alloc fuzz", val, &fuzz, 0, 100)) return 1;
+
+            if ((val = Config.GetWord()))
+               {if (strcmp(val, "*") &&
+                XrdOuca2x::a2i(Eroute, "alloc load", val, &load, 0, 100))
+                   return 1;
+               }
            }
        }
 
     minalloc = mina;
     ovhalloc = hdrm;
     fuzalloc = fuzz;
+    ldalloc  = load;
     return 0;
 }
 
@@ -516,17 +516,37 @@ int XrdOssSys::getStats(char *buff, int blen)
                             + stag1sz + stag2sz + stag3sz
                             + stagqsz + stagssz;
 
+   static const char ltag1[] = "<parts>%d";
+   static const char ltag2[] = "<stats id=\"%d\"><path>\"%s\"</path>"
+                "<act>%d</act><lat>%u</lat><ios>%llu</ios><sel>%llu</sel>"
+                "</stats>";
+   static const char ltag3[] = "</parts>";
+
+   static const int ltag1sz = sizeof(ltag1) + 16;
+   static const int ltag2sz = sizeof(ltag2) + (16*4);
+   static const int ltag3sz = sizeof(ltag3);
+
    XrdOssCache_Group  *fsg = XrdOssCache_Group::fsgroups;
+   XrdOssCache_FSData *fsdp;
    OssDPath           *dpP = DPList;
    char *bp = buff;
-   int dpNum = 0, spNum = 0, n, flen;
+   int dpNum = 0, spNum = 0, ptNum = 0, n, flen;
 
 // If no buffer spupplied, return how much data we will generate. We also
-// do one-time initialization here.
-//
-   if (!buff) return ptag1sz + (ptag2sz * numDP) + stag3sz + lenDP
-                   + stag1sz + (stag2sz * numCG) + stag3sz
-                   + stagqsz + stagssz;
+// do one-time initialization here. Partition load is only reported when
+// it is being tracked.
+//
+   if (!buff)
+      {n = ptag1sz + (ptag2sz * numDP) + stag3sz + lenDP
+         + stag1sz + (stag2sz * numCG) + stag3sz
+         + stagqsz + stagssz;
+       if (XrdOssCache::ioTrack)
+          {n += ltag1sz + ltag3sz;
+           for (fsdp = XrdOssCache::fsdata; fsdp; fsdp = fsdp->next)
+               n += ltag2sz + strlen(fsdp->path);
+          }
+       return n;
+      }
 
 // Make sure we have enough space for one entry
 //
@@ -576,8 +596,30 @@ int XrdOssSys::getStats(char *buff, int blen)
 
 // Insert trailer
 //
-   if (blen >= stag3sz) {strcpy(bp, stag3); bp += (stag3sz-1);}
+   if (blen >= stag3sz)
+      {strcpy(bp, stag3); bp += (stag3sz-1); blen -= (stag3sz-1);}
       else return dpNum;
+   spNum = bp - buff;
+
+// Generate partition load information if we are tracking it
+//
+   if (!XrdOssCache::ioTrack || blen <= ltag1sz) return spNum;
+   for (fsdp = XrdOssCache::fsdata; fsdp; fsdp = fsdp->next) ptNum++;
+   flen = sprintf(bp, ltag1, ptNum); bp += flen; blen -= flen;
+   ptNum = 0;
+
+   for (fsdp = XrdOssCache::fsdata; fsdp; fsdp = fsdp->next)
+       {flen = snprintf(bp, blen, ltag2, ptNum++, fsdp->path,
+                        static_cast<int>(fsdp->ioActive),
+                        static_cast<unsigned int>(fsdp->ioLatency),
+                        static_cast<unsigned long long>(fsdp->ioCount),
+                        static_cast<unsigned long long>(fsdp->ioSelect));
+        if (flen >= blen) return spNum;
+        bp += flen; blen -= flen;
+       }
+
+   if (blen < ltag3sz) return spNum;
+   strcpy(bp, ltag3); bp += (ltag3sz-1);
 
 // All done
 //
@@ -0,0 +1,281 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c L a t e n c y . c c                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "XrdOuc/XrdOucLatency.hh"
+
+/******************************************************************************/
+/*                        L o c a l   S t a t i c s                           */
+/******************************************************************************/
+
+namespace
+{
+std::atomic<XrdOucLatency *> latFirst(0);
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOucLatency::XrdOucLatency(const char *prot, const char *req)
+                            : protName(prot), reqName(req)
+{
+   std::atomic<XrdOucLatency *> *aP = &latFirst;
+   XrdOucLatency *lP = 0;
+
+// Append ourselves to the registry so that reports follow the order in which
+// objects were created. Objects are never removed so readers may walk the
+// list without a lock.
+//
+   next = 0;
+   while(!aP->compare_exchange_weak(lP, this, std::memory_order_release,
+                                              std::memory_order_acquire))
+        {if (lP) {aP = &(lP->next); lP = 0;}}
+}
+
+/******************************************************************************/
+/*                       H i s t   C o n s t r u c t o r                      */
+/******************************************************************************/
+
+XrdOucLatency::Hist::Hist() : sum(0)
+{
+   for (int i = 0; i < binNum; i++) bin[i] = 0;
+}
+
+/******************************************************************************/
+/*                              H i s t : : A d d                             */
+/******************************************************************************/
+
+void XrdOucLatency::Hist::Add(long long usec)
+{
+   if (usec < 0) usec = 0;
+   bin[Bin(usec)].fetch_add(1, std::memory_order_relaxed);
+   sum.fetch_add(usec, std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+/*                              H i s t : : S u m                             */
+/******************************************************************************/
+
+void XrdOucLatency::Hist::Sum(XrdOucLatency::Summary &sInfo) const
+{
+   static const int pct[3] = {50, 90, 99};
+   long long *pVal[3] = {&sInfo.p50, &sInfo.p90, &sInfo.p99};
+   unsigned long long snap[binNum], tot = 0, cum = 0;
+   int i, j = 0, last = -1;
+
+// Take a snapshot of the bins. Concurrent updates may make this slightly
+// inconsistent with the sum, which is acceptable for reporting.
+//
+   for (i = 0; i < binNum; i++)
+       {snap[i] = bin[i].load(std::memory_order_relaxed);
+        if (snap[i]) {tot += snap[i]; last = i;}
+       }
+
+   memset(&sInfo, 0, sizeof(sInfo));
+   if (!tot) return;
+   sInfo.num = tot;
+   sInfo.avg = sum.load(std::memory_order_relaxed) / tot;
+   sInfo.max = Edge(last+1) - 1;
+
+// Each percentile is reported as the midpoint of the bin that holds it
+//
+   for (i = 0; i <= last && j < 3; i++)
+       {cum += snap[i];
+        while(j < 3 && cum*100 >= tot*pct[j])
+             *pVal[j++] = (Edge(i) + Edge(i+1) - 1) / 2;
+       }
+}
+
+/******************************************************************************/
+/* Private:                          B i n                                    */
+/******************************************************************************/
+
+int XrdOucLatency::Bin(long long usec)
+{
+   int e;
+
+// The first binSub values each have their own bin. After that, each power of
+// two is split into binSub equal bins.
+//
+   if (usec < binSub) return static_cast<int>(usec);
+   e = 63 - __builtin_clzll(static_cast<unsigned long long>(usec));
+   if (e >= binMax) return binNum-1;
+   return (e-2)*binSub + static_cast<int>((usec >> (e-3)) & (binSub-1));
+}
+
+/******************************************************************************/
+/* Private:                         E d g e                                   */
+/******************************************************************************/
+
+long long XrdOucLatency::Edge(int k)
+{
+   int e;
+
+// Return the lowest value that falls into bin k
+//
+   if (k < binSub) return k;
+   e = k/binSub + 2;
+   return static_cast<long long>(binSub + k%binSub) << (e-3);
+}
+
+/******************************************************************************/
+/*                                E x p o r t                                 */
+/******************************************************************************/
+
+void XrdOucLatency::Export(std::string &out)
+{
+   static const char *mName[2] = {"xrootd_request_wait_seconds",
+                                  "xrootd_request_service_seconds"};
+   static const char *mHelp[2] = {"Time requests waited to be dispatched.",
+                                  "Time taken to service requests."};
+   XrdOucLatency *lP;
+   char buff[512];
+   unsigned long long cum;
+   int i, k, n;
+
+// Bucket bounds are powers of four from 16 microseconds to 67 seconds. They
+// fall on bin edges; a value exactly equal to a bound is counted above it.
+//
+   for (i = 0; i < 2; i++)
+       {snprintf(buff, sizeof(buff), "# HELP %s %s\n# TYPE %s histogram\n",
+                 mName[i], mHelp[i], mName[i]);
+        out += buff;
+        lP = latFirst.load(std::memory_order_acquire);
+        for (; lP; lP = lP->Next())
+            {const Hist &h = (i ? lP->svcHist : lP->qwtHist);
+             cum = 0; k = 0;
+             for (int p = 4; p <= 26; p += 2)
+                 {for (; k < Bin(1LL << p); k++)
+                      cum += h.bin[k].load(std::memory_order_relaxed);
+                  snprintf(buff, sizeof(buff), "%s_bucket{protocol=\"%s\","
+                           "request=\"%s\",le=\"%.6f\"} %llu\n", mName[i],
+                           lP->protName, lP->reqName, (1LL << p)/1e6, cum);
+                  out += buff;
+                 }
+             for (; k < binNum; k++)
+                 cum += h.bin[k].load(std::memory_order_relaxed);
+             n = snprintf(buff, sizeof(buff), "%s_bucket{protocol=\"%s\","
+                          "request=\"%s\",le=\"+Inf\"} %llu\n"
+                          "%s_sum{protocol=\"%s\",request=\"%s\"} %.6f\n"
+                          "%s_count{protocol=\"%s\",request=\"%s\"} %llu\n",
+                          mName[i], lP->protName, lP->reqName, cum,
+                          mName[i], lP->protName, lP->reqName,
+                          h.sum.load(std::memory_order_relaxed)/1e6,
+                          mName[i], lP->protName, lP->reqName, cum);
+             out.append(buff, n);
+            }
+       }
+}
+
+/******************************************************************************/
+/* Private:                          F m t                                    */
+/******************************************************************************/
+
+int XrdOucLatency::Fmt(char *buff, int blen, const char *tag,
+                       const XrdOucLatency::Summary &s)
+{
+   int n = snprintf(buff, blen, "<%s><num>%lld</num><avg>%lld</avg>"
+                    "<p50>%lld</p50><p90>%lld</p90><p99>%lld</p99>"
+                    "<max>%lld</max></%s>",
+                    tag, s.num, s.avg, s.p50, s.p90, s.p99, s.max, tag);
+   return (n < blen ? n : blen-1);
+}
+
+/******************************************************************************/
+/*                                   N o w                                    */
+/******************************************************************************/
+
+long long XrdOucLatency::Now()
+{
+   struct timespec tp;
+
+   clock_gettime(CLOCK_MONOTONIC, &tp);
+   return static_cast<long long>(tp.tv_sec)*1000000 + tp.tv_nsec/1000;
+}
+
+/******************************************************************************/
+/*                                R e p o r t                                 */
+/******************************************************************************/
+
+int XrdOucLatency::Report(const char *prot, char *buff, int blen)
+{
+   static const long long LLMax = 0x7fffffffffffffffLL;
+   static const Summary   sMax  = {LLMax, LLMax, LLMax, LLMax, LLMax, LLMax};
+   XrdOucLatency *lP = latFirst.load(std::memory_order_acquire);
+   Summary sInfo;
+   char dummy[512];
+   int n, len = 0;
+
+// Check if anything is registered for this protocol. If not, we report nothing.
+//
+   for (; lP; lP = lP->Next()) if (!strcmp(prot, lP->protName)) break;
+   if (!lP) return 0;
+
+// If no buffer, caller wants the maximum size we will generate
+//
+   if (!buff)
+      {len = snprintf(dummy, sizeof(dummy), "<stats id=\"latency\"><prot>%s"
+                      "</prot></stats>", prot);
+       for (; lP; lP = lP->Next())
+           {if (strcmp(prot, lP->protName)) continue;
+            len += strlen(lP->reqName)*2 + 5
+                +  Fmt(dummy, sizeof(dummy), "wait", sMax)
+                +  Fmt(dummy, sizeof(dummy), "svc",  sMax);
+           }
+       return len;
+      }
+
+// Format the header
+//
+   n = snprintf(buff, blen, "<stats id=\"latency\"><prot>%s</prot>", prot);
+   if (n >= blen) return 0;
+   len = n;
+
+// Format each request type of this protocol, times are in microseconds
+//
+   for (; lP; lP = lP->Next())
+       {if (strcmp(prot, lP->protName)) continue;
+        n = snprintf(buff+len, blen-len, "<%s>", lP->reqName);
+        if ((len += n) >= blen) return 0;
+        lP->qwtHist.Sum(sInfo);
+        len += Fmt(buff+len, blen-len, "wait", sInfo);
+        lP->svcHist.Sum(sInfo);
+        len += Fmt(buff+len, blen-len, "svc",  sInfo);
+        n = snprintf(buff+len, blen-len, "</%s>", lP->reqName);
+        if ((len += n) >= blen) return 0;
+       }
+
+// Finish up
+//
+   n = snprintf(buff+len, blen-len, "</stats>");
+   if ((len += n) >= blen) return 0;
+   return len;
+}
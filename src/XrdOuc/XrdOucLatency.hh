@@ -0,0 +1,152 @@
+#ifndef __XRDOUCLATENCY_HH__
+#define __XRDOUCLATENCY_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c L a t e n c y . h h                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <string>
+
+//------------------------------------------------------------------------------
+//! Lock-free latency histograms for one request type of one protocol. Each
+//! object records the time a request waited to be dispatched and the time it
+//! took to service it. Values are kept in microseconds using log-linear bins
+//! (eight bins per power of two) so that percentiles are accurate to within
+//! 12.5%. Objects register themselves when constructed and must never be
+//! deleted, so they should be allocated once at configuration time.
+//------------------------------------------------------------------------------
+
+class XrdOucLatency
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Export all registered histograms in Prometheus text format.
+//!
+//! @param  out      Reference to the string to which the text is appended.
+//------------------------------------------------------------------------------
+
+static void      Export(std::string &out);
+
+//------------------------------------------------------------------------------
+//! Get the current time for latency measurements.
+//!
+//! @return The monotonic time in microseconds.
+//------------------------------------------------------------------------------
+
+static long long Now();
+
+//------------------------------------------------------------------------------
+//! Format the summary of all histograms for a protocol as an xrd.report
+//! statistics element.
+//!
+//! @param  prot     The protocol name whose histograms are to be reported.
+//! @param  buff     Pointer to the buffer. When nil, the maximum length that
+//!                  would be generated is returned.
+//! @param  blen     Length of the buffer.
+//!
+//! @return The number of bytes placed in the buffer, excluding the null byte.
+//------------------------------------------------------------------------------
+
+static int       Report(const char *prot, char *buff, int blen);
+
+//------------------------------------------------------------------------------
+//! Record the start of a request.
+//!
+//! @param  lP       Pointer to the histograms for the request or nil if the
+//!                  request is not timed.
+//! @param  rdyT     The time the link was last dispatched (see Now()).
+//! @param  lastT    Reference to the dispatch time of the previous request on
+//!                  the link, which is updated. Only the first request of a
+//!                  dispatch waited in the scheduler queue; later requests
+//!                  read by the same thread are recorded with no wait.
+//!
+//! @return The current time, to be passed to Service() upon completion.
+//------------------------------------------------------------------------------
+
+static long long Start(XrdOucLatency *lP, long long rdyT, long long &lastT)
+                      {long long tNow = Now();
+                       if (lP) lP->Wait(rdyT && rdyT != lastT ? tNow-rdyT : 0);
+                       lastT = rdyT;
+                       return tNow;
+                      }
+
+//------------------------------------------------------------------------------
+//! Record the time a request took to be serviced.
+//!
+//! @param  usec     The number of microseconds.
+//------------------------------------------------------------------------------
+
+void             Service(long long usec) {svcHist.Add(usec);}
+
+//------------------------------------------------------------------------------
+//! Record the time a request waited to be dispatched.
+//!
+//! @param  usec     The number of microseconds.
+//------------------------------------------------------------------------------
+
+void             Wait(long long usec) {qwtHist.Add(usec);}
+
+//------------------------------------------------------------------------------
+//! Constructor
+//!
+//! @param  prot     The protocol name (e.g. "xroot"); must be a constant.
+//! @param  req      The request name (e.g. "open"); must be a constant.
+//------------------------------------------------------------------------------
+
+                 XrdOucLatency(const char *prot, const char *req);
+
+private:
+                ~XrdOucLatency() {}
+
+static const int binSub = 8;   // Bins per power of two
+static const int binMax = 40;  // Values are capped at 2**binMax-1 usec
+static const int binNum = (binMax-2)*binSub;
+
+struct Summary {long long num, avg, p50, p90, p99, max;};
+
+struct Hist
+      {std::atomic<unsigned long long> bin[binNum];
+       std::atomic<long long>          sum;
+
+       void Add(long long usec);
+       void Sum(Summary &sInfo) const;
+       Hist();
+      };
+
+XrdOucLatency   *Next() const {return next.load(std::memory_order_acquire);}
+
+static int       Bin(long long usec);
+static long long Edge(int k);
+static int       Fmt(char *buff, int blen, const char *tag, const Summary &s);
+
+std::atomic<XrdOucLatency *> next;
+const char                  *protName;
+const char                  *reqName;
+Hist                         qwtHist;
+Hist                         svcHist;
+};
+#endif
@@ -320,9 +320,18 @@ bool XrdOucPsx::Parse(char *var, XrdOucStream &Config, XrdSysError &eDest)
              mode      {r | w}
              pagesize  size of each cache page (can be suffixed with k, m, g).
              preread   [minpages [minrdsz]] [perf nn [recalc]]
+             prthreads number of preread threads and of write-back threads.
              r/w       enables caching for files opened read/write.
              sfiles    {on | off | .<sfx>}
              size      size of cache in bytes  (can be suffixed with k, m, g).
+             wblimit   memory for all write-back buffers (default 64m).
+             wbsize    size of each write-back buffer    (default 1m).
+             writeback combine writes and write them in the background. As
+                       flushes run concurrently with other I/O, this also lets
+                       reads of the same file run concurrently (the proxy's
+                       file objects are MT-safe). A file is synced on close
+                       when it had buffered writes so that an error in writing
+                       them is returned by the close.
 
    Output: true upon success or false upon failure.
 */
@@ -330,14 +339,19 @@ bool XrdOucPsx::Parse(char *var, XrdOucStream &Config, XrdSysError &eDest)
 bool XrdOucPsx::ParseCache(XrdSysError *Eroute, XrdOucStream &Config)
 {
    long long llVal, cSize=-1, m2Cache=-1, pSize=-1, minPg = -1;
+   long long wbSz = -1, wbLim = -1;
    const char *ivN = 0;
    char  *val, *sfSfx = 0, sfVal = '0', lgVal = '0', dbVal = '0', rwVal = '0';
+   char   wbVal = '0';
+   int    prThd = 0;
    char eBuff[2048], pBuff[1024], *eP;
    struct sztab {const char *Key; long long *Val;} szopts[] =
                {{"max2cache", &m2Cache},
                 {"minpages",  &minPg},
                 {"pagesize",  &pSize},
-                {"size",      &cSize}
+                {"size",      &cSize},
+                {"wblimit",   &wbLim},
+                {"wbsize",    &wbSz}
                };
    int i, numopts = sizeof(szopts)/sizeof(struct sztab);
 
@@ -370,7 +384,13 @@ do{for (i = 0; i < numopts; i++) if (!strcmp(szopts[i].Key, val)) break;
                 if (*pBuff == '?') return false;
                 break;
                }
+       else if (!strcmp("prthreads", val))
+               {if (!(val = Config.GetWord())) ivN = "prthreads";
+                   else if (XrdOuca2x::a2i(*Eroute, "prthreads", val,
+                                           &prThd, 1, 256)) return false;
+               }
        else if (!strcmp("r/w", val)) rwVal = '1';
+       else if (!strcmp("writeback", val)) wbVal = '1';
        else if (!strcmp("sfiles", val))
                {if (sfSfx) {free(sfSfx); sfSfx = 0;}
                      if (!(val = Config.GetWord())) ivN = "sfiles";
@@ -408,6 +428,13 @@ do{for (i = 0; i < numopts; i++) if (!strcmp(szopts[i].Key, val)) break;
           else {strcat(eP, "&optsf="); strcat(eBuff, sfSfx); free(sfSfx);}
       }
    if (rwVal != '0') strcat(eP, "&optwr=1");
+   if (wbVal != '0')
+      {eP += strlen(eP);
+       eP += sprintf(eP, "&optmt=1&optwb=1");
+       if (wbSz  > 0) eP += sprintf(eP, "&wbsize=%lld",  wbSz);
+       if (wbLim > 0) eP += sprintf(eP, "&wblimit=%lld", wbLim);
+      }
+   if (prThd > 0)    {eP += strlen(eP); sprintf(eP, "&prthreads=%d", prThd);}
    if (*pBuff)       strcat(eP, pBuff);
 
    mCache = strdup(eBuff);
@@ -10,6 +10,7 @@ set( LIB_XRD_PSS        XrdPss-${PLUGIN_VERSION} )
 set( LIB_XRD_CMSREDIRL  XrdCmsRedirectLocal-${PLUGIN_VERSION} )
 set( LIB_XRD_GPFS       XrdOssSIgpfsT-${PLUGIN_VERSION} )
 set( LIB_XRD_GPI        XrdOfsPrepGPI-${PLUGIN_VERSION} )
+set( LIB_XRD_TPCCL      XrdOfsTPCCl-${PLUGIN_VERSION} )
 set( LIB_XRD_ZCRC32     XrdCksCalczcrc32-${PLUGIN_VERSION} )
 set( LIB_XRD_THROTTLE   XrdThrottle-${PLUGIN_VERSION} )
 
@@ -124,6 +125,25 @@ set_target_properties(
   INTERFACE_LINK_LIBRARIES ""
   LINK_INTERFACE_LIBRARIES "" )
 
+#-------------------------------------------------------------------------------
+# Ofs in-process third party copy plugin library
+#-------------------------------------------------------------------------------
+add_library(
+  ${LIB_XRD_TPCCL}
+  MODULE
+  XrdOfs/XrdOfsTPCCl.cc         XrdOfs/XrdOfsTPCCopy.hh )
+
+target_link_libraries(
+  ${LIB_XRD_TPCCL}
+  XrdCl
+  XrdUtils )
+
+set_target_properties(
+  ${LIB_XRD_TPCCL}
+  PROPERTIES
+  INTERFACE_LINK_LIBRARIES ""
+  LINK_INTERFACE_LIBRARIES "" )
+
 #-------------------------------------------------------------------------------
 # libz compatible CRC32 plugin
 #-------------------------------------------------------------------------------
@@ -192,5 +212,5 @@ set_target_properties(
 # Install
 #-------------------------------------------------------------------------------
 install(
-  TARGETS ${LIB_XRD_PSS} ${LIB_XRD_BWM} ${LIB_XRD_GPFS} ${LIB_XRD_ZCRC32} ${LIB_XRD_THROTTLE} ${LIB_XRD_N2NO2P} ${LIB_XRD_CMSREDIRL} ${LIB_XRD_GPI}
+  TARGETS ${LIB_XRD_PSS} ${LIB_XRD_BWM} ${LIB_XRD_GPFS} ${LIB_XRD_ZCRC32} ${LIB_XRD_THROTTLE} ${LIB_XRD_N2NO2P} ${LIB_XRD_CMSREDIRL} ${LIB_XRD_GPI} ${LIB_XRD_TPCCL}
   LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR} )
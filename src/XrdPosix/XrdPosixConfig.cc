@@ -88,6 +88,7 @@ extern bool                       p2lSRC;
 extern bool                       p2lSGI;
 extern bool                       autoPGRD;
 extern bool                       usingEC;
+extern bool                       wbCache;
 };
   
 /******************************************************************************/
@@ -228,10 +229,15 @@ bool XrdPosixConfig::initCCM(XrdOucPsx &parms)
 // minp=n      - minimum number of pages needed.
 // mode={c|s}  - running as a client (default) or server.
 // optlg=1     - log statistics
+// optmt=1     - allow concurrent reads of a file (required by optwb).
 // optpr=1     - enable pre-reads
 // optsf=<val> - optimize structured file: 1 = all, 0 = off, .<sfx> specific
+// optwb=1     - combine writes and write them in the background (needs optmt).
 // optwr=1     - cache can be written to.
 // pagesz=n    - individual byte size of a page (can be suffized in k, m, g).
+// prthreads=n - number of preread threads and of write-back threads.
+// wblimit=n   - memory for all write-back buffers (can be suffized in k, m, g).
+// wbsize=n    - size of a write-back buffer    (can be suffized in k, m, g).
 //
 
 void XrdPosixConfig::initEnv(char *eData)
@@ -257,6 +263,15 @@ void XrdPosixConfig::initEnv(char *eData)
                                           myParms.minPages = Val;
                                          }
    initEnv(theEnv, "pagesz",    Val); if (Val >= 0) myParms.PageSize  = Val;
+   initEnv(theEnv, "prthreads", Val); if (Val >= 0)
+                                         {if (Val > 256) Val = 256;
+                                          myParms.prThreads = Val;
+                                         }
+   initEnv(theEnv, "wblimit",   Val); if (Val >= 0) myParms.wbLimit   = Val;
+   initEnv(theEnv, "wbsize",    Val); if (Val >= 0)
+                                         {if (Val > 0x40000000) Val = 0x40000000;
+                                          myParms.wbSize = Val;
+                                         }
 
 // Get Debug setting
 //
@@ -292,6 +307,23 @@ void XrdPosixConfig::initEnv(char *eData)
       myParms.Options |= XrdRmc::canPreRead;
 // if ((tP = theEnv.Get("optwr")) && *tP && *tP != '0') isRW = 1;
 
+// Our file objects are MT-safe so reads need not be serialized. This is not
+// the default as it changes the order in which concurrent requests complete.
+//
+   if ((tP = theEnv.Get("optmt")) && *tP && *tP != '0')
+      myParms.Options |= XrdRmc::ioMTSafe;
+
+// Write-back has flushers writing concurrently with other I/O so it requires
+// that the I/O be declared MT-safe above.
+//
+   if ((tP = theEnv.Get("optwb")) && *tP && *tP != '0')
+      {if (myParms.Options & XrdRmc::ioMTSafe)
+          {myParms.Options |= XrdRmc::writeBack;
+           XrdPosixGlobals::wbCache = true;
+          } else DMSG("initEnv", "'XRDPOSIX_CACHE=optwb' requires optmt=1; "
+                                 "write-back disabled.");
+      }
+
 // Now allocate a cache. Indicate that we already serialize the I/O to avoid
 // additional but unnecessary locking.
 //
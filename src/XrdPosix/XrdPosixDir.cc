@@ -29,8 +29,10 @@
 /* Modified by Frank Winklmeier to add the full Posix file system definition. */
 /******************************************************************************/
 
+#include "XrdCl/XrdClXRootDResponses.hh"
 #include "XrdPosix/XrdPosixDir.hh"
 #include "XrdPosix/XrdPosixMap.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
 /*                               G l o b a l s                                */
@@ -40,6 +42,130 @@ namespace XrdPosixGlobals
 {
 extern XrdCl::DirListFlags::Flags dlFlag;
 };
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// The directory listing is requested as a chunked response so that entries
+// can be returned by readdir() while the remainder of the listing is still
+// being sent. The object is shared by the directory and the response handler
+// and is deleted when both have let go of it.
+//
+class XrdPosixDirFill : public XrdCl::ResponseHandler
+{
+public:
+
+XrdCl::DirectoryList::ListEntry *At(uint32_t ent, int &rc)
+                     {XrdCl::DirectoryList::ListEntry *dirEnt = 0;
+                      fillCV.Lock();
+                      while(ent >= dirVec->GetSize() && !done) fillCV.Wait();
+                      if (ent < dirVec->GetSize())
+                         {dirEnt = dirVec->At(ent); rc = 0;}
+                         else rc = eNum;
+                      fillCV.UnLock();
+                      return dirEnt;
+                     }
+
+void         HandleResponse(XrdCl::XRootDStatus *status,
+                            XrdCl::AnyObject    *response) override;
+
+void         Recycle() {fillCV.Lock();
+                        if (--refs) fillCV.UnLock();
+                           else {fillCV.UnLock(); delete this;}
+                       }
+
+uint32_t     Size() {uint32_t n;
+                     fillCV.Lock();
+                     while(!done) fillCV.Wait();
+                     n = dirVec->GetSize();
+                     fillCV.UnLock();
+                     return n;
+                    }
+
+int          Wait1st() {int rc;
+                        fillCV.Lock();
+                        while(!dirVec->GetSize() && !done) fillCV.Wait();
+                        rc = (dirVec->GetSize() ? 0 : eNum);
+                        fillCV.UnLock();
+                        return rc;
+                       }
+
+             XrdPosixDirFill(XrdCl::DirectoryList *dList=0)
+                            : fillCV(0),
+                              dirVec(dList ? dList : new XrdCl::DirectoryList),
+                              eNum(0), refs(dList ? 1 : 2), done(dList != 0)
+                            {}
+
+            ~XrdPosixDirFill() {delete dirVec;}
+
+private:
+
+XrdSysCondVar         fillCV;
+XrdCl::DirectoryList *dirVec;
+int                   eNum;
+int                   refs;
+bool                  done;
+};
+
+/******************************************************************************/
+/*                        H a n d l e R e s p o n s e                         */
+/******************************************************************************/
+
+void XrdPosixDirFill::HandleResponse(XrdCl::XRootDStatus *status,
+                                     XrdCl::AnyObject    *response)
+{
+   XrdCl::DirectoryList *dList = 0;
+   XrdCl::DirectoryList::ListEntry *dirEnt;
+   bool isFinal = !(status->IsOK() && status->code == XrdCl::suContinue);
+
+// Add whatever we received to our listing or record the error
+//
+   fillCV.Lock();
+   if (status->IsOK())
+      {if (response) response->Get(dList);
+       if (dList)
+          {for (uint32_t i = 0; i < dList->GetSize(); i++)
+               {dirEnt = dList->At(i);
+                dirVec->Add(new XrdCl::DirectoryList::ListEntry(
+                            dirEnt->GetHostAddress(), dirEnt->GetName(),
+                            dirEnt->GetStatInfo()));
+                dirEnt->SetStatInfo(0);
+               }
+          }
+      } else if (!eNum) eNum = -XrdPosixMap::Result(*status);
+
+// Wakeup anyone waiting for entries. If this is the last response then the
+// handler's reference goes away.
+//
+   if (isFinal) {done = true; refs--;}
+   fillCV.Broadcast();
+   delete status;
+   delete response;
+   if (refs) fillCV.UnLock();
+      else {fillCV.UnLock(); delete this;}
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdPosixDir::~XrdPosixDir()
+{
+   if (myDirVec) myDirVec->Recycle();
+   if (myDirEnt) free(myDirEnt);
+}
+
+/******************************************************************************/
+/*                            g e t E n t r i e s                             */
+/******************************************************************************/
+
+long XrdPosixDir::getEntries()
+{
+// The number of entries is only known once the listing is complete
+//
+   return (myDirVec ? myDirVec->Size() : 0);
+}
   
 /******************************************************************************/
 /*                             n e x t E n t r y                              */
@@ -56,13 +182,10 @@ dirent64 *XrdPosixDir::nextEntry(dirent64 *dp)
 //
    if (!myDirVec && !Open()) {eNum = errno; return 0;}
 
-// Check if dir is empty or all entries have been read
-//
-   if (nxtEnt >= numEnt) {eNum = 0; return 0;}
-
-// Get information about the next entry
+// Get the next entry, waiting for it to arrive if need be. If there is none,
+// all entries have been read or the listing failed part way through.
 //
-   dirEnt = myDirVec->At(nxtEnt);
+   if (!(dirEnt = myDirVec->At(nxtEnt, eNum))) return 0;
    d_name = dirEnt->GetName().c_str();
    d_nlen = dirEnt->GetName().length();
 
@@ -94,6 +217,7 @@ dirent64 *XrdPosixDir::nextEntry(dirent64 *dp)
 DIR *XrdPosixDir::Open()
 {
    static const size_t dEntSize = sizeof(dirent64) + maxDlen + 1;
+   XrdCl::DirectoryList *dList;
    int rc;
 
 // Allocate a local dirent. Note that we get additional padding because on
@@ -102,18 +226,47 @@ DIR *XrdPosixDir::Open()
    if (!myDirEnt && !(myDirEnt = (dirent64 *)malloc(dEntSize)))
       {errno = ENOMEM; return (DIR *)0;}
 
-// Get the directory list
+// A deep locate can only be done synchronously. So, get the whole directory
+// list in that case.
 //
-   rc = XrdPosixMap::Result(DAdmin.Xrd.DirList(DAdmin.Url.GetPathWithParams(),
-                                               XrdPosixGlobals::dlFlag,
-                                               myDirVec, (uint16_t)0));
+   if (XrdPosixGlobals::dlFlag & XrdCl::DirListFlags::Locate)
+      {rc = XrdPosixMap::Result(DAdmin.Xrd.DirList(
+                                DAdmin.Url.GetPathWithParams(),
+                                XrdPosixGlobals::dlFlag, dList, (uint16_t)0));
+       if (rc) return (DIR *)0;
+       myDirVec = new XrdPosixDirFill(dList);
+       return (DIR *)&fdNum;
+      }
 
-// If we failed, return a zero pointer
+// Otherwise ask for the listing to be streamed to us and wait only for the
+// first part of it (or the error) to arrive.
 //
-   if (rc) return (DIR *)0;
+   myDirVec = new XrdPosixDirFill;
+   rc = XrdPosixMap::Result(DAdmin.Xrd.DirList(DAdmin.Url.GetPathWithParams(),
+                     XrdPosixGlobals::dlFlag | XrdCl::DirListFlags::Chunked,
+                     myDirVec, (uint16_t)0));
+   if (rc) {delete myDirVec; myDirVec = 0; return (DIR *)0;}
+
+   if ((rc = myDirVec->Wait1st()))
+      {myDirVec->Recycle(); myDirVec = 0;
+       errno = rc;
+       return (DIR *)0;
+      }
 
 // Finish up
 //
-   numEnt = myDirVec->GetSize();
    return (DIR *)&fdNum;
 }
+
+/******************************************************************************/
+/*                                r e w i n d                                 */
+/******************************************************************************/
+
+void XrdPosixDir::rewind()
+{
+// The caller obtained this object via Dir() and so already holds its lock.
+// Trying to obtain it again here would deadlock.
+//
+   nxtEnt = 0;
+   if (myDirVec) {myDirVec->Recycle(); myDirVec = 0;}
+}
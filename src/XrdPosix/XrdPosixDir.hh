@@ -45,21 +45,21 @@
 #include "XrdPosix/XrdPosixAdmin.hh"
 #include "XrdPosix/XrdPosixObject.hh"
 
+class XrdPosixDirFill;
+
 class XrdPosixDir : public XrdPosixObject
 {
 public:
                    XrdPosixDir(const char *path)
                               : DAdmin(path), myDirVec(0), myDirEnt(0),
-                                nxtEnt(0), numEnt(0), eNum(0)
+                                nxtEnt(0), eNum(0)
                               {}
 
-                  ~XrdPosixDir() {delete myDirVec;
-                                  if (myDirEnt) free(myDirEnt);
-                                 }
+                  ~XrdPosixDir();
 
 static int         dirNo(DIR *dirP)  {return *(int *)dirP;}
 
-       long        getEntries() { return numEnt;}
+       long        getEntries();
 
        long        getOffset() { return nxtEnt; }
 
@@ -69,10 +69,7 @@ static int         dirNo(DIR *dirP)  {return *(int *)dirP;}
 
        DIR        *Open();
 
-       void        rewind() {objMutex.WriteLock();
-                             nxtEnt = 0; delete myDirVec; myDirVec = 0;
-                             objMutex.UnLock();
-                            }
+       void        rewind();
        int         Status() {return eNum;}
 
        bool        Unread() {return myDirVec == 0;}
@@ -85,10 +82,9 @@ static const size_t maxDlen = 256;
 
 private:
   XrdPosixAdmin         DAdmin;
-  XrdCl::DirectoryList *myDirVec;
+  XrdPosixDirFill      *myDirVec;
   dirent64             *myDirEnt;
   uint32_t              nxtEnt;
-  uint32_t              numEnt;
   int                   eNum;
 };
 #endif
@@ -30,6 +30,7 @@
 
 #include <cerrno>
 #include <fcntl.h>
+#include <sched.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
 
@@ -51,6 +52,91 @@ int              XrdPosixObject::freeFD   =  0;
 int              XrdPosixObject::posxFD   =  0;
 int              XrdPosixObject::devNull  = -1;
 
+/******************************************************************************/
+/*                        L o c a l   C l a s s e s                           */
+/******************************************************************************/
+
+// Descriptors used for I/O are looked up without the global lock. To make this
+// safe, a thread publishes the global epoch it saw while it looks up an object.
+// An object that was in the table is not destroyed until every lookup that
+// began before the object was removed from the table has ended.
+//
+namespace
+{
+struct EpochRec
+      {std::atomic<unsigned long long> Epoch;  // Zero when not in a lookup
+       std::atomic<bool>               inUse;  // False when thread has exited
+       EpochRec                       *Next;
+
+       EpochRec() : Epoch(0), inUse(true), Next(0) {}
+      };
+
+std::atomic<unsigned long long> gEpoch(1);
+std::atomic<EpochRec *>         epochList(0);
+
+EpochRec *getRec()
+{
+   EpochRec *rP;
+
+// Reuse a record left behind by a thread that exited, if any
+//
+   for (rP = epochList.load(std::memory_order_acquire); rP; rP = rP->Next)
+       {bool notUsed = false;
+        if (rP->inUse.compare_exchange_strong(notUsed, true)) return rP;
+       }
+
+// Add a new record. Records are never removed from the list.
+//
+   rP = new EpochRec;
+   rP->Next = epochList.load(std::memory_order_relaxed);
+   while(!epochList.compare_exchange_weak(rP->Next, rP,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {}
+   return rP;
+}
+
+class EpochThread
+{
+public:
+
+EpochRec *Rec() {if (!recP) recP = getRec(); return recP;}
+
+          EpochThread() : recP(0) {}
+         ~EpochThread() {if (recP) recP->inUse.store(false,
+                                                     std::memory_order_release);
+                        }
+private:
+EpochRec *recP;
+};
+
+thread_local EpochThread myEpoch;
+
+void Quiesce()
+{
+   EpochRec *rP;
+   unsigned long long theEpoch, endEpoch = gEpoch.fetch_add(1);
+
+// Wait for each lookup that may have seen the old table entry to end
+//
+   for (rP = epochList.load(std::memory_order_acquire); rP; rP = rP->Next)
+       while((theEpoch = rP->Epoch.load()) && theEpoch <= endEpoch)
+            sched_yield();
+}
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdPosixObject::~XrdPosixObject()
+{
+// Remove ourselves from the table, if need be, and make sure that no lockless
+// lookup can still reference this object.
+//
+   if (fdNum >= 0) Release(this);
+   Quiesce();
+}
+
 /******************************************************************************/
 /*                              A s s i g n F D                               */
 /******************************************************************************/
@@ -79,7 +165,7 @@ bool XrdPosixObject::AssignFD(bool isStream)
 
 // Enter object in out vector of objects and assign it the FD
 //
-   myFiles[fd] = this;
+   __atomic_store_n(&myFiles[fd], this, __ATOMIC_SEQ_CST);
    if (fd > highFD) highFD = fd;
    fdNum  = fd + baseFD;
 
@@ -99,6 +185,13 @@ XrdPosixDir *XrdPosixObject::Dir(int fd, bool glk)
    int  waitCount = 0;
    bool haveLock;
 
+// Try to find the object without using the global lock
+//
+   if (!glk && (oP = Find(fd, haveLock)))
+      {if (oP->Who(&dP)) return dP;
+       oP->UnLock();
+      }
+
 // Validate the fildes
 //
 do{if (fd >= lastFD || fd < baseFD)
@@ -125,11 +218,11 @@ do{if (fd >= lastFD || fd < baseFD)
        continue;
       }
 
-// If the global lock is to be held, then release the object lock as this
-// is a call to destroy the object and there is no need for the local lock.
+// If the global lock is to be held, this is a call to destroy the object. The
+// object lock is kept until the object is removed from the table so that a
+// lockless lookup cannot use it (see Release()).
 //
-   if (glk) oP->UnLock();
-      else  fdMutex.UnLock();
+   if (!glk) fdMutex.UnLock();
    return dP;
   } while(1);
 
@@ -150,6 +243,13 @@ XrdPosixFile *XrdPosixObject::File(int fd, bool glk)
    int  waitCount = 0;
    bool haveLock;
 
+// Try to find the object without using the global lock
+//
+   if (!glk && (oP = Find(fd, haveLock)))
+      {if (oP->Who(&fP)) return fP;
+       oP->UnLock();
+      }
+
 // Validate the fildes
 //
 do{if (fd >= lastFD || fd < baseFD)
@@ -176,11 +276,11 @@ do{if (fd >= lastFD || fd < baseFD)
        continue;
       }
 
-// If the global lock is to be held, then release the object lock as this
-// is a call to destroy the object and there is no need for the local lock.
+// If the global lock is to be held, this is a call to destroy the object. The
+// object lock is kept until the object is removed from the table so that a
+// lockless lookup cannot use it (see Release()).
 //
-   if (glk) oP->UnLock();
-      else  fdMutex.UnLock();
+   if (!glk) fdMutex.UnLock();
    return fP;
   } while(1);
 
@@ -190,6 +290,38 @@ do{if (fd >= lastFD || fd < baseFD)
    return (XrdPosixFile *)0;
 }
 
+/******************************************************************************/
+/* Private:                         F i n d                                   */
+/******************************************************************************/
+
+// Find an object and read lock it without using the global lock. A null
+// pointer is returned if the object could not be found this way, in which case
+// the caller should fall back to a locked lookup.
+
+XrdPosixObject *XrdPosixObject::Find(int fd, bool &busy)
+{
+   EpochRec *rP;
+   XrdPosixObject *oP;
+
+// Validate the fildes
+//
+   busy = false;
+   if (fd >= lastFD || fd < baseFD || !myFiles) return 0;
+
+// Publish our epoch and then get the object. The object cannot be destroyed
+// until we withdraw the epoch.
+//
+   rP = myEpoch.Rec();
+   rP->Epoch.store(gEpoch.load());
+   if ((oP = __atomic_load_n(&myFiles[fd-baseFD], __ATOMIC_SEQ_CST)))
+      {if (!oP->objMutex.CondReadLock()) {busy = true; oP = 0;}
+          else if (__atomic_load_n(&myFiles[fd-baseFD], __ATOMIC_SEQ_CST) != oP)
+                  {oP->UnLock(); oP = 0;}
+      }
+   rP->Epoch.store(0, std::memory_order_release);
+   return oP;
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -253,15 +385,17 @@ void XrdPosixObject::Release(XrdPosixObject *oP, bool needlk)
    if (baseFD)
       {int myFD = oP->fdNum - baseFD;
        if (myFD < freeFD) freeFD = myFD;
-       myFiles[myFD] = 0;
+       __atomic_store_n(&myFiles[myFD], (XrdPosixObject *)0, __ATOMIC_SEQ_CST);
       } else {
-       myFiles[oP->fdNum] = 0;
+       __atomic_store_n(&myFiles[oP->fdNum],(XrdPosixObject *)0,__ATOMIC_SEQ_CST);
        close(oP->fdNum);
       }
 
-// Zorch the object fd and release the global lock
+// Zorch the object fd and release the global lock. If we were called to destroy
+// the object, the object lock is held and may now be released as well.
 //
    oP->fdNum = -1;
+   if (!needlk) oP->UnLock();
    fdMutex.UnLock();
 }
 
@@ -316,7 +450,8 @@ void XrdPosixObject::Shutdown()
    if (myFiles)
       {for (i = 0; i <= highFD; i++) 
            if ((oP = myFiles[i]))
-              {myFiles[i] = 0;
+              {__atomic_store_n(&myFiles[i], (XrdPosixObject *)0,
+                                __ATOMIC_SEQ_CST);
                if (oP->fdNum >= 0) close(oP->fdNum);
                oP->fdNum = -1;
                delete oP;
@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <sys/types.h>
 
 #include "XrdSys/XrdSysAtomics.hh"
@@ -59,15 +60,9 @@ static  int           Init(int numfd);
                               else objMutex.ReadLock();
                           }
 
-        void          Ref()    {AtomicBeg(updMutex);
-                                AtomicInc(refCnt);
-                                AtomicEnd(updMutex);
-                               }
-        int           Refs()   {AtomicRet(updMutex, refCnt);}
-        void          unRef()  {AtomicBeg(updMutex);
-                                AtomicDec(refCnt);
-                                AtomicEnd(updMutex);
-                               }
+        void          Ref()    {refCnt.fetch_add(1, std::memory_order_relaxed);}
+        int           Refs()   {return refCnt.load(std::memory_order_acquire);}
+        void          unRef()  {refCnt.fetch_sub(1, std::memory_order_release);}
 
 static  void          Release(XrdPosixObject *oP, bool needlk=true);
 
@@ -88,16 +83,18 @@ virtual bool          Who(XrdPosixDir  **dirP)  {return false;}
 virtual bool          Who(XrdPosixFile **fileP) {return false;}
 
                       XrdPosixObject() : fdNum(-1), refCnt(0) {}
-virtual              ~XrdPosixObject() {if (fdNum >= 0) Release(this);}
+virtual              ~XrdPosixObject();
 
 protected:
        XrdSysRecMutex   updMutex;
        XrdSysRWLock     objMutex;
        int              fdNum;
-       int              refCnt;
+       std::atomic<int> refCnt;
 
 private:
 
+static XrdPosixObject  *Find(int fd, bool &busy);
+
 static XrdSysMutex      fdMutex;
 static XrdPosixObject **myFiles;
 static int              lastFD;
@@ -95,6 +95,7 @@ bool             p2lSRC    = false;
 bool             p2lSGI    = false;
 bool             autoPGRD  = false;
 bool             usingEC   = false;
+bool             wbCache   = false;
 };
 
 int            XrdPosixXrootd::baseFD    = 0;
@@ -270,6 +271,7 @@ int XrdPosixXrootd::Close(int fildes)
    EPNAME("Close");
    XrdCl::XRootDStatus Status;
    XrdPosixFile *fP;
+   int  rc, wbErr = 0;
    bool ret;
 
 // Map the file number to the file object. In the prcess we relese the file
@@ -284,6 +286,14 @@ int XrdPosixXrootd::Close(int fildes)
 // the caller will get a zero return code should we delay the close.
 //
    fP->Ref();
+
+// A write-back cache may still hold data for this file. It must be written
+// before the detach as that can no longer report a write error. Note that the
+// cache only syncs the file when it actually buffered writes.
+//
+   if (XrdPosixGlobals::wbCache && fP->XCio != (XrdOucCacheIO *)fP
+   &&  (rc = fP->XCio->Sync()) < 0) wbErr = -rc;
+
    if (fP->XCio->Detach((XrdOucCacheIOCD&)*fP) && fP->Refs() < 2)
       {if ((ret = fP->Close(Status))) {delete fP; fP = 0;}
           else if (DEBUGON)
@@ -301,7 +311,9 @@ int XrdPosixXrootd::Close(int fildes)
 
 // Return final result
 //
-   return (ret ? 0 : XrdPosixMap::Result(Status));
+   if (!ret) return XrdPosixMap::Result(Status);
+   if (wbErr) {errno = wbErr; return -1;}
+   return 0;
 }
 
 /******************************************************************************/
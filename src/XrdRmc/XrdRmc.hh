@@ -45,7 +45,15 @@
     2.  The size of the cache is forced to be a multiple PageSize and
         have a minimum size of PageSize * 256.
     3.  The minimum external read size is equal to PageSize.
-    4.  Currently, only write-through caches are supported.
+    4.  Caches are write-through unless writeBack is specified. Then writes
+        to files attached r/w are combined in a per-file buffer of wbSize
+        bytes and written in the background by flush threads once the
+        buffer fills or a non-adjacent write arrives. At most wbLimit bytes
+        are held for all files; files that cannot get a buffer are handled
+        write-through. Buffered data is written before any overlapping read
+        as well as before a truncate, sync, or detach. A failed background
+        write is reported by the next write or sync. Because writes run
+        concurrently with other I/O, writeBack requires ioMTSafe.
     5.  The Max2Cache value avoids placing data in the cache when a read
         exceeds the specified value. The minimum allowed is PageSize, which
         is also the default.
@@ -63,8 +71,10 @@
     10. The default maximum attached files is set to 8192 when isServer
         has been specified. Otherwise, it is set at 256.
     11. When canPreRead is specified, the cache asynchronously handles
-        preread requests (see XrdOucCacheIO::Preread()) using 9 threads
-        when isServer is in effect. Otherwise, 3 threads are used.
+        preread requests (see XrdOucCacheIO::Preread()) using prThreads
+        threads; by default 9 when isServer is in effect and 3 otherwise.
+        The same number of flush threads is started when writeBack is
+        specified.
     12. The max queue depth for prereads is 8. When the max is exceeded
         the oldest preread is discarded to make room for the newest one.
     13. If you specify the canPreRead option when creating the cache you
@@ -104,12 +114,14 @@ struct Parms
        int       MaxFiles;  //!< Maximum number of files    (default 256 or 8K)
        int       Options;   //!< Options as defined below   (default r/o cache)
        short     minPages;  //!< Minimum number of pages    (default 256)
-       short     Reserve1;  //!< Reserved for future use
-       int       Reserve2;  //!< Reserved for future use
+       short     prThreads; //!< Preread and flush threads  (default 3 or 9)
+       int       wbSize;    //!< Write-back buffer size     (default 1MB)
+       long long wbLimit;   //!< Write-back memory limit    (default 64MB)
 
                  Parms() : CacheSize(104857600), PageSize(32768),
                            Max2Cache(0), MaxFiles(0), Options(0),
-                           minPages(0), Reserve1(0),  Reserve2(0) {}
+                           minPages(0), prThreads(0), wbSize(0),
+                           wbLimit(0) {}
       };
 
 // Valid option values in Parms::Options
@@ -126,6 +138,9 @@ canPreRead   = 0x0040; //!< Enable pre-read operations (o/w ignored)
 static const int
 logStats     = 0x0080; //!< Display statistics upon detach
 
+static const int
+writeBack    = 0x0100; //!< Combine and write r/w data in the background
+
 static const int
 Serialized   = 0x0004; //!< Caller ensures MRSW semantics
 
@@ -42,7 +42,7 @@
 XrdRmcData::XrdRmcData(XrdRmcReal *cP, XrdOucCacheIO *ioP,
                        long long   vn, int            opts)
                       : pPLock(0), rPLock(0),  wPLock(0),
-                        Cache(cP), ioObj(ioP), VNum(vn)
+                        Cache(cP), ioObj(ioP), VNum(vn), wbCond(0)
 {
 // We need to map the cache options to our local options
 //
@@ -75,6 +75,16 @@ XrdRmcData::XrdRmcData(XrdRmcReal *cP, XrdOucCacheIO *ioP,
    prPerf     = 0;
    prCalc     = Apr.prRecalc;
 
+// Initialize the write-back area. Buffers are only obtained upon first write.
+//
+   wbReq.Data = this;
+   wbMem  = wbBuff = wfBuff = 0;
+   wbOffs = wbLim  = wfOffs = 0;
+   wbLen  = wfLen  = wbErr  = 0;
+   wbSize = Cache->wbSize;
+   wbOK   = (isRW && wbSize ? 1 : 0);
+   wfBusy = 0;
+
 // Establish serialization options
 //
    if (Cache->Options & XrdRmc::ioMTSafe) pPLopt = rPLopt = xs_Shared;
@@ -96,7 +106,13 @@ XrdRmcData::XrdRmcData(XrdRmcReal *cP, XrdOucCacheIO *ioP,
 
 bool XrdRmcData::Detach(XrdOucCacheIOCD &iocd)
 {
-   int delOK;
+   int delOK, rc;
+
+// Write out any buffered data. As we cannot return an error, we report it.
+//
+   if (wbMem && (rc = wbDrain(0, -1)))
+      std::cerr <<"Cache: Error " <<rc <<" writing buffered data; path="
+                <<ioObj->Path() <<std::endl;
 
 // We must wait for any pre-reads to stop at this point. TO DO: We really
 // should run this in a sperate thread and use the callback mechanism.
@@ -139,6 +155,7 @@ bool XrdRmcData::Detach(XrdOucCacheIOCD &iocd)
                           ioObj->Path());
            std::cerr <<sBuff;
           }
+       if (wbMem) Cache->wbFree(wbMem);
        delete this;
        return true;
       }
@@ -181,6 +198,8 @@ do{if ((oVal = prOpt[prNext]))
                            <<(segEnd-segBeg+1)*SegSize <<'@' <<(segBeg*SegSize)
                            <<" f=" <<int(oVal) <<' ' <<ioObj->Path() <<std::endl;
        DMutex.UnLock();
+       if (wbMem && wbHas(segBeg << SegShft, (segEnd-segBeg+1) << SegShft))
+          {DMutex.Lock(); continue;}
        oVal = (oVal == prSUSE ? XrdRmcSlot::isSUSE : 0) | XrdRmcSlot::isNew;
        segBeg |= VNum; segEnd |= VNum;
        do {if ((cBuff = Cache->Get(ioObj, segBeg, rLen, noIO)))
@@ -248,6 +267,30 @@ void XrdRmcData::Preread(aprParms &Parms)
       }
 }
 
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+void XrdRmcData::Flush()
+{
+   int rc;
+
+// Write out the queued buffer. Nobody touches it while wfBusy is set.
+//
+   if ((rc = ioObj->Write(wfBuff, wfOffs, wfLen)) != wfLen)
+      {if (rc >= 0) rc = -EIO;
+       Cache->eMsg(ioObj->Path(), "writing", wfOffs, wfLen, rc);
+      } else rc = 0;
+
+// Record the first error and tell anyone waiting that the buffer is free
+//
+   wbCond.Lock();
+   if (rc && !wbErr) wbErr = rc;
+   wfBusy = 0;
+   wbCond.Broadcast();
+   wbCond.UnLock();
+}
+
 /******************************************************************************/
 /*                               Q u e u e P R                                */
 /******************************************************************************/
@@ -358,6 +401,13 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
        return 0;
       }
 
+// Make sure that buffered data in any page we may read has been written
+//
+   if (wbMem)
+      {long long pBeg = Offs & ~OffMask, pEnd = (Offs+rLen+OffMask) & ~OffMask;
+       wbDrain(pBeg, pEnd - pBeg);
+      }
+
 // Ignore caching it if it's too large. Use alternate read algorithm.
 //
    if (rLen > maxCache) return Read(Now, Buff, Offs, rLen);
@@ -507,6 +557,25 @@ int XrdRmcData::setAPR(aprParms &Dest, aprParms &Src, int pSize)
    return (Dest.minPages > 0 && Dest.Trigger > 1);
 }
 
+/******************************************************************************/
+/*                                  S y n c                                   */
+/******************************************************************************/
+
+int XrdRmcData::Sync()
+{
+   MrSw EnforceMrSw(wPLock, xs_Exclusive);
+   int rc;
+
+// Without buffered writes there is nothing to do as all data was written
+//
+   if (!wbMem) return 0;
+
+// Write out all buffered data and then sync the underlying file
+//
+   if ((rc = wbDrain(0, -1))) return rc;
+   return ioObj->Sync();
+}
+
 /******************************************************************************/
 /*                                 T r u n c                                  */
 /******************************************************************************/
@@ -514,12 +583,17 @@ int XrdRmcData::setAPR(aprParms &Dest, aprParms &Src, int pSize)
 int XrdRmcData::Trunc(long long Offs)
 {
    MrSw EnforceMrSw(wPLock, xs_Exclusive);
+   int rc;
 
 // Verify that we can modify this cache and the trunc offset
 //
    if (!isRW) return -EROFS;
    if (Offs > XrdRmcReal::MaxFO || Offs < 0) return -EOVERFLOW;
 
+// Buffered data must be written before the file is truncated
+//
+   if (wbMem && (rc = wbDrain(0, -1))) return rc;
+
 // Get the segment pointer and truncate pages from the cache
 //
    Cache->Trunc(ioObj, (Offs >> SegShft) | VNum);
@@ -549,10 +623,13 @@ int XrdRmcData::Write(char *Buff, long long Offs, int wLen)
    if (XrdRmcReal::MaxFO <  Offs || Offs < 0
    ||  XrdRmcReal::MaxFO < (Offs + wLen)) return -EOVERFLOW;
 
-// First step is to write out all the data (write-through for now)
+// First step is to write out all the data. It is either buffered, to be written
+// later, or written through when it cannot be buffered.
 //
-   if ((wAmt = ioObj->Write(Buff, Offs, wLen)) != wLen)
-      return (wAmt < 0 ? wAmt : -EIO);
+   if (!wbOK || (wAmt = wbWrite(Buff, Offs, wLen)) > 0)
+      {if ((wAmt = ioObj->Write(Buff, Offs, wLen)) != wLen)
+          return (wAmt < 0 ? wAmt : -EIO);
+      } else if (wAmt < 0) return wAmt;
    Now.X.BytesWrite = wLen;
 
 // Get the segment pointer, offset and the initial write amount
@@ -581,3 +658,101 @@ do{if (!(cBuff = Cache->Get(0, segNum, rGot, noIO))) Now.X.Miss++;
    Statistics.Add(Now);
    return wLen;
 }
+
+/******************************************************************************/
+/*                               w b D r a i n                                */
+/******************************************************************************/
+
+// Write out buffered data overlapping Offs for Len bytes (all if Len < 0) and
+// wait for it to be written. Returns the first background write error, if any.
+
+int XrdRmcData::wbDrain(long long Offs, long long Len)
+{
+   XrdSysCondVarHelper wbHelp(wbCond);
+
+   if (wbLen && (Len < 0 || (Offs < wbOffs+wbLen && Offs+Len > wbOffs)))
+      wbQueue();
+   if (Len < 0 || (Offs < wfOffs+wfLen && Offs+Len > wfOffs))
+      while(wfBusy) wbCond.Wait();
+   return wbErr;
+}
+
+/******************************************************************************/
+/*                                 w b H a s                                  */
+/******************************************************************************/
+
+bool XrdRmcData::wbHas(long long Offs, long long Len)
+{
+   XrdSysCondVarHelper wbHelp(wbCond);
+
+   return (wbLen  && Offs < wbOffs+wbLen && Offs+Len > wbOffs)
+       || (wfBusy && Offs < wfOffs+wfLen && Offs+Len > wfOffs);
+}
+
+/******************************************************************************/
+/*                               w b Q u e u e                                */
+/******************************************************************************/
+
+// The caller must hold the wbCond lock.
+
+void XrdRmcData::wbQueue()
+{
+   char *bP;
+
+// Only one buffer may be in flight so that writes occur in the order issued.
+// So, wait for the previous one to complete before swapping buffers.
+//
+   if (!wbLen) return;
+   while(wfBusy) wbCond.Wait();
+   bP = wfBuff; wfBuff = wbBuff; wbBuff = bP;
+   wfOffs = wbOffs; wfLen = wbLen; wbLen = 0; wfBusy = 1;
+   Cache->Flush(&wbReq);
+}
+
+/******************************************************************************/
+/*                               w b W r i t e                                */
+/******************************************************************************/
+
+// Returns 0 if the data was buffered, 1 if the caller must write it through,
+// and -errno if a background write failed.
+
+int XrdRmcData::wbWrite(char *Buff, long long Offs, int wLen)
+{
+   XrdSysCondVarHelper wbHelp(wbCond);
+   int n;
+
+// Report any failed background write
+//
+   if (wbErr) return wbErr;
+
+// Get buffers upon first use. If there are none, this file is written through.
+//
+   if (!wbMem)
+      {if (!(wbMem = Cache->wbAlloc())) {wbOK = 0; return 1;}
+       wbBuff = wbMem; wfBuff = wbMem + wbSize;
+      }
+
+// Large writes gain nothing from buffering. Write out everything before them
+// so that the order of writes is preserved and have the caller write through.
+//
+   if (wLen >= wbSize)
+      {wbQueue();
+       while(wfBusy) wbCond.Wait();
+       return (wbErr ? wbErr : 1);
+      }
+
+// Copy the data into the buffer. A buffer only holds data up to the next
+// multiple of the buffer size so that full buffers are written aligned. Data
+// that is not adjacent to what was buffered forces the buffer to be written.
+//
+   while(wLen > 0)
+        {if (wbLen && (Offs < wbOffs || Offs > wbOffs+wbLen)) wbQueue();
+         if (!wbLen) {wbOffs = Offs; wbLim = (Offs/wbSize + 1) * wbSize;}
+         n = (wbLim - Offs < wLen ? static_cast<int>(wbLim - Offs) : wLen);
+         memcpy(wbBuff + (Offs - wbOffs), Buff, n);
+         if (Offs + n - wbOffs > wbLen) wbLen = static_cast<int>(Offs+n-wbOffs);
+         Buff += n; Offs += n; wLen -= n;
+         if (wbOffs + wbLen >= wbLim) wbQueue();
+        }
+   return 0;
+}
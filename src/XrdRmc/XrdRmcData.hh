@@ -59,7 +59,7 @@ int            Read (char  *Buffer, long long  Offset, int  Length);
 
 static int     setAPR(aprParms &Dest, aprParms &Src, int pSize);
 
-int            Sync() {return 0;} // We only support write-through for now
+int            Sync();
 
 int            Trunc(long long Offset);
 
@@ -69,10 +69,16 @@ int            Write(char  *Buffer, long long  Offset,  int  Length);
                            long long    vn, int            opts);
 
 private:
+friend class XrdRmcReal;
               ~XrdRmcData() {}
+void           Flush();
 void           QueuePR(long long SegOffs, int rLen, int prHow, int isAuto=0);
 int            Read (XrdOucCacheStats &Now,
                      char *Buffer, long long Offs, int Length);
+int            wbDrain(long long Offs, long long Len);
+bool           wbHas(long long Offs, long long Len);
+void           wbQueue();
+int            wbWrite(char *Buffer, long long Offset, int Length);
 
 // The following is for read/write support
 //
@@ -148,5 +154,23 @@ char             prOpt[prMax];
 char             prOK;
 char             prActive;
 char             prAuto;
+
+// Write-back Control Area (protected by wbCond). Data is combined in wbBuff
+// and written from wfBuff; the buffers are swapped when wbBuff is queued.
+//
+XrdRmcReal::prTask wbReq;
+XrdSysCondVar    wbCond;
+char            *wbMem;          // Memory for both buffers, 0 if not yet had
+char            *wbBuff;         // Buffer being filled
+char            *wfBuff;         // Buffer being written
+long long        wbOffs;         // File offset of wbBuff data
+long long        wbLim;          // File offset at which wbBuff is full
+long long        wfOffs;         // File offset of wfBuff data
+int              wbLen;          // Bytes in wbBuff
+int              wfLen;          // Bytes in wfBuff
+int              wbSize;         // Size of each buffer
+int              wbErr;          // First background write error (-errno)
+char             wbOK;           // Write-back may be used for this file
+char             wfBusy;         // wfBuff is being written
 };
 #endif
@@ -54,16 +54,24 @@ void *XrdRmcRealPRXeq(void *parg)
     cP->PreRead();
     return (void *)0;
 }
+
+void *XrdRmcRealWBXeq(void *parg)
+{   XrdRmcReal *cP = (XrdRmcReal *)parg;
+    cP->Flusher();
+    return (void *)0;
+}
   
 XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
                        XrdOucCacheIO::aprParms *aprP)
                 : XrdOucCache("rmc"),
                   Slots(0), Slash(0), Base((char *)MAP_FAILED), Dbg(0), Lgs(0),
                   AZero(0), Attached(0), prFirst(0), prLast(0),
-                  prReady(0), prStop(0), prNum(0)
+                  prReady(0), prStop(0), prNum(0), wbFirst(0), wbLast(0),
+                  wbReady(0), wbStop(0), wbNum(0), wbSize(0), wbAvail(0)
 {
    size_t Bytes;
    int n, minPag, isServ = ParmV.Options & XrdRmc::isServer;
+   int thdNum = (ParmV.prThreads > 0 ? ParmV.prThreads : (isServ ? 9 : 3));
 
 // Copy over options
 //
@@ -133,7 +141,7 @@ XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
 //
    if (Options & XrdRmc::canPreRead)
       {pthread_t tid;
-       n = (Options & XrdRmc::isServer ? 9 : 3);
+       n = thdNum;
        while(n--)
             {if (XrdSysThread::Run(&tid, XrdRmcRealPRXeq, (void *)this,
                                    0, "Prereader")) break;
@@ -142,6 +150,27 @@ XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
        if (aprP && prNum) XrdRmcData::setAPR(aprDefault, *aprP, SegSize);
       }
 
+// Setup the flushers if write-back is enabled. The buffer size is rounded up
+// to a page multiple so that combined writes are page aligned. Write-back is
+// only possible if two buffers fit within the limit.
+//
+   if ((Options & XrdRmc::writeBack) && (Options & XrdRmc::ioMTSafe))
+      {pthread_t tid;
+       long long wbSz = (ParmV.wbSize > 0 ? ParmV.wbSize : 1048576);
+       if (wbSz > 0x40000000) wbSz = 0x40000000;
+       wbSz = (wbSz + OffMask) & ~OffMask;
+       wbAvail = (ParmV.wbLimit > 0 ? ParmV.wbLimit : 67108864);
+       if (wbAvail >= wbSz*2)
+          {n = thdNum;
+           while(n--)
+                {if (XrdSysThread::Run(&tid, XrdRmcRealWBXeq, (void *)this,
+                                       0, "Flusher")) break;
+                 wbNum++;
+                }
+           if (wbNum) wbSize = static_cast<int>(wbSz);
+          }
+      }
+
 // All done
 //
    rc = 0;
@@ -176,6 +205,17 @@ XrdRmcReal::~XrdRmcReal()
        prMutex.Lock();
       }
 
+// Likewise, stop the flushers. All buffered data was written at detach time.
+//
+   if (wbNum)
+      {XrdSysSemaphore wbDone(0);
+       wbStop = &wbDone;
+       wbReady.Post();
+       prMutex.UnLock();
+       wbDone.Wait();
+       prMutex.Lock();
+      }
+
 // Delete the slots
 //
    delete Slots; Slots = 0;
@@ -302,6 +342,57 @@ void XrdRmcReal::eMsg(const char *Path, const char *What, long long xOff,
       }
 }
   
+/******************************************************************************/
+/*                               F l u s h e r                                */
+/******************************************************************************/
+  
+void XrdRmcReal::Flusher()
+{
+   prTask *wbP;
+
+// Simply wait and dispatch elements
+//
+   if (Dbg) std::cerr <<"Cache: flush thread started; now " <<wbNum <<std::endl;
+   while(1)
+        {wbReady.Wait();
+         prMutex.Lock();
+         if (wbStop) break;
+         if ((wbP = wbFirst))
+            {if (!(wbFirst = wbP->Next)) wbLast = 0;
+             prMutex.UnLock();
+             wbP->Data->Flush();
+            } else prMutex.UnLock();
+        }
+
+// The cache is being deleted, wind down the flushers
+//
+   wbNum--;
+   if (wbNum > 0) wbReady.Post();
+      else        wbStop->Post();
+   if (Dbg) std::cerr <<"Cache: flush thread exited; left " <<wbNum <<std::endl;
+   prMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+void XrdRmcReal::Flush(XrdRmcReal::prTask *wbReq)
+{
+
+// Place this element on the queue
+//
+   prMutex.Lock();
+   if (wbLast) {wbLast->Next = wbReq; wbLast = wbReq;}
+      else      wbLast = wbFirst = wbReq;
+   wbReq->Next = 0;
+
+// Tell a flusher that something is ready
+//
+   wbReady.Post();
+   prMutex.UnLock();
+}
+
 /******************************************************************************/
 /*                                   G e t                                    */
 /******************************************************************************/
@@ -598,3 +689,38 @@ void XrdRmcReal::Upd(char *Addr, int wLen, int wOff)
                      <<" uc " <<sP->Status.inUse <<std::endl;
    CMutex.UnLock();
 }
+
+/******************************************************************************/
+/*                               w b A l l o c                                */
+/******************************************************************************/
+
+char *XrdRmcReal::wbAlloc()
+{
+   void *wbMem;
+
+// Reserve memory for two buffers (one being filled, one being written)
+//
+   CMutex.Lock();
+   if (!wbSize || wbAvail < static_cast<long long>(wbSize)*2)
+      {CMutex.UnLock(); return 0;}
+   wbAvail -= static_cast<long long>(wbSize)*2;
+   CMutex.UnLock();
+
+// Allocate page aligned memory, undo the reservation if we failed
+//
+   if (posix_memalign(&wbMem, 4096, static_cast<size_t>(wbSize)*2))
+      {wbFree(0); return 0;}
+   return (char *)wbMem;
+}
+
+/******************************************************************************/
+/*                                w b F r e e                                 */
+/******************************************************************************/
+
+void XrdRmcReal::wbFree(char *wbMem)
+{
+   if (wbMem) free(wbMem);
+   CMutex.Lock();
+   wbAvail += static_cast<long long>(wbSize)*2;
+   CMutex.UnLock();
+}
@@ -49,6 +49,8 @@ XrdOucCacheIO *Attach(XrdOucCacheIO *ioP, int Options=0);
 
               ~XrdRmcReal();
 
+void           Flusher();
+
 void           PreRead();
 
 private:
@@ -78,6 +80,8 @@ int       ioLookup(int &pip, int hip, void *kval)
 int       Ref(char *Addr, int rAmt, int sFlags=0);
 void      Trunc(XrdOucCacheIO *ioP, long long lAddr);
 void      Upd(char *Addr, int wAmt, int wOff);
+char     *wbAlloc();
+void      wbFree(char *wbMem);
 
 static const long long Shift = 48;
 static const long long Strip = 0x00000000ffffffffLL;  //
@@ -130,5 +134,18 @@ XrdSysMutex      prMutex;
 XrdSysSemaphore  prReady;
 XrdSysSemaphore *prStop;
 int              prNum;
+
+// This is the write-back control area. Flush requests use their own threads
+// so that a writer waiting for a flush never waits behind a blocked preread.
+// The flush queue is protected by prMutex and the memory limit by CMutex.
+//
+void             Flush(XrdRmcReal::prTask *wbReq);
+prTask          *wbFirst;
+prTask          *wbLast;
+XrdSysSemaphore  wbReady;
+XrdSysSemaphore *wbStop;
+int              wbNum;
+int              wbSize;      // Size of each write-back buffer (0 -> none)
+long long        wbAvail;     // Bytes still available for buffers
 };
 #endif
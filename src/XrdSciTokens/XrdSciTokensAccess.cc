@@ -1,5 +1,6 @@
 
 #include "XrdAcc/XrdAccAuthorize.hh"
+#include "XrdAcc/XrdAccPrefixTrie.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucGatherConf.hh"
 #include "XrdSec/XrdSecEntity.hh"
@@ -7,10 +8,16 @@
 #include "XrdSys/XrdSysLogger.hh"
 #include "XrdVersion.hh"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sstream>
 #include <fstream>
@@ -347,20 +354,28 @@ public:
     ~XrdAccRules() {}
 
     bool apply(Access_Operation oper, std::string path) {
-        for (const auto & rule : m_rules) {
-            if ((oper == rule.first) && !path.compare(0, rule.second.size(), rule.second, 0, rule.second.size())) {
-                return true;
-            }
-        }
-        return false;
+        const unsigned int oper_bit = 1U << oper;
+        bool allowed = false;
+        m_paths.Match(path.c_str(), path.size(), [&](unsigned int opers) {
+            allowed = (opers & oper_bit) != 0;
+            return !allowed;
+        });
+        return allowed;
     }
 
     bool expired() const {return monotonic_time() > m_expiry_time;}
 
+        // Returns true exactly once for the caller that should refresh these
+        // rules because they are about to expire.
+    bool claim_refresh(uint64_t now, uint64_t window) {
+        return now + window >= m_expiry_time && !m_refreshing.exchange(true);
+    }
+
     void parse(const AccessRulesRaw &rules) {
         m_rules.reserve(rules.size());
         for (const auto &entry : rules) {
             m_rules.emplace_back(entry.first, entry.second);
+            m_paths.Add(entry.second.c_str(), entry.second.size()) |= 1U << entry.first;
         }
     }
 
@@ -407,7 +422,9 @@ public:
 
 private:
     AccessRulesRaw m_rules;
+    XrdAccPrefixTrie<unsigned int> m_paths;
     uint64_t m_expiry_time{0};
+    std::atomic<bool> m_refreshing{false};
     const std::string m_username;
     const std::string m_token_subject;
     const std::string m_issuer;
@@ -445,6 +462,14 @@ public:
     }
 
     virtual ~XrdAccSciTokens() {
+        {
+            std::lock_guard<std::mutex> guard(m_refresh_mutex);
+            m_refresh_stop = true;
+        }
+        m_refresh_cv.notify_one();
+        if (m_refresh_thread.joinable()) {
+            m_refresh_thread.join();
+        }
         if (m_config_lock_initialized) {
             pthread_rwlock_destroy(&m_config_lock);
         }
@@ -474,44 +499,11 @@ public:
             return OnMissing(Entity, path, oper, env);
         }
         m_log.Log(LogMask::Debug, "Access", "Trying token-based access control");
-        std::shared_ptr<XrdAccRules> access_rules;
         uint64_t now = monotonic_time();
         Check(now);
-        {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            const auto iter = m_map.find(authz);
-            if (iter != m_map.end() && !iter->second->expired()) {
-                access_rules = iter->second;
-            }
-        }
+        std::shared_ptr<XrdAccRules> access_rules = GetRules(authz, now);
         if (!access_rules) {
-            m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
-            try {
-		uint64_t cache_expiry;
-		AccessRulesRaw rules;
-                std::string username;
-                std::string token_subject;
-                std::string issuer;
-                std::vector<MapRule> map_rules;
-                std::vector<std::string> groups;
-                if (GenerateAcls(authz, cache_expiry, rules, username, token_subject, issuer, map_rules, groups)) {
-                    access_rules.reset(new XrdAccRules(now + cache_expiry, username, token_subject, issuer, map_rules, groups));
-                    access_rules->parse(rules);
-                } else {
-                    m_log.Log(LogMask::Warning, "Access", "Failed to generate ACLs for token");
-                    return OnMissing(Entity, path, oper, env);
-                }
-                if (m_log.getMsgMask() & LogMask::Debug) {
-                    m_log.Log(LogMask::Debug, "Access", "New valid token", access_rules->str().c_str());
-                }
-            } catch (std::exception &exc) {
-                m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
-                return OnMissing(Entity, path, oper, env);
-            }
-            std::lock_guard<std::mutex> guard(m_mutex);
-            m_map[authz] = access_rules;
-        } else if (m_log.getMsgMask() & LogMask::Debug) {
-            m_log.Log(LogMask::Debug, "Access", "Cached token", access_rules->str().c_str());
+            return OnMissing(Entity, path, oper, env);
         }
 
         // Strategy: we populate the name in the XrdSecEntity if:
@@ -703,6 +695,144 @@ private:
         return XrdAccPriv_None;
     }
 
+    // Parse a token into its access rules; returns nullptr on failure.
+    std::shared_ptr<XrdAccRules> ParseRules(const std::string &authz, uint64_t now)
+    {
+        std::shared_ptr<XrdAccRules> access_rules;
+        uint64_t cache_expiry;
+        AccessRulesRaw rules;
+        std::string username;
+        std::string token_subject;
+        std::string issuer;
+        std::vector<MapRule> map_rules;
+        std::vector<std::string> groups;
+        bool success = false;
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            if ((success = GenerateAcls(authz, cache_expiry, rules, username, token_subject, issuer, map_rules, groups))) {
+                access_rules.reset(new XrdAccRules(now + cache_expiry, username, token_subject, issuer, map_rules, groups));
+                access_rules->parse(rules);
+            } else {
+                m_log.Log(LogMask::Warning, "Access", "Failed to generate ACLs for token");
+            }
+        } catch (std::exception &exc) {
+            m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
+            access_rules.reset();
+            success = false;
+        }
+        auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        m_stats.verifies++;
+        m_stats.verify_usecs += usecs;
+        uint64_t max_usecs = m_stats.verify_max_usecs;
+        while (static_cast<uint64_t>(usecs) > max_usecs &&
+               !m_stats.verify_max_usecs.compare_exchange_weak(max_usecs, usecs)) {}
+        if (!success) {
+            m_stats.failures++;
+        } else if (m_log.getMsgMask() & LogMask::Debug) {
+            m_log.Log(LogMask::Debug, "Access", "New valid token", access_rules->str().c_str());
+        }
+        return access_rules;
+    }
+
+    // Find the rules for a token, parsing it if need be. Only one thread parses
+    // a given token; any others asking for it at the same time wait for that
+    // result. Rules about to expire are re-parsed in the background so that
+    // busy tokens never have to wait for verification.
+    std::shared_ptr<XrdAccRules> GetRules(const std::string &authz, uint64_t now)
+    {
+        auto &shard = m_shards[std::hash<std::string>()(authz) % m_shard_count];
+        std::unique_lock<std::mutex> guard(shard.m_mutex);
+
+        const auto iter = shard.m_map.find(authz);
+        if (iter != shard.m_map.end() && !iter->second->expired()) {
+            auto access_rules = iter->second;
+            guard.unlock();
+            m_stats.hits++;
+            if (access_rules->claim_refresh(now, m_refresh_secs)) {
+                Refresh(authz);
+            }
+            if (m_log.getMsgMask() & LogMask::Debug) {
+                m_log.Log(LogMask::Debug, "Access", "Cached token", access_rules->str().c_str());
+            }
+            return access_rules;
+        }
+
+        const auto pending = shard.m_pending.find(authz);
+        if (pending != shard.m_pending.end()) {
+            auto parse = pending->second;
+            m_stats.waits++;
+            m_log.Log(LogMask::Debug, "Access", "Token is being parsed; waiting for result.");
+            parse->m_cv.wait(guard, [&parse] {return parse->m_done;});
+            return parse->m_rules;
+        }
+
+        m_stats.misses++;
+        auto parse = std::make_shared<PendingParse>();
+        shard.m_pending[authz] = parse;
+        guard.unlock();
+
+        m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
+        auto access_rules = ParseRules(authz, now);
+
+        guard.lock();
+        if (access_rules) {
+            shard.m_map[authz] = access_rules;
+        }
+        shard.m_pending.erase(authz);
+        parse->m_rules = access_rules;
+        parse->m_done = true;
+        guard.unlock();
+        parse->m_cv.notify_all();
+        return access_rules;
+    }
+
+    // Queue a token whose cached rules are about to expire for re-parsing by
+    // the refresh thread. Should the queue be full or the refresh fail, the
+    // current rules simply expire and the next request re-parses.
+    void Refresh(const std::string &authz)
+    {
+        std::lock_guard<std::mutex> guard(m_refresh_mutex);
+        if (m_refresh_queue.size() >= m_refresh_max) {
+            m_stats.refresh_drops++;
+            return;
+        }
+        if (!m_refresh_thread.joinable()) {
+            try {
+                m_refresh_thread = std::thread(&XrdAccSciTokens::Refresher, this);
+            } catch (std::exception &exc) {
+                m_log.Log(LogMask::Warning, "Access", "Unable to start token refresh thread", exc.what());
+                return;
+            }
+        }
+        m_refresh_queue.push_back(authz);
+        m_refresh_cv.notify_one();
+    }
+
+    // The refresh thread; tokens are re-parsed one at a time.
+    void Refresher()
+    {
+        std::unique_lock<std::mutex> guard(m_refresh_mutex);
+        while (true) {
+            m_refresh_cv.wait(guard, [this] {return m_refresh_stop || !m_refresh_queue.empty();});
+            if (m_refresh_stop) {return;}
+            std::string authz = std::move(m_refresh_queue.front());
+            m_refresh_queue.pop_front();
+            guard.unlock();
+
+            auto access_rules = ParseRules(authz, monotonic_time());
+            if (access_rules) {
+                auto &shard = m_shards[std::hash<std::string>()(authz) % m_shard_count];
+                std::lock_guard<std::mutex> shard_guard(shard.m_mutex);
+                shard.m_map[authz] = access_rules;
+                m_stats.refreshes++;
+            }
+            guard.lock();
+        }
+    }
+
     bool GenerateAcls(const std::string &authz, uint64_t &cache_expiry, AccessRulesRaw &rules, std::string &username, std::string &token_subject, std::string &issuer, std::vector<MapRule> &map_rules, std::vector<std::string> &groups) {
         // Does this look like a JWT?  If not, bail out early and
         // do not pollute the log.
@@ -1217,36 +1347,93 @@ private:
     void Check(uint64_t now)
     {
         if (now <= m_next_clean) {return;}
-        std::lock_guard<std::mutex> guard(m_mutex);
-
-        for (auto iter = m_map.begin(); iter != m_map.end(); ) {
-            if (iter->second->expired()) {
-                iter = m_map.erase(iter);
-            } else {
-                ++iter;
+        std::unique_lock<std::mutex> guard(m_mutex, std::try_to_lock);
+        if (!guard.owns_lock() || now <= m_next_clean) {return;}
+
+        size_t entries = 0;
+        for (auto &shard : m_shards) {
+            std::lock_guard<std::mutex> shard_guard(shard.m_mutex);
+            for (auto iter = shard.m_map.begin(); iter != shard.m_map.end(); ) {
+                if (iter->second->expired()) {
+                    iter = shard.m_map.erase(iter);
+                } else {
+                    ++iter;
+                }
             }
+            entries += shard.m_map.size();
+        }
+
+        if (m_log.getMsgMask() & LogMask::Info) {
+            uint64_t verifies = m_stats.verifies;
+            std::stringstream ss;
+            ss << "entries=" << entries << ", hits=" << m_stats.hits
+               << ", misses=" << m_stats.misses << ", waits=" << m_stats.waits
+               << ", refreshes=" << m_stats.refreshes << ", refresh_drops=" << m_stats.refresh_drops
+               << ", verifies=" << verifies
+               << ", failures=" << m_stats.failures << ", verify_avg_us="
+               << (verifies ? m_stats.verify_usecs / verifies : 0)
+               << ", verify_max_us=" << m_stats.verify_max_usecs;
+            m_log.Log(LogMask::Info, "Check", "Token cache statistics:", ss.str().c_str());
         }
         Reconfig();
 
         m_next_clean = monotonic_time() + m_expiry_secs;
     }
 
+    // A token being parsed; threads wanting the same token wait for it.
+    struct PendingParse
+    {
+        std::condition_variable m_cv;
+        std::shared_ptr<XrdAccRules> m_rules;
+        bool m_done{false};
+    };
+
+    struct CacheShard
+    {
+        std::mutex m_mutex;
+        std::unordered_map<std::string, std::shared_ptr<XrdAccRules>> m_map;
+        std::unordered_map<std::string, std::shared_ptr<PendingParse>> m_pending;
+    };
+
+    struct CacheStats
+    {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> waits{0};
+        std::atomic<uint64_t> refreshes{0};
+        std::atomic<uint64_t> refresh_drops{0};
+        std::atomic<uint64_t> verifies{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> verify_usecs{0};
+        std::atomic<uint64_t> verify_max_usecs{0};
+    };
+
+    static constexpr size_t m_shard_count = 16;
+
     bool m_config_lock_initialized{false};
     std::mutex m_mutex;
     pthread_rwlock_t m_config_lock;
     std::vector<std::string> m_audiences;
     std::vector<const char *> m_audiences_array;
-    std::map<std::string, std::shared_ptr<XrdAccRules>> m_map;
+    CacheShard m_shards[m_shard_count];
+    CacheStats m_stats;
+    std::mutex m_refresh_mutex;
+    std::condition_variable m_refresh_cv;
+    std::deque<std::string> m_refresh_queue;
+    std::thread m_refresh_thread;
+    bool m_refresh_stop{false};
     XrdAccAuthorize* m_chain;
     const std::string m_parms;
     std::vector<const char*> m_valid_issuers_array;
     std::unordered_map<std::string, IssuerConfig> m_issuers;
-    uint64_t m_next_clean{0};
+    std::atomic<uint64_t> m_next_clean{0};
     XrdSysError m_log;
     AuthzBehavior m_authz_behavior{AuthzBehavior::PASSTHROUGH};
     std::string m_cfg_file;
 
     static constexpr uint64_t m_expiry_secs = 60;
+    static constexpr uint64_t m_refresh_secs = 10;
+    static constexpr size_t m_refresh_max = 1024;
 };
 
 void InitAccSciTokens(XrdSysLogger *lp, const char *cfn, const char *parm,
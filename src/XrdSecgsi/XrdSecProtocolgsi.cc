@@ -36,6 +36,7 @@
 #include <pwd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <fcntl.h>
 #include <dirent.h>
 #include <iostream>
@@ -192,6 +193,7 @@ XrdSutCache  XrdSecProtocolgsi::cacheCert(8,13); // Server certificates info cac
 XrdSutCache  XrdSecProtocolgsi::cachePxy(8,13);  // Client proxies cache (Fibonacci-based sizes)
 XrdSutCache  XrdSecProtocolgsi::cacheGMAPFun; // Entries mapped by GMAPFun (default size 144)
 XrdSutCache  XrdSecProtocolgsi::cacheAuthzFun; // Entities filled by AuthzFun (default size 144)
+XrdSutCache  XrdSecProtocolgsi::cacheChain; // Client chains already verified (default size 144)
 //
 // Services
 XrdOucGMap *XrdSecProtocolgsi::servGMap = 0; // Grid map service
@@ -3851,12 +3853,7 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
    //
    // Verify the chain
    x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      cmsg = "certificate chain verification failed: ";
-      cmsg += hs->Chain->LastError();
-      return -1;
-   }
+   if (!VerifyChain(bck, &vopt, cmsg)) return -1;
 
    //
    // Extract the client public key from the certificate
@@ -3959,6 +3956,140 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
    return 0;
 }
 
+//_________________________________________________________________________
+static bool ChainCheck(XrdSutCacheEntry *e, void *a) {
+
+   int st_ref = (*((XrdSutCacheArg_t *)a)).arg1;
+   time_t ts_ref = (time_t)(*((XrdSutCacheArg_t *)a)).arg2;
+
+   // Entries hold the time at which the verification becomes stale
+   return (e && e->status == st_ref && ts_ref < e->mtime);
+}
+
+//_________________________________________________________________________
+static bool ChainStale(XrdSutCacheEntry *e, void *a) {
+
+   time_t ts_ref = *((time_t *)a);
+
+   // Entries that failed, are being dropped or expired
+   return (!e || e->status != kCE_ok || ts_ref >= e->mtime);
+}
+
+//_________________________________________________________________________
+bool XrdSecProtocolgsi::VerifyChain(XrdSutBucket *bck,
+                                    x509ChainVerifyOpt_t *vopt, String &cmsg)
+{
+   // Server side: verify the chain received from the client in 'bck' and
+   // parsed into hs->Chain. Pilots present the same proxy chain over and
+   // over, so we remember chains that verified against a given CA and CRL
+   // until the first certificate or the CRL expires. Concurrent logins with
+   // the same chain wait for the first one to verify it.
+   // Return true on success. If the case, a message is returned in cmsg.
+   EPNAME("VerifyChain");
+   static XrdSysMutex statMtx;
+   static long long nHits = 0, nVerify = 0, vTotal = 0;
+   static time_t nextPurge = 0;
+   static const int purgeIntvl = 600, maxChains = 4096;
+
+   XrdSutCacheEntry *cent = 0;
+   XrdSutCERef ceref;
+   bool rdlock = false;
+   String tag;
+
+   //
+   // The fingerprint covers the chain as received and what it is checked
+   // against: the CA, the outcome of the CA check and the CRL
+   XrdCryptoMsgDigest *md = sessionCF->MsgDigest("sha256");
+   if (md && md->Update(bck->buffer, bck->size) == 0 && md->Final() == 0) {
+      tag = md->AsHexString();
+      tag += ':';
+      tag += hs->Chain->Begin()->SubjectHash();
+      tag += ':';
+      tag += (int)hs->Chain->StatusCA();
+      if (hs->Crl) {
+         tag += ':';
+         tag += (int)hs->Crl->LastUpdate();
+      }
+      XrdSutCacheArg_t arg = {kCE_ok, hs->TimeStamp, 0, 0};
+      if ((cent = cacheChain.Get(tag.c_str(), rdlock, ChainCheck, (void *) &arg)))
+         ceref.Set(&(cent->rwmtx));
+   }
+   delete md;
+
+   //
+   // If already verified we only need to order the chain as Verify() would
+   if (cent && rdlock && hs->Chain->Reorder() == 0) {
+      ceref.UnLock();
+      statMtx.Lock();
+      nHits++;
+      statMtx.UnLock();
+      DEBUG("chain verified earlier; skipping verification");
+      return 1;
+   }
+
+   //
+   // Do the full verification
+   struct timeval tv0, tv1;
+   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
+   gettimeofday(&tv0, 0);
+   bool verified = hs->Chain->Verify(ecode, vopt);
+   gettimeofday(&tv1, 0);
+   long long usec = (tv1.tv_sec - tv0.tv_sec)*1000000LL
+                  + (tv1.tv_usec - tv0.tv_usec);
+
+   //
+   // Record the result if we own the entry; it is good until the first
+   // certificate expires or the CRL is due to be updated. Failures are not
+   // kept, so bogus chains cannot fill the cache.
+   if (cent && !rdlock) {
+      if (verified) {
+         time_t expire = 0;
+         for (XrdCryptoX509 *xc = hs->Chain->Begin(); xc; xc = hs->Chain->Next())
+            if (!expire || xc->NotAfter() < expire) expire = xc->NotAfter();
+         if (hs->Crl && hs->Crl->NextUpdate() > 0 && hs->Crl->NextUpdate() < expire)
+            expire = hs->Crl->NextUpdate();
+         cent->status = kCE_ok;
+         cent->mtime = (kXR_int32)expire;
+      } else {
+         cent->status = kCE_inactive;
+      }
+   }
+   ceref.UnLock();
+   if (cent && !rdlock && !verified) cacheChain.Remove(tag.c_str());
+
+   //
+   // Drop expired entries now and then, and everything unused should there
+   // still be too many chains
+   time_t now = time(0);
+   statMtx.Lock();
+   bool doPurge = (now >= nextPurge || cacheChain.Num() > maxChains);
+   if (doPurge) nextPurge = now + purgeIntvl;
+   statMtx.UnLock();
+   if (doPurge) {
+      int left = cacheChain.Purge(ChainStale, (void *) &now);
+      if (left > maxChains) {
+         PRINT("too many cached chains ("<<left<<"); dropping them");
+         time_t never = (time_t)0x7fffffff;
+         left = cacheChain.Purge(ChainStale, (void *) &never);
+      }
+      DEBUG("chain cache purged; "<<left<<" entries left");
+   }
+
+   statMtx.Lock();
+   nVerify++;
+   vTotal += usec;
+   long long avg = vTotal / nVerify, hits = nHits, nver = nVerify;
+   statMtx.UnLock();
+   DEBUG("chain verification took "<<usec<<" us (avg "<<avg<<" us over "<<nver
+         <<" verifications; "<<hits<<" logins skipped it)");
+
+   if (!verified) {
+      cmsg = "certificate chain verification failed: ";
+      cmsg += hs->Chain->LastError();
+   }
+   return verified;
+}
+
 //_________________________________________________________________________
 int XrdSecProtocolgsi::ServerDoSigpxy(XrdSutBuffer *br,  XrdSutBuffer **bm,
                                       String &cmsg)
@@ -375,6 +375,7 @@ private:
    static XrdSutCache   cachePxy;  // Client proxies cache; 
    static XrdSutCache   cacheGMAPFun; // Cache for entries mapped by GMAPFun
    static XrdSutCache   cacheAuthzFun; // Cache for entities filled by AuthzFun
+   static XrdSutCache   cacheChain; // Client chains already verified
    //
    // Services
    static XrdOucGMap      *servGMap;  // Grid mapping service 
@@ -432,6 +433,8 @@ private:
                                String &cmsg);
    int            ServerDoSigpxy(XrdSutBuffer *br,  XrdSutBuffer **bm,
                                  String &cmsg);
+   bool           VerifyChain(XrdSutBucket *bck, x509ChainVerifyOpt_t *vopt,
+                              String &cmsg);
 
    // Auxilliary functions
    int            ParseCrypto(String cryptlist);
@@ -132,7 +132,8 @@ bool           XrdSecProtocolsss::isMapped   = false;
 bool           XrdSecProtocolsss::ktFixed    = false;
 
 struct XrdSecProtocolsss::Crypto XrdSecProtocolsss::CryptoTab[] = {
-       {"bf32", XrdSecsssRR_Hdr::etBFish32},
+       {"bf32",   XrdSecsssRR_Hdr::etBFish32},
+       {"aesgcm", XrdSecsssRR_Hdr::etAESGCM},
        {0, '0'}
        };
 
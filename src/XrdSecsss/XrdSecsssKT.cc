@@ -115,7 +115,9 @@ XrdSecsssKT::XrdSecsssKT(XrdOucErrInfo *eInfo, const char *kPath,
 
 // Now read in the whole key table and start possible refresh thread
 //
-   if ((ktList = getKeyTab(eInfo, sbuf.st_mtime, sbuf.st_mode))
+   ktList = getKeyTab(eInfo, sbuf.st_mtime, sbuf.st_mode);
+   ktIndex(ktList, ktByID, ktByName);
+   if (ktList
    && (oMode != isAdmin) && (!eInfo || eInfo->getErrInfo() == 0))
       {if ((retc = XrdSysThread::Run(&ktRefID,XrdSecsssKTRefresh, (void *)this,
                                      XRDSYSTHREAD_HOLD)))
@@ -134,7 +136,7 @@ XrdSecsssKT::~XrdSecsssKT()
 
 // Lock against others
 //
-   myMutex.Lock();
+   myMutex.WriteLock();
 
 // Kill the refresh thread first
 //
@@ -147,6 +149,7 @@ XrdSecsssKT::~XrdSecsssKT()
    if (ktPath) {free(ktPath); ktPath = 0;}
 
    while((ktP = ktList)) {ktList = ktList->Next; delete ktP;}
+   ktByID.clear(); ktByName.clear();
 
    myMutex.UnLock();
 }
@@ -176,6 +179,7 @@ void XrdSecsssKT::addKey(ktEnt &ktNew)
    if (ktPP) ktPP->Next = &ktNew;
       else   ktList     = &ktNew;
    ktNew.Next = ktP;
+   ktIndex(ktList, ktByID, ktByName);
 }
 
 /******************************************************************************/
@@ -197,6 +201,7 @@ int XrdSecsssKT::delKey(ktEnt &ktDel)
             } else {ktPP = ktP; ktP = ktP->Next;}
         }
 
+   if (nDel) ktIndex(ktList, ktByID, ktByName);
    return nDel;
 }
 
@@ -207,24 +212,34 @@ int XrdSecsssKT::delKey(ktEnt &ktDel)
 int XrdSecsssKT::getKey(ktEnt &theEnt, bool andKeyID)
 {
    ktEnt *ktP, *ktN;
+   time_t tNow = time(0);
 
 // Lock the keytab to prevent modification
 //
-   myMutex.Lock();
+   myMutex.ReadLock();
    ktP = ktList;
 
 // Find first key by key name (used normally by clients), by keyID, or both
 //
      if (!*theEnt.Data.Name)
         {if (theEnt.Data.ID >= 0)
-            while(ktP && ktP->Data.ID != theEnt.Data.ID)  ktP = ktP->Next;
+            {ktIDMap::iterator it = ktByID.find(theEnt.Data.ID);
+             ktP = (it == ktByID.end() ? 0 : it->second);
+            }
         }
    else if (andKeyID)
-        {while((ktP && ktP->Data.ID != theEnt.Data.ID)
-            || strcmp(ktP->Data.Name,theEnt.Data.Name)) ktP=ktP->Next;
+        {ktIDMap::iterator it = ktByID.find(theEnt.Data.ID);
+         ktP = (it == ktByID.end() ? 0 : it->second);
+         if (ktP && strcmp(ktP->Data.Name,theEnt.Data.Name))
+            {ktP = ktList;
+             while(ktP && (ktP->Data.ID != theEnt.Data.ID
+                       ||  strcmp(ktP->Data.Name,theEnt.Data.Name)))
+                  ktP = ktP->Next;
+            }
         }
-   else {while(ktP && strcmp(ktP->Data.Name,theEnt.Data.Name)) ktP=ktP->Next;
-         while(ktP && ktP->Data.Exp <= time(0))
+   else {ktNameMap::iterator it = ktByName.find(theEnt.Data.Name);
+         ktP = (it == ktByName.end() ? 0 : it->second);
+         while(ktP && ktP->Data.Exp <= tNow)
               {if (!(ktN=ktP->Next) 
                ||  strcmp(ktN->Data.Name,theEnt.Data.Name)) break;
                ktP = ktN;
@@ -239,7 +254,7 @@ int XrdSecsssKT::getKey(ktEnt &theEnt, bool andKeyID)
 // Indicate if key expired
 //
    if (!ktP) return ENOENT;
-   return (theEnt.Data.Exp && theEnt.Data.Exp <= time(0) ? -1 : 0);
+   return (theEnt.Data.Exp && theEnt.Data.Exp <= tNow ? -1 : 0);
 }
 
 /******************************************************************************/
@@ -312,6 +327,8 @@ void XrdSecsssKT::Refresh()
 {
    XrdOucErrInfo eInfo;
    ktEnt *ktNew, *ktOld, *ktNext;
+   ktIDMap   idMap;
+   ktNameMap nmMap;
    struct stat sbuf;
    int retc = 0;
 
@@ -321,7 +338,11 @@ void XrdSecsssKT::Refresh()
       {if (sbuf.st_mtime == ktMtime) return;
        if ((ktNew = getKeyTab(&eInfo, sbuf.st_mtime, sbuf.st_mode))
        && eInfo.getErrInfo() == 0)
-          {myMutex.Lock(); ktOld = ktList; ktList = ktNew; myMutex.UnLock();
+          {ktIndex(ktNew, idMap, nmMap);
+           myMutex.WriteLock();
+           ktOld = ktList; ktList = ktNew;
+           ktByID.swap(idMap); ktByName.swap(nmMap);
+           myMutex.UnLock();
           } else ktOld = ktNew;
        while(ktOld) {ktNext = ktOld->Next; delete ktOld; ktOld = ktNext;}
        if ((retc == eInfo.getErrInfo()) == 0) return;
@@ -544,6 +565,23 @@ int  XrdSecsssKT::isKey(ktEnt &ktRef, ktEnt *ktP, int Full)
    return 1;
 }
   
+/******************************************************************************/
+/*                               k t I n d e x                                */
+/******************************************************************************/
+
+void XrdSecsssKT::ktIndex(ktEnt *ktP, ktIDMap &idMap, ktNameMap &nmMap)
+{
+// Index the first entry with each key ID and key name. This is the entry a
+// scan of the list would find first, so getKey() can continue from there.
+//
+   idMap.clear(); nmMap.clear();
+   while(ktP)
+        {idMap.emplace(ktP->Data.ID, ktP);
+         nmMap.emplace(ktP->Data.Name, ktP);
+         ktP = ktP->Next;
+        }
+}
+
 /******************************************************************************/
 /*                                k e y B 2 X                                 */
 /******************************************************************************/
@@ -32,6 +32,8 @@
   
 #include <cstring>
 #include <ctime>
+#include <string>
+#include <unordered_map>
 #include "XrdSys/XrdSysPthread.hh"
 
 class XrdOucErrInfo;
@@ -117,6 +119,9 @@ enum   xMode {isAdmin = 0, isClient, isServer};
       ~XrdSecsssKT();
 
 private:
+typedef std::unordered_map<long long,   ktEnt *> ktIDMap;
+typedef std::unordered_map<std::string, ktEnt *> ktNameMap;
+
 int    eMsg(const char *epn, int rc, const char *txt1,
             const char *txt2=0, const char *txt3=0, const char *txt4=0);
 ktEnt *getKeyTab(XrdOucErrInfo *eInfo, time_t Mtime, mode_t Amode);
@@ -125,10 +130,18 @@ int    isKey(ktEnt &ktRef, ktEnt *ktP, int Full=1);
 void   keyB2X(ktEnt *theKT, char *buff);
 void   keyX2B(ktEnt *theKT, char *xKey);
 ktEnt *ktDecode0(XrdOucStream &kTab, XrdOucErrInfo *eInfo);
+static
+void   ktIndex(ktEnt *ktP, ktIDMap &idMap, ktNameMap &nmMap);
 
-XrdSysMutex myMutex;
+// The key list is read far more often than it changes. Lookups take a read
+// lock and use the maps below, which index the first entry for each key ID
+// and key name. A refresh builds the new list and maps before swapping them.
+//
+XrdSysRWLock myMutex;
 char       *ktPath;
 ktEnt      *ktList;
+ktIDMap     ktByID;
+ktNameMap   ktByName;
 time_t      ktMtime;
 xMode       ktMode;
 time_t      ktRefT;
@@ -45,6 +45,7 @@ char      Pad[2];                    // Padding bytes
 uint8_t   knSize;                    // Appended keyname size w/ null byte
 char      EncType;                   // Encryption type as one of:
 static const char etBFish32 = '0';   // Blowfish
+static const char etAESGCM  = '1';   // AES-256 GCM
 
 long long KeyID;                     // Key ID for encryption
 };
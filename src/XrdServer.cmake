@@ -32,6 +32,7 @@ add_library(
   XrdXrootd/XrdXrootdFileLock1.cc       XrdXrootd/XrdXrootdFileLock1.hh
                                         XrdXrootd/XrdXrootdFileStats.hh
   XrdXrootd/XrdXrootdJob.cc             XrdXrootd/XrdXrootdJob.hh
+  XrdXrootd/XrdXrootdMetaJob.cc         XrdXrootd/XrdXrootdMetaJob.hh
   XrdXrootd/XrdXrootdLoadLib.cc
                                         XrdXrootd/XrdXrootdMonData.hh
   XrdXrootd/XrdXrootdMonFile.cc         XrdXrootd/XrdXrootdMonFile.hh
@@ -86,6 +87,7 @@ add_library(
   XrdOfs/XrdOfsTPC.cc           XrdOfs/XrdOfsTPC.hh
   XrdOfs/XrdOfsTPCAuth.cc       XrdOfs/XrdOfsTPCAuth.hh
                                 XrdOfs/XrdOfsTPCConfig.hh
+                                XrdOfs/XrdOfsTPCCopy.hh
   XrdOfs/XrdOfsTPCJob.cc        XrdOfs/XrdOfsTPCJob.hh
   XrdOfs/XrdOfsTPCInfo.cc       XrdOfs/XrdOfsTPCInfo.hh
   XrdOfs/XrdOfsTPCProg.cc       XrdOfs/XrdOfsTPCProg.hh
@@ -156,6 +158,7 @@ add_library(
   XrdAcc/XrdAccConfig.cc         XrdAcc/XrdAccConfig.hh
   XrdAcc/XrdAccEntity.cc         XrdAcc/XrdAccEntity.hh
   XrdAcc/XrdAccGroups.cc         XrdAcc/XrdAccGroups.hh
+                                 XrdAcc/XrdAccPrefixTrie.hh
                                  XrdAcc/XrdAccPrivs.hh
 
   #-----------------------------------------------------------------------------
@@ -143,10 +143,47 @@ public:
       return cent;
    }
 
+   bool Remove(const char *tag) {
+      // Remove the entry with 'tag', unless another thread holds a lock on it.
+      // The caller must not hold a lock on the entry.
+      // Returns true if the entry is gone.
+
+      // Exclusive access to the table: no new reference can be taken
+      XrdSysMutexHelper raii(mtx);
+
+      XrdSutCacheEntry *cent = table.Find(tag);
+      if (!cent) return true;
+      if (!cent->rwmtx.CondWriteLock()) return false;
+      cent->rwmtx.UnLock();
+      table.Del(tag);
+      return true;
+   }
+
+   int Purge(XrdSutCacheGet_t condition, void *arg = 0) {
+      // Remove the entries for which condition applied with arguments 'arg'
+      // returns true, skipping those locked by another thread.
+      // Returns the number of entries left.
+
+      XrdSysMutexHelper raii(mtx);
+      PurgeArg_t parg = {condition, arg};
+      table.Apply(PurgeOne, (void *) &parg);
+      return table.Num();
+   }
+
    inline int Num() { return table.Num(); }
    inline void Reset() { return table.Purge(); }
 
 private:
+   struct PurgeArg_t { XrdSutCacheGet_t condition; void *arg; };
+
+   static int PurgeOne(const char *, XrdSutCacheEntry *cent, void *a) {
+      PurgeArg_t *parg = (PurgeArg_t *)a;
+      if (!cent->rwmtx.CondWriteLock()) return 0;
+      bool drop = (*(parg->condition))(cent, parg->arg);
+      cent->rwmtx.UnLock();
+      return (drop ? -1 : 0);
+   }
+
    XrdSysRecMutex         mtx;  // Protect access to table
    XrdOucHash<XrdSutCacheEntry> table; // table with content
 };
@@ -42,6 +42,8 @@
 #include <sys/param.h>
 #include <termios.h>
 #include <sys/uio.h>
+#include <climits>
+#include <atomic>
 #endif // WIN32
 
 #include "XrdOuc/XrdOucTList.hh"
@@ -107,10 +109,52 @@ void Snatch(struct iovec *iov, int iovnum) // Called with logger mutex locked!
 
 bool XrdSysLogger::doForward = false;
 
+/******************************************************************************/
+/*                   A s y n c h r o n o u s   Q u e u e s                    */
+/******************************************************************************/
+
+// The state of asynchronous writing lives outside of the logger object so that
+// the object keeps its size and layout. A logger writing asynchronously refers
+// to its queue by slot number.
+//
+namespace
+{
+struct aqMsg
+      {aqMsg *next;
+       int    mlen;  // The message text follows the header
+      };
+
+struct aqInfo
+      {std::atomic<aqMsg *>   Head;
+       std::atomic<long long> Bytes;
+       std::atomic<long long> Drops;
+       long long              Max;
+       XrdSysSemaphore        Sem;
+       pthread_t              TID;
+       bool                   Stop;
+
+                              aqInfo(long long qmax)
+                                    : Head(0), Bytes(0), Drops(0), Max(qmax),
+                                      Sem(0), TID(0), Stop(false) {}
+      };
+
+const int   aqSlots = 16;
+aqInfo     *aqTable[aqSlots] = {0};
+XrdSysMutex aqMutex;
+
+inline aqInfo *aqGet(int slot) {return (slot ? aqTable[slot-1] : 0);}
+}
+
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
 
+void  *XrdSysLoggerAQ(void *carg)
+      {XrdSysLogger *lp = (XrdSysLogger *)carg;
+       lp->aqHandler();
+       return (void *)0;
+      }
+
 void  *XrdSysLoggerMN(void *carg)
       {XrdSysLogger::Task *tP = (XrdSysLogger::Task *)carg;
        while(tP) {tP->Ring(); tP = tP->Next();}
@@ -152,7 +196,7 @@ XrdSysLogger::XrdSysLogger(int ErrFD, int dorotate)
    lfhTID  = 0;
    hiRes   = false;
    fifoFN  = 0;
-   reserved1 = 0;
+   aqSlot  = 0;
 
 // Establish default log file name
 //
@@ -165,6 +209,34 @@ XrdSysLogger::XrdSysLogger(int ErrFD, int dorotate)
             Bind(logFN, 1);
            }
 }
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdSysLogger::~XrdSysLogger()
+{
+   aqInfo *aqP;
+
+// Stop the writer thread, if any; it writes whatever is still queued
+//
+   if ((aqP = aqGet(aqSlot)))
+      {Logger_Mutex.Lock();
+       aqP->Stop = true;
+       Logger_Mutex.UnLock();
+       aqP->Sem.Post();
+       XrdSysThread::Join(aqP->TID, 0);
+       aqMutex.Lock();
+       aqTable[aqSlot-1] = 0;
+       aqMutex.UnLock();
+       aqSlot = 0;
+       delete aqP;
+      }
+
+   RmLogRotateLock();
+   if (ePath)
+     free(ePath);
+}
   
 /******************************************************************************/
 /*                                A d d M s g                                 */
@@ -195,6 +267,34 @@ void XrdSysLogger::AddMsg(const char *msg)
    Logger_Mutex.UnLock();
 }
   
+/******************************************************************************/
+/*                             a q H a n d l e r                              */
+/******************************************************************************/
+
+void XrdSysLogger::aqHandler()
+{
+   aqInfo *aqP = aqGet(aqSlot);
+   char eBuff[80];
+   long long nDrop;
+   bool done;
+   int n;
+
+// Each time we are woken up write whatever has been queued. Messages queued
+// while we are writing cause another wakeup so nothing is left behind.
+//
+   do {aqP->Sem.Wait();
+       Logger_Mutex.Lock();
+       Drain();
+       if ((nDrop = aqP->Drops.exchange(0)))
+          {n = snprintf(eBuff, sizeof(eBuff), "Logger: %lld message(s) "
+                        "dropped; asynchronous queue is full.\n", nDrop);
+           putEmsg(eBuff, n);
+          }
+       done = aqP->Stop;
+       Logger_Mutex.UnLock();
+      } while(!done);
+}
+  
 /******************************************************************************/
 /*                            A t M i d n i g h t                             */
 /******************************************************************************/
@@ -288,6 +388,26 @@ void XrdSysLogger::Capture(XrdOucTListFIFO *tFIFO)
    Logger_Mutex.UnLock();
 }
   
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+void XrdSysLogger::Flush()
+{
+
+// Write out anything that has been queued but not yet written
+//
+   if (aqSlot)
+      {Logger_Mutex.Lock();
+       Drain();
+       Logger_Mutex.UnLock();
+      }
+
+// Now make sure it is all on disk
+//
+   fsync(eFD);
+}
+  
 /******************************************************************************/
 /*                             P a r s e K e e p                              */
 /******************************************************************************/
@@ -354,6 +474,36 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
        iov[0].iov_len  = TimeStamp(tVal, tID, tbuff, sizeof(tbuff), hiRes);
       }
 
+// When writing asynchronously, copy the message and queue it for the writer
+// thread unless messages are being captured (rarely the case).
+//
+   if (aqSlot && !tFifo)
+      {aqInfo *aqP = aqGet(aqSlot);
+       aqMsg *mP, *hP;
+       char *mtP;
+       int mlen = 0;
+       for (int i = 0; i < iovcnt; i++) mlen += iov[i].iov_len;
+       if (aqP->Bytes.fetch_add(mlen, std::memory_order_relaxed) + mlen
+           > aqP->Max || !(mP = (aqMsg *)malloc(sizeof(aqMsg) + mlen)))
+          {aqP->Bytes.fetch_sub(mlen, std::memory_order_relaxed);
+           if (!aqP->Drops.fetch_add(1, std::memory_order_relaxed))
+              aqP->Sem.Post();
+           return;
+          }
+       mP->mlen = mlen;
+       mtP = (char *)(mP+1);
+       for (int i = 0; i < iovcnt; i++)
+           {memcpy(mtP, iov[i].iov_base, iov[i].iov_len);
+            mtP += iov[i].iov_len;
+           }
+       hP = aqP->Head.load(std::memory_order_relaxed);
+       do {mP->next = hP;}
+          while(!aqP->Head.compare_exchange_weak(hP, mP,
+                        std::memory_order_release, std::memory_order_relaxed));
+       if (!hP) aqP->Sem.Post();
+       return;
+      }
+
 // Obtain the serailization mutex if need be
 //
    Logger_Mutex.Lock();
@@ -377,6 +527,58 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
    Logger_Mutex.UnLock();
 }
   
+/******************************************************************************/
+/*                              s e t A s y n c                               */
+/******************************************************************************/
+
+bool XrdSysLogger::setAsync(long long qmax)
+{
+   char eBuff[128];
+   aqInfo *aqP;
+   int n, rc, slot;
+
+// Asynchronous writing can only be started once and needs a limit
+//
+   if (aqSlot) return true;
+   if (qmax <= 0) return false;
+
+// Find a free slot for the queue
+//
+   aqMutex.Lock();
+   for (slot = 0; slot < aqSlots && aqTable[slot]; slot++) {}
+   if (slot >= aqSlots)
+      {aqMutex.UnLock();
+       n = snprintf(eBuff, sizeof(eBuff), "Logger: Unable to write "
+                    "asynchronously; too many loggers already do so.\n");
+       Logger_Mutex.Lock();
+       putEmsg(eBuff, n);
+       Logger_Mutex.UnLock();
+       return false;
+      }
+   aqTable[slot] = aqP = new aqInfo(qmax);
+   aqMutex.UnLock();
+
+// Start the thread that writes queued messages. Messages are only queued after
+// the thread is running so that none can be left behind.
+//
+   aqSlot = slot+1;
+   if ((rc = XrdSysThread::Run(&aqP->TID, XrdSysLoggerAQ, (void *)this,
+                               XRDSYSTHREAD_HOLD, "Logger writer")))
+      {aqSlot = 0;
+       aqMutex.Lock();
+       aqTable[slot] = 0;
+       aqMutex.UnLock();
+       delete aqP;
+       n = snprintf(eBuff, sizeof(eBuff), "Logger: Unable to start writer "
+                    "thread; %s\n", XrdSysE2T(rc));
+       Logger_Mutex.Lock();
+       putEmsg(eBuff, n);
+       Logger_Mutex.UnLock();
+       return false;
+      }
+   return true;
+}
+  
 /******************************************************************************/
 /* Private:                         T i m e                                   */
 /******************************************************************************/
@@ -448,6 +650,49 @@ int XrdSysLogger::TimeStamp(struct timeval &tVal, unsigned long tID,
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+// This internal method is called with the logger mutex held!
+
+void XrdSysLogger::Drain()
+{
+   static const int iovMax = (IOV_MAX < 1024 ? IOV_MAX : 1024);
+   struct iovec iov[iovMax];
+   aqInfo *aqP = aqGet(aqSlot);
+   aqMsg *mP, *nP, *fP = 0;
+   long long qBytes = 0;
+   int n = 0, retc;
+
+// Take everything that has been queued. The queue is a stack so reverse it
+// to write messages in the order they were queued.
+//
+   if (!aqP || !(mP = aqP->Head.exchange(0, std::memory_order_acquire)))
+      return;
+   while(mP) {nP = mP->next; mP->next = fP; fP = mP; mP = nP;}
+
+// Write out the messages in batches as large as writev will allow
+//
+   mP = fP;
+   while(mP)
+        {iov[n].iov_base = (char *)(mP+1);
+         iov[n].iov_len  = mP->mlen;
+         qBytes += mP->mlen;
+         mP = mP->next;
+         if (++n >= iovMax || !mP)
+            {do { retc = writev(eFD, (const struct iovec *)iov, n);}
+                       while (retc < 0 && errno == EINTR);
+             n = 0;
+            }
+        }
+
+// Release the messages and make room for more
+//
+   while(fP) {nP = fP->next; free(fP); fP = nP;}
+   aqP->Bytes.fetch_sub(qBytes, std::memory_order_relaxed);
+}
+
 /******************************************************************************/
 /*                              F i f o M a k e                               */
 /******************************************************************************/
@@ -837,6 +1082,7 @@ void XrdSysLogger::zHandler()
                  }
 
          Logger_Mutex.Lock();
+         Drain();
          ReBind();
 
          mP = msgList;
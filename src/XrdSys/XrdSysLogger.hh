@@ -68,12 +68,7 @@ public:
 //! Destructor
 //-----------------------------------------------------------------------------
 
-        ~XrdSysLogger()
-        {
-          RmLogRotateLock();
-          if (ePath)
-            free(ePath);
-        }
+        ~XrdSysLogger();
 
 //-----------------------------------------------------------------------------
 //! Add a message to be printed at midnight.
@@ -146,10 +141,11 @@ int Bind(const char *path, int lfh=0);
 void Capture(XrdOucTListFIFO *tFIFO);
 
 //-----------------------------------------------------------------------------
-//! Flush any pending output
+//! Flush any pending output, including messages queued for asynchronous
+//! writing.
 //-----------------------------------------------------------------------------
 
-void Flush() {fsync(eFD);}
+void Flush();
 
 //-----------------------------------------------------------------------------
 //! Get the file descriptor passed at construction time.
@@ -182,6 +178,21 @@ int  ParseKeep(const char *arg);
 
 void Put(int iovcnt, struct iovec *iov);
 
+//-----------------------------------------------------------------------------
+//! Write messages asynchronously. Put() queues each message and returns; a
+//! background thread writes queued messages in batches. Messages that would
+//! exceed the queue limit are dropped and the number dropped is logged. This
+//! cannot be undone and messages still queued when the process crashes are
+//! lost.
+//!
+//! @param  qmax      The maximum number of bytes of messages that may be
+//!                   queued. It must be positive.
+//!
+//! @return true if asynchronous writing is in effect, false otherwise.
+//-----------------------------------------------------------------------------
+
+bool setAsync(long long qmax);
+
 //-----------------------------------------------------------------------------
 //! Set call-out to logging plug-in on or off.
 //-----------------------------------------------------------------------------
@@ -246,6 +257,13 @@ const char *xlogFN() {return (ePath ? ePath : "stderr");}
 
 void        zHandler();
 
+//-----------------------------------------------------------------------------
+//! Internal method to write queued messages. This is public because it needs
+//! to be called by an external thread.
+//-----------------------------------------------------------------------------
+
+void        aqHandler();
+
 private:
 int         FifoMake();
 void        FifoWait();
@@ -270,7 +288,7 @@ int        baseFD;
 char      *ePath;
 char       Filesfx[8];
 int        eInt;
-int        reserved1;
+int        aqSlot;           // Asynchronous queue slot + 1 (0 -> synchronous)
 char      *fifoFN;
 bool       hiRes;
 bool       doLFR;
@@ -278,6 +296,7 @@ pthread_t  lfhTID;
 
 static bool doForward;
 
+void   Drain();
 void   putEmsg(char *msg, int msz);
 int    ReBind(int dorename=1);
 void   Trim();
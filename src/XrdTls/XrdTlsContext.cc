@@ -17,11 +17,20 @@
 //------------------------------------------------------------------------------
 
 #include <cstdio>
+#include <cstring>
+#include <map>
 #include <openssl/bio.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/opensslv.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
 #include <sys/stat.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -60,6 +69,7 @@ struct XrdTlsContextImpl
    ~XrdTlsContextImpl() {if (ctx)     SSL_CTX_free(ctx);
                          if (ctxnew)  delete ctxnew;
                          if (flsCVar) delete flsCVar;
+                         for (auto &it : sessMap) SSL_SESSION_free(it.second);
                         }
 
     SSL_CTX                      *ctx;
@@ -74,6 +84,9 @@ struct XrdTlsContextImpl
     time_t                        lastCertModTime = 0;
     int                           sessionCacheOpts = -1;
     std::string                   sessionCacheId;
+    XrdSysMutex                   sessMutex;
+    std::map<std::string, SSL_SESSION*> sessMap;
+    bool                          sessClnt = false;
 };
   
 /******************************************************************************/
@@ -296,6 +309,294 @@ bool Setup_Flusher(XrdTlsContextImpl *pImpl, int flushT)
 }
 }
   
+/******************************************************************************/
+/*                  S e s s i o n   T i c k e t   S u p p o r t               */
+/******************************************************************************/
+
+// Session tickets are encrypted using a key ring shared by every context in
+// the process so that cloned and refreshed contexts accept each other's
+// tickets. The current key is replaced once it is older than the session
+// timeout. The previous key is still accepted until the tickets it encrypted
+// would have expired anyway; such tickets are renewed using the current key.
+//
+namespace XrdTlsTicket
+{
+struct tkKey
+      {unsigned char name[16];
+       unsigned char aes[32];
+       unsigned char hmac[32];
+       time_t        born;
+      };
+
+XrdSysMutex tkMutex;
+tkKey       tkCur;
+tkKey       tkOld;
+bool        tkHaveCur = false;
+bool        tkHaveOld = false;
+
+/******************************************************************************/
+/*                                G e t K e y                                 */
+/******************************************************************************/
+  
+bool GetKey(tkKey &key, long life)
+{
+   XrdSysMutexHelper mHelper(tkMutex);
+   time_t tNow = time(0);
+
+// Rotate the key if we do not have one or it has aged out
+//
+   if (!tkHaveCur || tNow - tkCur.born >= life)
+      {tkKey newKey;
+       if (RAND_bytes(newKey.name, sizeof(newKey.name)) != 1
+       ||  RAND_bytes(newKey.aes,  sizeof(newKey.aes))  != 1
+       ||  RAND_bytes(newKey.hmac, sizeof(newKey.hmac)) != 1) return false;
+       newKey.born = tNow;
+       if (tkHaveCur) {tkOld = tkCur; tkHaveOld = true;}
+       tkCur = newKey; tkHaveCur = true;
+       OPENSSL_cleanse(&newKey, sizeof(newKey));
+      }
+
+// Return the current key
+//
+   key = tkCur;
+   return true;
+}
+
+/******************************************************************************/
+/*                               F i n d K e y                                */
+/******************************************************************************/
+
+// Returns 0 if the key is unknown or expired, 1 if the ticket is good, and 2
+// if the ticket is good but should be replaced by one using the current key.
+  
+int FindKey(const unsigned char *name, tkKey &key, long life)
+{
+   XrdSysMutexHelper mHelper(tkMutex);
+   time_t tNow = time(0);
+
+   if (tkHaveCur && !memcmp(name, tkCur.name, sizeof(tkCur.name))
+   &&  tNow - tkCur.born < 2*life)
+      {key = tkCur;
+       return (tNow - tkCur.born >= life ? 2 : 1);
+      }
+
+   if (tkHaveOld && !memcmp(name, tkOld.name, sizeof(tkOld.name))
+   &&  tNow - tkOld.born < 2*life)
+      {key = tkOld;
+       return 2;
+      }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 K e y C B                                  */
+/******************************************************************************/
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int KeyCB(SSL *ssl, unsigned char *name, unsigned char *iv,
+          EVP_CIPHER_CTX *ectx, EVP_MAC_CTX *hctx, int enc)
+#else
+int KeyCB(SSL *ssl, unsigned char *name, unsigned char *iv,
+          EVP_CIPHER_CTX *ectx, HMAC_CTX *hctx, int enc)
+#endif
+{
+   const EVP_CIPHER *cipher = EVP_aes_256_cbc();
+   tkKey key;
+   long life = SSL_CTX_get_timeout(SSL_get_SSL_CTX(ssl));
+   int  rc = 1;
+
+// Tickets are no good for shorter lifetimes than this
+//
+   if (life < 60) life = 60;
+
+// When encrypting without ticket application data (see GenCB() below) we
+// make sure the peer did not present a certificate as a resumed session would
+// lack the peer's certificate chain. Such peers always need a full handshake.
+//
+   if (enc)
+      {
+#if OPENSSL_VERSION_NUMBER < 0x10101000L
+       X509 *peer = SSL_get_peer_certificate(ssl);
+       if (peer) {X509_free(peer); return 0;}
+#endif
+       if (!GetKey(key, life)
+       ||  RAND_bytes(iv, EVP_CIPHER_iv_length(cipher)) != 1) return 0;
+       memcpy(name, key.name, sizeof(key.name));
+       if (!EVP_EncryptInit_ex(ectx, cipher, 0, key.aes, iv)) rc = -1;
+      } else {
+       if (!(rc = FindKey(name, key, life))) return 0;
+#ifdef TLS1_3_VERSION
+// TLSv1.3 clients should not reuse a ticket so always issue a new one
+//
+       if (SSL_version(ssl) >= TLS1_3_VERSION) rc = 2;
+#endif
+       if (!EVP_DecryptInit_ex(ectx, cipher, 0, key.aes, iv)) rc = -1;
+      }
+
+// Now set the hmac key
+//
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+   OSSL_PARAM parms[3];
+   parms[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+                                                key.hmac, sizeof(key.hmac));
+   parms[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                               (char *)"sha256", 0);
+   parms[2] = OSSL_PARAM_construct_end();
+   if (rc > 0 && !EVP_MAC_CTX_set_params(hctx, parms)) rc = -1;
+#else
+   if (rc > 0 && !HMAC_Init_ex(hctx, key.hmac, sizeof(key.hmac),
+                               EVP_sha256(), 0)) rc = -1;
+#endif
+
+// All done
+//
+   OPENSSL_cleanse(&key, sizeof(key));
+   return rc;
+}
+
+/******************************************************************************/
+/*                          P e e r   C h a i n s                             */
+/******************************************************************************/
+
+// A session restored from a ticket only holds the peer's certificate, not the
+// rest of its chain. So, the chain is carried as application data inside the
+// ticket (it is encrypted and authenticated along with the ticket) and is
+// attached to the SSL object upon resumption.
+//
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+
+void FreeChain(void *parent, void *ptr, CRYPTO_EX_DATA *ad, int idx,
+               long argl, void *argp)
+{
+   if (ptr) sk_X509_pop_free(static_cast<STACK_OF(X509) *>(ptr), X509_free);
+}
+
+int ChainIdx()
+{
+   static int idx = SSL_get_ex_new_index(0, 0, 0, 0, FreeChain);
+   return idx;
+}
+
+/******************************************************************************/
+/*                                 C h a i n                                  */
+/******************************************************************************/
+
+STACK_OF(X509) *Chain(SSL *ssl)
+{
+   STACK_OF(X509) *chain = SSL_get_peer_cert_chain(ssl);
+
+   if (chain || ChainIdx() < 0) return chain;
+   return static_cast<STACK_OF(X509) *>(SSL_get_ex_data(ssl, ChainIdx()));
+}
+
+/******************************************************************************/
+/*                                 G e n C B                                  */
+/******************************************************************************/
+
+// The application data is the DER encoding of each certificate in the chain,
+// each preceded by its length as four bytes in network byte order.
+  
+int GenCB(SSL *ssl, void *arg)
+{
+   STACK_OF(X509) *chain;
+   SSL_SESSION *sess = SSL_get0_session(ssl);
+   X509 *peer = SSL_get_peer_certificate(ssl);
+   std::string appData;
+   unsigned char *dP;
+   int i, n;
+
+// Nothing needs to be carried if the peer has no certificate
+//
+   if (!peer) return 1;
+   X509_free(peer);
+   if (!sess) return 0;
+
+// Encode the chain. Failing to do so means that no ticket is issued.
+//
+   if ((chain = Chain(ssl)))
+      for (i = 0; i < sk_X509_num(chain); i++)
+          {if ((n = i2d_X509(sk_X509_value(chain, i), 0)) <= 0) return 0;
+           appData.push_back(static_cast<char>((n >> 24) & 0xff));
+           appData.push_back(static_cast<char>((n >> 16) & 0xff));
+           appData.push_back(static_cast<char>((n >>  8) & 0xff));
+           appData.push_back(static_cast<char>( n        & 0xff));
+           appData.resize(appData.size() + n);
+           dP = reinterpret_cast<unsigned char *>(&appData[0])
+              + appData.size() - n;
+           if (i2d_X509(sk_X509_value(chain, i), &dP) != n) return 0;
+          }
+
+// Even an empty chain is recorded so that we know a chain is present
+//
+   appData.insert(0, "XrdC", 4);
+   return SSL_SESSION_set1_ticket_appdata(sess, appData.data(),
+                                          appData.size());
+}
+
+/******************************************************************************/
+/*                                 D e c C B                                  */
+/******************************************************************************/
+  
+SSL_TICKET_RETURN DecCB(SSL *ssl, SSL_SESSION *sess,
+                        const unsigned char *keyname, size_t keyname_length,
+                        SSL_TICKET_STATUS status, void *arg)
+{
+   const SSL_TICKET_RETURN useIt = (status == SSL_TICKET_SUCCESS_RENEW
+                                 ? SSL_TICKET_RETURN_USE_RENEW
+                                 : SSL_TICKET_RETURN_USE);
+   STACK_OF(X509) *chain;
+   const unsigned char *aP, *dP;
+   void  *appData;
+   size_t appLen, n;
+   X509  *peer, *cert;
+
+// Let OpenSSL handle tickets that cannot be used
+//
+   if (status != SSL_TICKET_SUCCESS && status != SSL_TICKET_SUCCESS_RENEW)
+      return (status == SSL_TICKET_FATAL_ERR_MALLOC
+           || status == SSL_TICKET_FATAL_ERR_OTHER
+           ?  SSL_TICKET_RETURN_ABORT : SSL_TICKET_RETURN_IGNORE_RENEW);
+
+// Without a peer certificate there is no chain to restore
+//
+   if (!(peer = SSL_SESSION_get0_peer(sess))) return useIt;
+
+// Get the chain. If it is missing or malformed, do a full handshake.
+//
+   if (ChainIdx() < 0
+   || !SSL_SESSION_get0_ticket_appdata(sess, &appData, &appLen)
+   ||  appLen < 4 || memcmp(appData, "XrdC", 4)
+   || !(chain = sk_X509_new_null())) return SSL_TICKET_RETURN_IGNORE_RENEW;
+
+   aP = static_cast<const unsigned char *>(appData) + 4; appLen -= 4;
+   while(appLen)
+        {if (appLen < 4) break;
+         n = (size_t(aP[0]) << 24) | (size_t(aP[1]) << 16)
+           | (size_t(aP[2]) <<  8) |  size_t(aP[3]);
+         aP += 4; appLen -= 4;
+         if (n > appLen) break;
+         dP = aP;
+         if (!(cert = d2i_X509(0, &dP, n)) || dP != aP + n)
+            {if (cert) X509_free(cert);
+             break;
+            }
+         sk_X509_push(chain, cert);
+         aP += n; appLen -= n;
+        }
+
+// Attach the chain to the connection if all of it was decoded
+//
+   if (appLen || !SSL_set_ex_data(ssl, ChainIdx(), chain))
+      {sk_X509_pop_free(chain, X509_free);
+       return SSL_TICKET_RETURN_IGNORE_RENEW;
+      }
+   return useIt;
+}
+#else
+STACK_OF(X509) *Chain(SSL *ssl) {return SSL_get_peer_cert_chain(ssl);}
+#endif
+}
+  
 /******************************************************************************/
 /*                 S S L   T h r e a d i n g   S u p p o r t                  */
 /******************************************************************************/
@@ -949,7 +1250,8 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
    int flushT = opts & scFMax;
 
    pImpl->sessionCacheOpts = opts;
-   pImpl->sessionCacheId = id;
+   if (id) pImpl->sessionCacheId.assign(id, (idlen > 0 ? idlen : 0));
+      else pImpl->sessionCacheId.clear();
 
 // If initialization failed there is nothing to do
 //
@@ -968,7 +1270,26 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
 //
    if (!(opts & doSet)) sslopt = SSL_CTX_get_session_cache_mode(pImpl->ctx);
       else {sslopt = SSL_CTX_set_session_cache_mode(pImpl->ctx, sslopt);
-            if (opts & scOff) SSL_CTX_set_options(pImpl->ctx, SSL_OP_NO_TICKET);
+            if (opts & (scOff | scNoTk))
+               SSL_CTX_set_options(pImpl->ctx, SSL_OP_NO_TICKET);
+               else if (opts & scSrvr)
+                       {SSL_CTX_clear_options(pImpl->ctx, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+                        SSL_CTX_set_tlsext_ticket_key_evp_cb(pImpl->ctx,
+                                                   XrdTlsTicket::KeyCB);
+#else
+                        SSL_CTX_set_tlsext_ticket_key_cb(pImpl->ctx,
+                                                   XrdTlsTicket::KeyCB);
+#endif
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+                        SSL_CTX_set_session_ticket_cb(pImpl->ctx,
+                                                   XrdTlsTicket::GenCB,
+                                                   XrdTlsTicket::DecCB, 0);
+#endif
+                       }
+            pImpl->sessMutex.Lock();
+            pImpl->sessClnt = (opts & scClnt) && !(opts & scOff);
+            pImpl->sessMutex.UnLock();
            }
 
 // Compute what he previous cache options were
@@ -999,6 +1320,69 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
    return opts;
 }
   
+/******************************************************************************/
+/*                            S e s s i o n G e t                             */
+/******************************************************************************/
+
+bool XrdTlsContext::SessionGet(const char *host, void *ssl)
+{
+   XrdSysMutexHelper mHelper(pImpl->sessMutex);
+   std::map<std::string, SSL_SESSION*>::iterator it;
+
+// Find a saved session for this host. Sessions are used only once as servers
+// issue a fresh ticket for every resumed connection.
+//
+   if (!pImpl->sessClnt || !host || !ssl
+   ||  (it = pImpl->sessMap.find(host)) == pImpl->sessMap.end()) return false;
+
+   SSL_SESSION *sess = it->second;
+   pImpl->sessMap.erase(it);
+   mHelper.UnLock();
+
+   bool aOK = SSL_set_session(static_cast<SSL *>(ssl), sess) == 1;
+   SSL_SESSION_free(sess);
+   return aOK;
+}
+  
+/******************************************************************************/
+/*                            S e s s i o n P u t                             */
+/******************************************************************************/
+
+void XrdTlsContext::SessionPut(const char *host, void *ssl)
+{
+   static const unsigned int maxSess = 256;
+   SSL_SESSION *sess, *oldSess = 0;
+
+// Make sure we are caching client sessions and this one can be resumed
+//
+   if (!pImpl->sessClnt || !host || !ssl
+   ||  !(sess = SSL_get1_session(static_cast<SSL *>(ssl)))) return;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+   if (!SSL_SESSION_is_resumable(sess)) {SSL_SESSION_free(sess); return;}
+#endif
+
+// Replace any existing session for this host. If we have too many hosts, we
+// simply discard an arbitrary one; it only costs a full handshake later.
+//
+   pImpl->sessMutex.Lock();
+   std::map<std::string, SSL_SESSION*>::iterator it
+                                        = pImpl->sessMap.find(host);
+   if (it != pImpl->sessMap.end())
+      {oldSess = it->second;
+       it->second = sess;
+      } else {
+       if (pImpl->sessMap.size() >= maxSess)
+          {it = pImpl->sessMap.begin();
+           oldSess = it->second;
+           pImpl->sessMap.erase(it);
+          }
+       pImpl->sessMap[host] = sess;
+      }
+   pImpl->sessMutex.UnLock();
+
+   if (oldSess) SSL_SESSION_free(oldSess);
+}
+
 /******************************************************************************/
 /*                     S e t C o n t e x t C i p h e r s                      */
 /******************************************************************************/
@@ -127,12 +127,18 @@ void           *Session();
 //!         If the context has been pprroperly initialized, zero is returned.
 //!         By default, the session cache is disabled as it is impossible to
 //!         verify a peer certificate chain when a cached session is reused.
+//!         In server mode, stateless session tickets are also issued unless
+//!         scNoTk is specified. Ticket keys are shared by all contexts in
+//!         the process and are rotated once per session timeout. A peer's
+//!         certificate chain is carried in its ticket; use
+//!         XrdTlsPeerCerts::getChain() to obtain it for resumed sessions.
 //------------------------------------------------------------------------
 
 static const int scNone = 0x00000000; //!< Do not change any option settings
 static const int scOff  = 0x00010000; //!< Turn off cache
 static const int scSrvr = 0x00020000; //!< Turn on  cache server mode (default)
 static const int scClnt = 0x00040000; //!< Turn on  cache client mode
+static const int scNoTk = 0x00080000; //!< Server: do not issue tickets
 static const int scKeep = 0x40000000; //!< Info: TLS-controlled flush disabled
 static const int scIdErr= 0x80000000; //!< Info: Id not set, is too long
 static const int scFMax = 0x00007fff; //!< Maximum flush interval in seconds
@@ -140,6 +146,28 @@ static const int scFMax = 0x00007fff; //!< Maximum flush interval in seconds
 
       int       SessionCache(int opts=scNone, const char *id=0, int idlen=0);
 
+//------------------------------------------------------------------------
+//! Use a previously saved client session to resume a connection to a host.
+//!
+//! @param  host     The "host:port" of the server being connected to.
+//! @param  ssl      Pointer to the SSL object that will do the connect.
+//!
+//! @return True if a session was found and set; false otherwise.
+//------------------------------------------------------------------------
+
+bool            SessionGet(const char *host, void *ssl);
+
+//------------------------------------------------------------------------
+//! Save the session of a client connection so that a subsequent connection
+//! to the same host may resume it. Nothing is saved unless client session
+//! caching was enabled via SessionCache(scClnt).
+//!
+//! @param  host     The "host:port" of the server that was connected to.
+//! @param  ssl      Pointer to the SSL object of the connection.
+//------------------------------------------------------------------------
+
+void            SessionPut(const char *host, void *ssl);
+
 //------------------------------------------------------------------------
 //! Set allowed ciphers for this context.
 //!
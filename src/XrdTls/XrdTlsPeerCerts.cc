@@ -54,6 +54,15 @@ int X509_up_ref(X509 *cert)
 #include <openssl/x509.h>
 #endif
 
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+namespace XrdTlsTicket
+{
+extern STACK_OF(X509) *Chain(SSL *ssl);
+}
+
 /******************************************************************************/
 /*                            D e s t r u c t o r                             */
 /******************************************************************************/
@@ -81,3 +90,12 @@ X509 *XrdTlsPeerCerts::getCert(bool upref)
    if (cert && upref && !X509_up_ref(cert)) return 0;
    return cert;
 }
+
+/******************************************************************************/
+/*                              g e t C h a i n                               */
+/******************************************************************************/
+  
+STACK_OF(X509) *XrdTlsPeerCerts::getChain(SSL *ssl)
+{
+   return XrdTlsTicket::Chain(ssl);
+}
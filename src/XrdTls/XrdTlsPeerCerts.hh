@@ -83,6 +83,19 @@ bool            hasCert() {return cert != 0;}
 
 bool            hasChain() {return chain != 0;}
 
+//------------------------------------------------------------------------
+//! Obtain the certificate chain of a connection's peer. Unlike
+//! SSL_get_peer_cert_chain() this also returns the chain when the session
+//! was resumed using a session ticket.
+//!
+//! @param  ssl      - pointer to the SSL object of the connection.
+//!
+//! @return Pointer to the chain, which the caller must not free, or nil.
+//------------------------------------------------------------------------
+
+static
+STACK_OF(X509) *getChain(SSL *ssl);
+
 //------------------------------------------------------------------------
 //! Constructor
 //!
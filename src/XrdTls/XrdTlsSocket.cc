@@ -29,6 +29,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 
+#include "XrdNet/XrdNetAddr.hh"
 #include "XrdNet/XrdNetAddrInfo.hh"
 #include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -64,6 +65,7 @@ struct XrdTlsSocketImpl
     char             cAttr;     //!< Connection attributes
     bool             hsNoBlock; //!< Handshake handling nonblocking if true
     bool             isSerial;  //!< True if calls must be serialized
+    std::string      sessHost;  //!< Host whose session may be saved (client)
 };
 
 /******************************************************************************/
@@ -270,6 +272,22 @@ XrdTls::RC XrdTlsSocket::Connect(const char *thehost, std::string *eWhy)
    DBG_SOK("Connecting to " <<(thehost ? thehost : "unverified host")
            <<(thehost && pImpl->cOpts & DNSok ? " dnsok" : "" ));
 
+// If this is the first connect attempt, see if we can resume a session that
+// we previously had with this host. Sessions are kept by host and port as
+// different servers may run on the same host.
+//
+   if (pImpl->isClient && thehost && !pImpl->hsDone
+   &&  pImpl->sessHost.empty())
+      {XrdNetAddr peer;
+       if (!peer.Set(SSL_get_fd(pImpl->ssl)) && peer.Port() > 0)
+          {pImpl->sessHost = thehost;
+           pImpl->sessHost += ':';
+           pImpl->sessHost += std::to_string(peer.Port());
+           if (pImpl->tlsctx->SessionGet(pImpl->sessHost.c_str(), pImpl->ssl))
+              DBG_SOK("Resuming previous session with " <<pImpl->sessHost);
+          }
+      }
+
 // Do the connect.
 //
 do{int rc = SSL_connect( pImpl->ssl );
@@ -316,6 +334,7 @@ do{int rc = SSL_connect( pImpl->ssl );
       {const char *eTxt = XrdTlsNotary::Validate(pImpl->ssl, thehost, 0);
        if (eTxt)
           {DBG_SOK(thehost << " verification failed; " <<eTxt);
+           pImpl->sessHost.clear();
            if (eWhy)
               {
                *eWhy  = "Unable to validate "; *eWhy += thehost;
@@ -325,7 +344,8 @@ do{int rc = SSL_connect( pImpl->ssl );
           }
       }
 
-   DBG_SOK("Connect completed without error.");
+   DBG_SOK("Connect completed without error"
+           <<(SSL_session_reused(pImpl->ssl) ? "; session resumed." : "."));
    return XrdTls::TLS_AOK;
 }
 
@@ -415,7 +435,7 @@ XrdTlsPeerCerts *XrdTlsSocket::getCerts(bool ver)
 //
    X509 *pcert = SSL_get_peer_certificate(pImpl->ssl);
    if (pcert == 0) return 0;
-   return new XrdTlsPeerCerts(pcert, SSL_get_peer_cert_chain(pImpl->ssl));
+   return new XrdTlsPeerCerts(pcert, XrdTlsPeerCerts::getChain(pImpl->ssl));
 }
   
 /******************************************************************************/
@@ -746,6 +766,9 @@ void XrdTlsSocket::Shutdown(XrdTlsSocket::SDType sdType)
                    break;
              }
 
+       if (pImpl->isClient && pImpl->hsDone && !pImpl->sessHost.empty())
+          pImpl->tlsctx->SessionPut(pImpl->sessHost.c_str(), pImpl->ssl);
+
        DBG_SOK("Doing " <<how <<" shutdown.");
        SSL_set_shutdown(pImpl->ssl, sdMode);
 
@@ -773,6 +796,7 @@ void XrdTlsSocket::Shutdown(XrdTlsSocket::SDType sdType)
    SSL_free( pImpl->ssl );
    pImpl->ssl = 0;
    pImpl->fatal = 0;
+   pImpl->sessHost.clear();
 }
 
 /******************************************************************************/
@@ -67,6 +67,16 @@ bool TPCHandler::Configure(const char *configfn, XrdOucEnv *myEnv)
             } else {
                 m_first_timeout = 2*m_timeout;
             }
+        } else if (!strcmp("tpc.streams", val)) {
+            if (!ConfigureStreams(Config)) {
+                Config.Close();
+                return false;
+            }
+        } else if (!strcmp("tpc.engine", val)) {
+            if (!ConfigureEngine(Config)) {
+                Config.Close();
+                return false;
+            }
         }
     }
     Config.Close();
@@ -155,3 +165,96 @@ bool TPCHandler::ConfigureLogger(XrdOucStream &config_obj)
     
     return true;
 }
+
+bool TPCHandler::ConfigureStreams(XrdOucStream &config_obj)
+{
+    char *val = config_obj.GetWord();
+    if (!val || !val[0])
+    {
+        m_log.Emsg("Config", "tpc.streams requires at least one option [adaptive <max> | fixed | unordered | ordered]");
+        return false;
+    }
+
+    do {
+        if (!strcmp(val, "adaptive"))
+        {
+            int max_streams;
+            if (!(val = config_obj.GetWord()))
+            {
+                m_log.Emsg("Config", "tpc.streams adaptive maximum not specified");
+                return false;
+            }
+            if (XrdOuca2x::a2i(m_log, "adaptive stream maximum", val, &max_streams, 1, 100)) return false;
+            m_max_streams = max_streams;
+        }
+        else if (!strcmp(val, "fixed"))
+        {
+            m_max_streams = 0;
+        }
+        else if (!strcmp(val, "unordered"))
+        {
+            m_unordered_writes = true;
+        }
+        else if (!strcmp(val, "ordered"))
+        {
+            m_unordered_writes = false;
+        }
+        else
+        {
+            m_log.Emsg("Config", "tpc.streams encountered an unknown option (valid values: [adaptive <max> | fixed | unordered | ordered]):", val);
+            return false;
+        }
+        val = config_obj.GetWord();
+    } while (val);
+
+    return true;
+}
+
+bool TPCHandler::ConfigureEngine(XrdOucStream &config_obj)
+{
+    char *val = config_obj.GetWord();
+    if (!val || !val[0])
+    {
+        m_log.Emsg("Config", "tpc.engine requires at least one option [loops <n> | diskio <n> | on | off]");
+        return false;
+    }
+
+    // The engine is off by default; naming it turns it on with four loops.
+    m_engine_loops = 4;
+    do {
+        if (!strcmp(val, "loops"))
+        {
+            if (!(val = config_obj.GetWord()))
+            {
+                m_log.Emsg("Config", "tpc.engine loops value not specified");
+                return false;
+            }
+            if (XrdOuca2x::a2i(m_log, "transfer loop count", val, &m_engine_loops, 1, 64)) return false;
+        }
+        else if (!strcmp(val, "diskio"))
+        {
+            if (!(val = config_obj.GetWord()))
+            {
+                m_log.Emsg("Config", "tpc.engine diskio value not specified");
+                return false;
+            }
+            if (XrdOuca2x::a2i(m_log, "concurrent disk operations", val, &m_engine_diskio, 1, 1024)) return false;
+        }
+        else if (!strcmp(val, "on"))
+        {
+            if (!m_engine_loops) m_engine_loops = 4;
+        }
+        else if (!strcmp(val, "off"))
+        {
+            m_engine_loops = 0;
+        }
+        else
+        {
+            m_log.Emsg("Config", "tpc.engine encountered an unknown option (valid values: [loops <n> | diskio <n> | on | off]):", val);
+            return false;
+        }
+        val = config_obj.GetWord();
+    } while (val);
+
+    return true;
+}
@@ -0,0 +1,504 @@
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+#include "XrdTpcCurlMulti.hh"
+#include "XrdTpcEngine.hh"
+#include "XrdTpcState.hh"
+#include "XrdTpcStream.hh"
+
+using namespace TPC;
+
+const size_t EngineXfer::m_chunk_size;
+const size_t EngineXfer::m_queue_limit;
+
+/******************************************************************************/
+/*                E n g i n e X f e r   C o n s t r u c t o r                 */
+/******************************************************************************/
+
+EngineXfer::EngineXfer(Engine &engine, State &state) :
+    m_engine(engine),
+    m_state(state),
+    m_curl(state.GetHandle()),
+    m_loop(-1),
+    m_push(state.m_push),
+    m_cond(0),
+    m_front_pos(0),
+    m_queued(0),
+    m_read_offset(0),
+    m_sent(0),
+    m_eof(false),
+    m_paused(false),
+    m_failed(false),
+    m_added(false),
+    m_removed(false),
+    m_done(false),
+    m_result(static_cast<CURLcode>(-1))
+{
+    m_state.m_xfer = this;
+}
+
+/******************************************************************************/
+/*                 E n g i n e X f e r   D e s t r u c t o r                  */
+/******************************************************************************/
+
+EngineXfer::~EngineXfer()
+{
+    Cancel();
+    m_state.m_xfer = NULL;
+}
+
+/******************************************************************************/
+/*                       E n g i n e X f e r : : W a i t                      */
+/******************************************************************************/
+
+bool EngineXfer::Ready() const
+{
+    if (m_done) return true;
+    if (m_push) return !m_eof && !m_failed && m_queued <= m_queue_limit/2;
+    return m_queued >= m_chunk_size || m_paused;
+}
+
+void EngineXfer::Wait(time_t deadline)
+{
+    m_cond.Lock();
+    while (!Ready()) {
+        time_t now = time(NULL);
+        if (now >= deadline) break;
+        m_cond.Wait(static_cast<int>(deadline - now));
+    }
+    m_cond.UnLock();
+}
+
+/******************************************************************************/
+/*                       E n g i n e X f e r : : P u m p                      */
+/******************************************************************************/
+
+bool EngineXfer::Pump()
+{
+    bool resume, ok = true;
+
+    if (!m_push) {
+        // Take everything queued so far and let curl refill the queue while
+        // we write; the loop holds at most one queue's worth meanwhile.
+        std::deque<std::vector<char> > chunks;
+        m_cond.Lock();
+        chunks.swap(m_chunks);
+        m_queued = 0;
+        bool failed = m_failed;
+        resume = m_paused;
+        m_paused = false;
+        m_cond.UnLock();
+        if (resume) m_engine.Queue(*this, Engine::opResume);
+        if (failed) return true;
+
+        for (std::deque<std::vector<char> >::iterator it = chunks.begin();
+             it != chunks.end(); ++it) {
+            m_engine.DiskBegin();
+            ssize_t retval = m_state.Write(&(*it)[0], it->size());
+            m_engine.DiskEnd();
+            if (retval != static_cast<ssize_t>(it->size())) {
+                ok = false;
+                break;
+            }
+        }
+        return ok;
+    }
+
+    // Push: read ahead until the queue is full.  The bytes reported to the
+    // client are those handed to curl, not those read from disk.
+    while (true) {
+        m_cond.Lock();
+        m_state.m_offset = m_sent;
+        bool more = !m_eof && !m_failed && !m_done && m_queued < m_queue_limit;
+        m_cond.UnLock();
+        if (!more) break;
+
+        std::vector<char> chunk(m_chunk_size);
+        m_engine.DiskBegin();
+        int retval = m_state.m_stream->Read(m_state.m_start_offset + m_read_offset,
+                                            &chunk[0], chunk.size());
+        m_engine.DiskEnd();
+
+        m_cond.Lock();
+        if (retval < 0) {
+            ok = false;
+        } else if (retval == 0) {
+            m_eof = true;
+        } else {
+            chunk.resize(retval);
+            m_chunks.push_back(std::move(chunk));
+            m_queued += retval;
+            m_read_offset += retval;
+        }
+        resume = m_paused;
+        m_paused = false;
+        m_cond.UnLock();
+        if (resume) m_engine.Queue(*this, Engine::opResume);
+        if (!ok) break;
+    }
+    return ok;
+}
+
+/******************************************************************************/
+/*                      E n g i n e X f e r : : A b o r t                     */
+/******************************************************************************/
+
+void EngineXfer::Abort()
+{
+    m_cond.Lock();
+    m_failed = true;
+    bool resume = m_paused;
+    m_paused = false;
+    m_chunks.clear();
+    m_queued = 0;
+    m_cond.UnLock();
+
+    // A paused handle must be resumed so that its callback reports the error.
+    if (resume) m_engine.Queue(*this, Engine::opResume);
+}
+
+/******************************************************************************/
+/*                     E n g i n e X f e r : : C a n c e l                    */
+/******************************************************************************/
+
+void EngineXfer::Cancel()
+{
+    m_cond.Lock();
+    bool active = m_added && !m_removed;
+    m_cond.UnLock();
+    if (!active || !m_engine.Queue(*this, Engine::opCancel)) return;
+
+    m_cond.Lock();
+    while (!m_removed) m_cond.Wait();
+    m_cond.UnLock();
+}
+
+/******************************************************************************/
+/*                       E n g i n e X f e r : : D o n e                      */
+/******************************************************************************/
+
+bool EngineXfer::Done(CURLcode &res)
+{
+    m_cond.Lock();
+    bool done = m_done;
+    if (done) res = m_result;
+    m_cond.UnLock();
+    return done;
+}
+
+/******************************************************************************/
+/*                 E n g i n e X f e r : : C o n n e c t i o n                */
+/******************************************************************************/
+
+std::string EngineXfer::Connection()
+{
+    m_cond.Lock();
+    std::string conn = m_conn;
+    m_cond.UnLock();
+    return conn;
+}
+
+// Called with m_cond held from a curl callback, where the handle may be queried.
+void EngineXfer::NoteConnection()
+{
+    m_conn = m_state.ConnectionDescription();
+}
+
+/******************************************************************************/
+/*                    E n g i n e X f e r : : D e l i v e r                   */
+/******************************************************************************/
+
+size_t EngineXfer::Deliver(const char *buffer, size_t size)
+{
+    m_cond.Lock();
+    if (m_failed) {
+        m_cond.UnLock();
+        return 0;
+    }
+    if (m_queued >= m_queue_limit) {
+        m_paused = true;
+        m_cond.Signal();
+        m_cond.UnLock();
+        return CURL_WRITEFUNC_PAUSE;
+    }
+
+    if (m_chunks.empty() || m_chunks.back().size() + size > m_chunk_size) {
+        if (m_chunks.empty() || m_conn.empty()) NoteConnection();
+        m_chunks.push_back(std::vector<char>());
+        m_chunks.back().reserve(std::max(m_chunk_size, size));
+    }
+    m_chunks.back().insert(m_chunks.back().end(), buffer, buffer + size);
+
+    size_t before = m_queued;
+    m_queued += size;
+    if (before < m_chunk_size && m_queued >= m_chunk_size) m_cond.Signal();
+    m_cond.UnLock();
+    return size;
+}
+
+/******************************************************************************/
+/*                      E n g i n e X f e r : : F e t c h                     */
+/******************************************************************************/
+
+size_t EngineXfer::Fetch(char *buffer, size_t size)
+{
+    m_cond.Lock();
+    if (m_failed) {
+        m_cond.UnLock();
+        return CURL_READFUNC_ABORT;
+    }
+    if (!m_queued) {
+        if (m_eof) {
+            m_cond.UnLock();
+            return 0;
+        }
+        m_paused = true;
+        m_cond.Signal();
+        m_cond.UnLock();
+        return CURL_READFUNC_PAUSE;
+    }
+    if (m_conn.empty()) NoteConnection();
+
+    size_t copied = 0;
+    while (copied < size && !m_chunks.empty()) {
+        std::vector<char> &chunk = m_chunks.front();
+        size_t len = std::min(size - copied, chunk.size() - m_front_pos);
+        memcpy(buffer + copied, &chunk[m_front_pos], len);
+        copied += len;
+        m_front_pos += len;
+        if (m_front_pos == chunk.size()) {
+            m_chunks.pop_front();
+            m_front_pos = 0;
+            NoteConnection();
+        }
+    }
+
+    size_t before = m_queued;
+    m_queued -= copied;
+    m_sent += copied;
+    if (before > m_queue_limit/2 && m_queued <= m_queue_limit/2) m_cond.Signal();
+    m_cond.UnLock();
+    return copied;
+}
+
+/******************************************************************************/
+/*                    E n g i n e   C o n s t r u c t o r                     */
+/******************************************************************************/
+
+Engine::Engine(XrdSysError &log, int loops, int diskio) :
+    m_log(log),
+    m_diskio(diskio > 0 ? diskio : 1)
+{
+    for (int idx = 0; idx < std::max(loops, 1); idx++) {
+        m_loops.emplace_back(new Loop());
+        m_loops.back()->engine = this;
+    }
+}
+
+/******************************************************************************/
+/*                     E n g i n e   D e s t r u c t o r                      */
+/******************************************************************************/
+
+Engine::~Engine()
+{
+    for (size_t idx = 0; idx < m_loops.size(); idx++) {
+        Loop &loop = *m_loops[idx];
+        loop.mutex.Lock();
+        loop.stop = true;
+        loop.mutex.UnLock();
+        if (loop.running) {
+            Wake(loop);
+            XrdSysThread::Join(loop.tid, NULL);
+        }
+        if (loop.multi) curl_multi_cleanup(loop.multi);
+    }
+}
+
+/******************************************************************************/
+/*                           E n g i n e : : S t a r t                        */
+/******************************************************************************/
+
+bool Engine::Start()
+{
+    for (size_t idx = 0; idx < m_loops.size(); idx++) {
+        Loop &loop = *m_loops[idx];
+        if (!(loop.multi = curl_multi_init())) {
+            m_log.Emsg("Engine", "Failed to initialize a libcurl multi-handle");
+            return false;
+        }
+        int rc = XrdSysThread::Run(&loop.tid, Engine::Run, &loop,
+                                   XRDSYSTHREAD_HOLD, "TPC transfer loop");
+        if (rc) {
+            m_log.Emsg("Engine", rc, "start transfer loop thread");
+            return false;
+        }
+        loop.running = true;
+    }
+    return true;
+}
+
+/******************************************************************************/
+/*                             E n g i n e : : A d d                          */
+/******************************************************************************/
+
+bool Engine::Add(EngineXfer &xfer, const std::string &url)
+{
+    // Key the loop on the authority ([user@]host[:port]) of the remote URL so
+    // that all transfers to a host share one connection cache.
+    std::string::size_type beg = url.find("://");
+    beg = (beg == std::string::npos) ? 0 : beg + 3;
+    std::string::size_type end = url.find_first_of("/?#", beg);
+    std::string host = url.substr(beg, end == std::string::npos ? std::string::npos : end - beg);
+    std::string::size_type at = host.rfind('@');
+    if (at != std::string::npos) host.erase(0, at + 1);
+
+    xfer.m_loop = std::hash<std::string>()(host) % m_loops.size();
+    return Queue(xfer, opAdd);
+}
+
+/******************************************************************************/
+/*                          E n g i n e : : Q u e u e                         */
+/******************************************************************************/
+
+bool Engine::Queue(EngineXfer &xfer, OpCode code)
+{
+    Loop &loop = *m_loops[xfer.m_loop];
+    {
+        XrdSysMutexHelper lock(loop.mutex);
+        xfer.m_cond.Lock();
+        bool gone = (code == opAdd) ? loop.stop : xfer.m_removed;
+        if (code == opAdd && !gone) xfer.m_added = true;
+        xfer.m_cond.UnLock();
+        if (gone) return false;
+        Op op = {code, &xfer};
+        loop.ops.push_back(op);
+    }
+    Wake(loop);
+    return true;
+}
+
+/******************************************************************************/
+/*                           E n g i n e : : W a k e                          */
+/******************************************************************************/
+
+void Engine::Wake(Loop &loop)
+{
+#ifdef HAVE_CURL_MULTI_WAKEUP
+    curl_multi_wakeup(loop.multi);
+#endif
+}
+
+/******************************************************************************/
+/*                            E n g i n e : : R u n                           */
+/******************************************************************************/
+
+void *Engine::Run(void *arg)
+{
+    Loop *loop = static_cast<Loop *>(arg);
+    loop->engine->Drive(*loop);
+    return NULL;
+}
+
+/******************************************************************************/
+/*                          E n g i n e : : D r i v e                         */
+/******************************************************************************/
+
+void Engine::Drive(Loop &loop)
+{
+    std::vector<Op> ops;
+    int running = 0;
+
+    while (true) {
+        loop.mutex.Lock();
+        bool stop = loop.stop;
+        ops.swap(loop.ops);
+        loop.mutex.UnLock();
+        if (stop) break;
+
+        // Apply the requests of the transfer threads.  An operation is only
+        // queued while the loop still references the transfer (see Release).
+        for (std::vector<Op>::iterator it = ops.begin(); it != ops.end(); ++it) {
+            CURL *curl = it->xfer->m_curl;
+            if (it->code == opAdd) {
+                curl_easy_setopt(curl, CURLOPT_PRIVATE, it->xfer);
+                CURLMcode mres = curl_multi_add_handle(loop.multi, curl);
+                if (mres != CURLM_OK) {
+                    m_log.Emsg("Engine", "Failed to add transfer to libcurl multi-handle:",
+                               curl_multi_strerror(mres));
+                    Release(loop, it->xfer, CURLE_FAILED_INIT);
+                }
+            } else if (it->code == opResume) {
+                curl_easy_pause(curl, CURLPAUSE_CONT);
+            } else {
+                curl_multi_remove_handle(loop.multi, curl);
+                Release(loop, it->xfer, static_cast<CURLcode>(-1));
+            }
+        }
+        ops.clear();
+
+        CURLMcode mres = curl_multi_perform(loop.multi, &running);
+        if (mres != CURLM_OK && mres != CURLM_CALL_MULTI_PERFORM) {
+            m_log.Emsg("Engine", "Internal libcurl multi-handle error:",
+                       curl_multi_strerror(mres));
+        }
+
+        CURLMsg *msg;
+        int msgq = 0;
+        while ((msg = curl_multi_info_read(loop.multi, &msgq))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            CURL *curl = msg->easy_handle;
+            CURLcode res = msg->data.result;
+            EngineXfer *xfer = NULL;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, &xfer);
+            curl_multi_remove_handle(loop.multi, curl);
+            if (xfer) Release(loop, xfer, res);
+        }
+
+#ifdef HAVE_CURL_MULTI_WAKEUP
+        curl_multi_poll(loop.multi, NULL, 0, 1000, NULL);
+#else
+        // Without curl_multi_wakeup() new requests are only noticed when the
+        // wait times out, so keep it short.
+        if (!running) {
+            XrdSysTimer::Wait(50);
+        } else {
+            int fd_count;
+#ifdef HAVE_CURL_MULTI_WAIT
+            curl_multi_wait(loop.multi, NULL, 0, 50, &fd_count);
+#else
+            curl_multi_wait_impl(loop.multi, 50, &fd_count);
+#endif
+        }
+#endif
+    }
+}
+
+/******************************************************************************/
+/*                        E n g i n e : : R e l e a s e                       */
+/******************************************************************************/
+
+void Engine::Release(Loop &loop, EngineXfer *xfer, CURLcode res)
+{
+    // Drop any queued operation for the transfer, then mark it released; both
+    // under the loop mutex so no new operation can be queued in between.
+    XrdSysMutexHelper lock(loop.mutex);
+    std::vector<Op>::iterator it = loop.ops.begin();
+    while (it != loop.ops.end()) {
+        if (it->xfer == xfer) it = loop.ops.erase(it);
+        else ++it;
+    }
+
+    xfer->m_cond.Lock();
+    xfer->m_removed = true;
+    xfer->m_done = true;
+    xfer->m_result = res;
+    xfer->m_cond.Broadcast();
+    xfer->m_cond.UnLock();
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * The shared transfer engine drives single-stream HTTP-TPC transfers from a
+ * small pool of event-loop threads instead of one curl loop per request thread.
+ *
+ * Each loop owns a libcurl multi-handle; transfers are assigned to a loop by
+ * their remote host, so transfers to the same host share that loop's connection
+ * cache (and its TLS sessions) instead of opening new connections.  The curl
+ * callbacks only move data between the network and an in-memory queue; the
+ * request thread that owns the transfer performs the disk I/O, bounded by a
+ * process-wide limit on concurrent disk operations.
+ */
+
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <curl/curl.h>
+
+class XrdSysError;
+
+namespace TPC {
+class Engine;
+class State;
+
+class EngineXfer {
+public:
+    EngineXfer(Engine &engine, State &state);
+
+    // Removes the transfer from its loop if it is still running.
+    ~EngineXfer();
+
+    // Wait until there is data to move, the transfer is done or the deadline passes.
+    void Wait(time_t deadline);
+
+    // Move queued data to disk (pull) or refill the queue from disk (push).
+    // Returns false on a local I/O error; the caller should then Abort().
+    bool Pump();
+
+    // Fail the transfer from within the curl callbacks (as a local I/O error).
+    void Abort();
+
+    // Remove the transfer from its loop; returns once the loop no longer uses it.
+    void Cancel();
+
+    // Returns true once curl finished the transfer; res is then its result.
+    bool Done(CURLcode &res);
+
+    // The remote connection ("tcp:host:port") as seen from the loop thread.
+    std::string Connection();
+
+private:
+    friend class Engine;
+    friend class State;
+
+    EngineXfer(const EngineXfer &) = delete;
+    EngineXfer &operator=(const EngineXfer &) = delete;
+
+    // Called from the State libcurl callbacks on the loop thread.
+    size_t Deliver(const char *buffer, size_t size);
+    size_t Fetch(char *buffer, size_t size);
+    void   NoteConnection();
+
+    bool Ready() const;
+
+    static const size_t m_chunk_size = 1024*1024;    // granularity of the queue
+    static const size_t m_queue_limit = 8*1024*1024; // pause curl beyond this
+
+    Engine &m_engine;
+    State &m_state;
+    CURL *m_curl;
+    int m_loop;
+    bool m_push;
+    XrdSysCondVar m_cond;
+    std::deque<std::vector<char> > m_chunks;
+    size_t m_front_pos;  // bytes of the front chunk already sent (push)
+    size_t m_queued;     // bytes in m_chunks not yet consumed
+    off_t m_read_offset; // next file offset to read (push)
+    off_t m_sent;        // bytes handed to curl (push)
+    bool m_eof;          // the whole file has been queued (push)
+    bool m_paused;       // the curl handle is paused waiting on us
+    bool m_failed;       // a local error occurred; fail the transfer
+    bool m_added;        // the handle was added to a loop
+    bool m_removed;      // the loop no longer references this transfer
+    bool m_done;         // curl finished; m_result is valid
+    CURLcode m_result;
+    std::string m_conn;
+};
+
+class Engine {
+public:
+    Engine(XrdSysError &log, int loops, int diskio);
+    ~Engine();
+
+    // Start the loop threads; returns false if none could be started.
+    bool Start();
+
+    // Hand a transfer to the loop serving the host of url.
+    bool Add(EngineXfer &xfer, const std::string &url);
+
+    // Bracket a disk operation; at most 'diskio' run concurrently.
+    void DiskBegin() {m_diskio.Wait();}
+    void DiskEnd() {m_diskio.Post();}
+
+private:
+    friend class EngineXfer;
+
+    enum OpCode {opAdd, opResume, opCancel};
+
+    struct Op {
+        OpCode code;
+        EngineXfer *xfer;
+    };
+
+    struct Loop {
+        Loop() : multi(NULL), engine(NULL), running(false), stop(false) {}
+        CURLM *multi;
+        Engine *engine;
+        pthread_t tid;
+        bool running;
+        XrdSysMutex mutex;   // protects ops and stop
+        std::vector<Op> ops;
+        bool stop;
+    };
+
+    // Queue an operation for the loop of xfer; a resume or cancel is
+    // dropped if the loop already released the transfer.
+    bool Queue(EngineXfer &xfer, OpCode code);
+    void Wake(Loop &loop);
+
+    static void *Run(void *arg);
+    void Drive(Loop &loop);
+    void Release(Loop &loop, EngineXfer *xfer, CURLcode res);
+
+    XrdSysError &m_log;
+    std::vector<std::unique_ptr<Loop> > m_loops;
+    XrdSysSemaphore m_diskio;
+};
+
+}
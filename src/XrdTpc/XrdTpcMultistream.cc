@@ -106,9 +106,10 @@ public:
     }
 
     off_t StartTransfers(off_t current_offset, off_t content_length, size_t block_size,
-                         int &running_handles) {
+                         int &running_handles, size_t max_running) {
          bool started_new_xfer = false;
          do {
+             if (static_cast<size_t>(running_handles) >= max_running) {return current_offset;}
              size_t xfer_size = std::min(content_length - current_offset, static_cast<off_t>(block_size));
              if (xfer_size == 0) {return current_offset;}
              if (!(started_new_xfer = StartTransfer(current_offset, xfer_size))) {
@@ -143,6 +144,24 @@ public:
         return m_bytes_transferred;
     }
 
+    // Bytes received so far, including those of transfers still in progress.
+    off_t BytesReceived() const {
+        off_t bytes_received = m_bytes_transferred;
+        for (std::vector<CURL *>::const_iterator handle_iter = m_active_handles.begin();
+             handle_iter != m_active_handles.end();
+             handle_iter++) {
+            for (std::vector<State*>::const_iterator state_iter = m_states.begin();
+                 state_iter != m_states.end();
+                 state_iter++) {
+                if (*handle_iter == (*state_iter)->GetHandle()) {
+                    bytes_received += (*state_iter)->BytesTransferred();
+                    break;
+                }
+            }
+        }
+        return bytes_received;
+    }
+
     int GetStatusCode() const {
         return m_status_code;
     }
@@ -253,6 +272,87 @@ private:
     int                  m_status_code;
     std::string          m_error_message;
 };
+
+// Hill-climbing controller for the number of active streams.  Each update
+// supplies the goodput observed since the previous one; as long as the last
+// change improved goodput we keep moving in the same direction, if it made
+// things worse we reverse, and if it made no difference we hold.  After
+// holding for m_probe_after updates we try a neighbouring count, alternating
+// between more and fewer streams, so that changing network conditions are
+// noticed.  A probe for more streams is kept only if it improves goodput and
+// one for fewer streams only if goodput does not drop; otherwise it is undone.
+class StreamController {
+public:
+    StreamController(size_t initial, size_t max_streams) :
+        m_target(std::max(std::min(initial, max_streams), static_cast<size_t>(1))),
+        m_max(std::max(max_streams, static_cast<size_t>(1))),
+        m_direction(1),
+        m_holds(0),
+        m_probe(0),
+        m_next_probe(1),
+        m_last_rate(-1)
+    {}
+
+    size_t Target() const {return m_target;}
+
+    void Update(double rate) {
+        if (m_probe) {
+            int probe = m_probe;
+            m_probe = 0;
+            if (probe > 0 ? rate > m_last_rate * (1 + m_tolerance)
+                          : rate >= m_last_rate * (1 - m_tolerance)) {
+                m_direction = probe;
+                m_last_rate = rate;
+                Step(probe);
+            } else {
+                Step(-probe);
+            }
+            return;
+        }
+        if (m_last_rate >= 0) {
+            if (rate < m_last_rate * (1 - m_tolerance)) {
+                m_direction = -m_direction;
+            } else if (rate <= m_last_rate * (1 + m_tolerance)) {
+                m_last_rate = rate;
+                if (++m_holds >= m_probe_after) {
+                    m_holds = 0;
+                    m_probe = m_next_probe;
+                    m_next_probe = -m_next_probe;
+                    if (!Step(m_probe) && !Step(m_probe = -m_probe)) m_probe = 0;
+                }
+                return;
+            }
+        }
+        m_holds = 0;
+        m_last_rate = rate;
+        if (!Step(m_direction)) {
+            m_direction = -m_direction;
+        }
+    }
+
+private:
+    bool Step(int direction) {
+        if (direction > 0 && m_target < m_max) {
+            m_target++;
+        } else if (direction < 0 && m_target > 1) {
+            m_target--;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static constexpr double m_tolerance = 0.05;
+    static constexpr int    m_probe_after = 6;
+
+    size_t m_target;
+    size_t m_max;
+    int    m_direction;
+    int    m_holds;
+    int    m_probe;
+    int    m_next_probe;
+    double m_last_rate;
+};
 }
 
 
@@ -271,7 +371,12 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
 
     state.ResetAfterRequest();    
 
-    size_t concurrency = streams * m_pipelining_multiplier;
+    // When adaptive, the number of active streams varies between one and
+    // the larger of the requested and configured maximum; otherwise it stays
+    // at the requested count.
+    size_t max_streams = std::max(streams, m_max_streams);
+    size_t concurrency = max_streams * m_pipelining_multiplier;
+    StreamController controller(streams, m_max_streams ? max_streams : streams);
 
     handles.reserve(concurrency);
     handles.push_back(new State());
@@ -287,7 +392,7 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
 
 #ifdef USE_PIPELINING
     curl_multi_setopt(multi_handle, CURLMOPT_PIPELINING, 1);
-    curl_multi_setopt(multi_handle, CURLMOPT_MAX_HOST_CONNECTIONS, streams);
+    curl_multi_setopt(multi_handle, CURLMOPT_MAX_HOST_CONNECTIONS, max_streams);
 #endif
 
     // Start response to client prior to the first call to curl_multi_perform
@@ -303,7 +408,9 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
 
     // Start assigning transfers
     int running_handles = 0;
-    current_offset = mch.StartTransfers(current_offset, content_size, m_block_size, running_handles);
+    size_t max_running = controller.Target() * m_pipelining_multiplier;
+    current_offset = mch.StartTransfers(current_offset, content_size, m_block_size,
+                                        running_handles, max_running);
 
     // Transfer loop: use curl to actually run the transfer, but periodically
     // interrupt things to send back performance updates to the client.
@@ -312,6 +419,9 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
     off_t last_advance_bytes = 0;
     time_t last_advance_time = time(NULL);
     time_t transfer_start = last_advance_time;
+    // Goodput sample used to adapt the number of streams
+    off_t last_sample_bytes = 0;
+    time_t last_sample_time = transfer_start;
     CURLcode res = static_cast<CURLcode>(-1);
     CURLMcode mres = CURLM_OK;
     do {
@@ -322,7 +432,21 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
                 last_advance_bytes = current_offset;
                 last_advance_time = now;
             }
-            if (SendPerfMarker(req, rec, handles, current_offset)) {
+            if (m_max_streams && now > last_sample_time) {
+                off_t bytes_received = mch.BytesReceived();
+                controller.Update(static_cast<double>(bytes_received - last_sample_bytes) /
+                                  (now - last_sample_time));
+                last_sample_bytes = bytes_received;
+                last_sample_time = now;
+                if (controller.Target() * m_pipelining_multiplier != max_running) {
+                    max_running = controller.Target() * m_pipelining_multiplier;
+                    std::stringstream ss;
+                    ss << "Adjusting active streams to " << controller.Target();
+                    logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_ADAPT", ss.str());
+                }
+            }
+            if (SendPerfMarker(req, rec, handles, current_offset,
+                               m_max_streams ? static_cast<int>(controller.Target()) : 0)) {
                 logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
                     "Failed to send a perf marker to the TPC client");
                 return -1;
@@ -368,12 +492,13 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
             break;
         }
 
-        if (running_handles < static_cast<int>(concurrency)) {
+        if (running_handles < static_cast<int>(max_running)) {
             // Issue new transfers if there is still pending work to do.
             // Otherwise, continue running until there are no handles left.
             if (current_offset != content_size) {
                 current_offset = mch.StartTransfers(current_offset, content_size,
-                                                    m_block_size, running_handles);
+                                                    m_block_size, running_handles,
+                                                    max_running);
                 if (!running_handles) {
                     std::stringstream ss;
                     ss << "No handles are able to run.  Streams=" << streams << ", concurrency="
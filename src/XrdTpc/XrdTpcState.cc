@@ -9,6 +9,7 @@
 
 #include <curl/curl.h>
 
+#include "XrdTpcEngine.hh"
 #include "XrdTpcState.hh"
 #include "XrdTpcStream.hh"
 
@@ -189,6 +190,9 @@ size_t State::WriteCB(void *buffer, size_t size, size_t nitems, void *userdata)
         else
             return size*nitems;
     }  // Status indicates failure.
+    if (obj->m_xfer) {
+        return obj->m_xfer->Deliver(static_cast<char*>(buffer), size*nitems);
+    }  // The engine queues the data; the request thread writes it.
     return obj->Write(static_cast<char*>(buffer), size*nitems);
 }
 
@@ -222,6 +226,9 @@ size_t State::ReadCB(void *buffer, size_t size, size_t nitems, void *userdata) {
     State *obj = static_cast<State*>(userdata);
     if (obj->GetStatusCode() < 0) {return 0;}  // malformed request - got body before headers.
     if (obj->GetStatusCode() >= 400) {return 0;}  // Status indicates failure.
+    if (obj->m_xfer) {
+        return obj->m_xfer->Fetch(static_cast<char*>(buffer), size*nitems);
+    }  // The request thread reads ahead into the engine queue.
     return obj->Read(static_cast<char*>(buffer), size*nitems);
 }
 
@@ -288,6 +295,15 @@ bool State::Finalize()
 }
 
 std::string State::GetConnectionDescription()
+{
+    // The handle of an engine transfer belongs to the loop thread.
+    if (m_xfer) {
+        return m_xfer->Connection();
+    }
+    return ConnectionDescription();
+}
+
+std::string State::ConnectionDescription()
 {
     // CURLINFO_PRIMARY_PORT is only defined for 7.21.0 or later; on older
     // library versions, simply omit this information.
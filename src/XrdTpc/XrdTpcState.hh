@@ -15,6 +15,7 @@ typedef void CURL;
 struct curl_slist;
 
 namespace TPC {
+class EngineXfer;
 class Stream;
 
 class State {
@@ -32,7 +33,8 @@ public:
         m_stream(NULL),
         m_curl(NULL),
         m_headers(NULL),
-        m_is_transfer_state(true)
+        m_is_transfer_state(true),
+        m_xfer(NULL)
     {}
 
     /**
@@ -51,7 +53,8 @@ public:
         m_stream(NULL),
         m_curl(curl),
         m_headers(NULL),
-        m_is_transfer_state(false)
+        m_is_transfer_state(false),
+        m_xfer(NULL)
     {
         InstallHandlers(curl);
     }
@@ -71,7 +74,8 @@ public:
         m_stream(&stream),
         m_curl(curl),
         m_headers(NULL),
-        m_is_transfer_state(true)
+        m_is_transfer_state(true),
+        m_xfer(NULL)
     {
         InstallHandlers(curl);
     }
@@ -137,8 +141,12 @@ public:
     std::string GetConnectionDescription();
 
 private:
+    friend class EngineXfer;
+
     bool InstallHandlers(CURL *curl);
 
+    std::string ConnectionDescription();
+
     State(const State&);
     // Add back once C++11 is available
     //State(State &&) noexcept;
@@ -167,6 +175,7 @@ private:
     std::string m_resp_protocol;  // Response protocol in the HTTP status line.
     std::string m_error_buf;  // Any error associated with a response.
     bool m_is_transfer_state; // If set to true, this state will be used to perform some transfers
+    EngineXfer *m_xfer; // If set, the transfer is driven by the shared engine; callbacks go through it.
 };
 
 };
@@ -73,14 +73,14 @@ Stream::Write(off_t offset, const char *buf, size_t size, bool force)
     }
     size_t bytes_accepted = 0;
     int retval = size;
-    if (offset < m_offset) {
+    if (offset < m_offset && !m_unordered) {
         if (!m_error_buf.size()) {m_error_buf = "Logic error: writing to a prior offset";}
         return SFS_ERROR;
     }
-    // If this is write is appending to the stream and
-    // MB-aligned, then we write it to disk; otherwise, the
-    // data will be buffered.
-    if (offset == m_offset && (force || (size && !(size % (1024*1024))))) {
+    // If this is write is appending to the stream (or the stream is
+    // unordered) and MB-aligned, then we write it to disk; otherwise,
+    // the data will be buffered.
+    if ((offset == m_offset || m_unordered) && (force || (size && !(size % (1024*1024))))) {
         retval = WriteImpl(offset, buf, size);
         bytes_accepted = retval;
             // On failure, we don't care about flushing buffers from memory --
@@ -23,6 +23,7 @@ class Stream {
 public:
     Stream(std::unique_ptr<XrdSfsFile> fh, size_t max_blocks, size_t buffer_size, XrdSysError &log)
         : m_open_for_write(false),
+          m_unordered(false),
           m_avail_count(max_blocks),
           m_fh(std::move(fh)),
           m_offset(0),
@@ -53,6 +54,12 @@ public:
     // the error code and error message for the stream
     ssize_t Write(off_t offset, const char *buffer, size_t size, bool force);
 
+    // Allow full buffers to be written at their offset as soon as they are
+    // filled rather than waiting for all prior data to be written.  The
+    // buffers still combine small writes but no longer reorder them; only
+    // suitable when the filesystem supports out-of-order (sparse) writes.
+    void SetUnordered() {m_unordered = true;}
+
     size_t AvailableBuffers() const {return m_avail_count;}
 
     void DumpBuffers() const;
@@ -150,7 +157,7 @@ private:
         Entry(const Entry&) = delete;
 
         bool CanWrite(Stream &stream) const {
-            return (m_size > 0) && (m_offset == stream.m_offset);
+            return (m_size > 0) && (m_offset == stream.m_offset || stream.m_unordered);
         }
 
         off_t m_offset;  // Offset within file that m_buffer[0] represents.
@@ -162,9 +169,10 @@ private:
     ssize_t WriteImpl(off_t offset, const char *buffer, size_t size);
 
     bool m_open_for_write;
+    bool m_unordered;
     size_t m_avail_count;
     std::unique_ptr<XrdSfsFile> m_fh;
-    off_t m_offset;
+    off_t m_offset;  // Next offset to write; a running byte count when unordered.
     std::vector<Entry*> m_buffers;
     XrdSysError &m_log;
     std::string m_error_buf;
@@ -24,6 +24,7 @@
 #include "XrdTpcStream.hh"
 #include "XrdTpcTPC.hh"
 #include "XrdTpcCurlMulti.hh"
+#include "XrdTpcEngine.hh"
 #include <fstream>
 
 using namespace TPC;
@@ -35,6 +36,8 @@ int TPCHandler::m_marker_period = 5;
 size_t TPCHandler::m_block_size = 16*1024*1024;
 size_t TPCHandler::m_small_block_size = 1*1024*1024;
 XrdSysMutex TPCHandler::m_monid_mutex;
+CURLSH *TPCHandler::m_curl_share = NULL;
+XrdSysMutex TPCHandler::m_curl_share_mutex[CURL_LOCK_DATA_LAST];
 
 XrdVERSIONINFO(XrdHttpGetExtHandler, HttpTPC);
 
@@ -82,6 +85,26 @@ void CurlDeleter::operator()(CURL *curl)
     if (curl) curl_easy_cleanup(curl);
 }
 
+/******************************************************************************/
+/*                   s h a r e _ l o c k _ c a l l b a c k                    */
+/******************************************************************************/
+
+/**
+ * Called by libcurl around every access to the data held by the share handle.
+ * Each kind of data has its own mutex so that, e.g., DNS lookups do not wait
+ * for the TLS session cache.
+ */
+void TPCHandler::share_lock_callback(CURL *, curl_lock_data data,
+                                     curl_lock_access, void *)
+{
+    m_curl_share_mutex[data].Lock();
+}
+
+void TPCHandler::share_unlock_callback(CURL *, curl_lock_data data, void *)
+{
+    m_curl_share_mutex[data].UnLock();
+}
+
 /******************************************************************************/
 /*           s o c k o p t _ s e t c l o e x e c _ c a l l b a c k            */
 /******************************************************************************/
@@ -307,6 +330,10 @@ TPCHandler::TPCHandler(XrdSysError *log, const char *config, XrdOucEnv *myEnv) :
         m_desthttps(false),
         m_timeout(60),
         m_first_timeout(120),
+        m_max_streams(0),
+        m_unordered_writes(false),
+        m_engine_loops(0),
+        m_engine_diskio(16),
         m_log(log->logger(), "TPC_"),
         m_sfs(NULL)
 {
@@ -314,6 +341,28 @@ TPCHandler::TPCHandler(XrdSysError *log, const char *config, XrdOucEnv *myEnv) :
         throw std::runtime_error("Failed to configure the HTTP third-party-copy handler.");
     }
 
+// Set up the share handle used by all transfers. Connections are not put in
+// it; transfers to a host share the connection cache of their engine loop.
+//
+   if (!m_curl_share && (m_curl_share = curl_share_init())) {
+      curl_share_setopt(m_curl_share, CURLSHOPT_LOCKFUNC, share_lock_callback);
+      curl_share_setopt(m_curl_share, CURLSHOPT_UNLOCKFUNC, share_unlock_callback);
+      curl_share_setopt(m_curl_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      curl_share_setopt(m_curl_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+   }
+
+// Start the loops that drive single-stream transfers, if so configured. Should
+// that fail, each transfer is run on its own request thread as before.
+//
+   if (m_engine_loops) {
+      m_engine.reset(new Engine(m_log, m_engine_loops, m_engine_diskio));
+      if (!m_engine->Start()) {
+         m_log.Emsg("Config", "Unable to start the transfer engine; "
+                              "running each transfer on its own thread.");
+         m_engine.reset();
+      }
+   }
+
 // Extract out the TPC monitoring object (we share it with xrootd).
 //
    XrdXrootdGStream *gs = (XrdXrootdGStream*)myEnv->GetPtr("Tpc.gStream*");
@@ -520,7 +569,7 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, TPC::State
 /******************************************************************************/
   
 int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vector<State*> &state,
-    off_t bytes_transferred)
+    off_t bytes_transferred, int active_streams)
 {
     // The 'performance marker' format is largely derived from how GridFTP works
     // (e.g., the concept of `Stripe` is not quite so relevant here).  See:
@@ -556,6 +605,9 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
     }
     if (!first)
         ss << "RemoteConnections: " << ss2.str() << crlf;
+    // With adaptive streams, also report how many are currently running.
+    if (active_streams > 0)
+        ss << "Active Streams: " << active_streams << crlf;
     ss << "End" << crlf;
     rec.bytes_transferred = bytes_transferred;
     logTransferEvent(LogMask::Debug, rec, "PERF_MARKER");
@@ -563,6 +615,85 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
     return req.ChunkResp(ss.str().c_str(), 0);
 }
 
+/******************************************************************************/
+/* XRD_CHUNK_RESP:                                                            */
+/*         T P C H a n d l e r : : R u n C u r l W i t h E n g i n e          */
+/******************************************************************************/
+  
+int TPCHandler::RunCurlWithEngine(XrdHttpExtReq &req, State &state,
+    TPCLogRecord &rec)
+{
+    // The transfer itself runs on a shared loop thread; this thread moves the
+    // data to or from disk and periodically sends back performance updates.
+    EngineXfer xfer(*m_engine, state);
+
+    // Start response to client prior to handing over the transfer
+    int retval = req.StartChunkedResp(201, "Created", "Content-Type: text/plain");
+    if (retval) {
+        logTransferEvent(LogMask::Error, rec, "RESPONSE_FAIL",
+            "Failed to send the initial response to the TPC client");
+        return retval;
+    } else {
+        logTransferEvent(LogMask::Debug, rec, "RESPONSE_START",
+            "Initial transfer response sent to the TPC client");
+    }
+
+    if (!m_engine->Add(xfer, rec.remote)) {
+        char msg[] = "Internal server error: transfer engine unavailable";
+        logTransferEvent(LogMask::Error, rec, "TRANSFER_CURL_ERROR", msg);
+        if ((retval = req.ChunkResp(msg, 0))) {
+            logTransferEvent(LogMask::Error, rec, "RESPONSE_FAIL",
+                "Failed to send error message to the TPC client");
+            return retval;
+        }
+        return req.ChunkResp(NULL, 0);
+    }
+
+    time_t last_marker = 0;
+    // Track how long it's been since the last time we recorded more bytes being transferred.
+    off_t last_advance_bytes = 0;
+    time_t last_advance_time = time(NULL);
+    time_t transfer_start = last_advance_time;
+    CURLcode res = static_cast<CURLcode>(-1);
+    while (true) {
+        time_t now = time(NULL);
+        time_t next_marker = last_marker + m_marker_period;
+        if (now >= next_marker) {
+            off_t bytes_xfer = state.BytesTransferred();
+            if (bytes_xfer > last_advance_bytes) {
+                last_advance_bytes = bytes_xfer;
+                last_advance_time = now;
+            }
+            if (SendPerfMarker(req, rec, state)) {
+                xfer.Cancel();
+                logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
+                    "Failed to send a perf marker to the TPC client");
+                return -1;
+            }
+            int timeout = (transfer_start == last_advance_time) ? m_first_timeout : m_timeout;
+            if (now > last_advance_time + timeout) {
+                state.SetErrorCode(10);
+                std::stringstream ss;
+                ss << "Transfer failed because no bytes have been received in " << timeout << " seconds.";
+                state.SetErrorMessage(ss.str());
+                xfer.Cancel();
+                break;
+            }
+            last_marker = now;
+            next_marker = now + m_marker_period;
+        }
+
+        // Check for completion before pumping so that everything curl queued
+        // before it finished is still written out.
+        bool done = xfer.Done(res);
+        if (!xfer.Pump()) xfer.Abort();
+        if (done) break;
+        xfer.Wait(next_marker);
+    }
+
+    return SendTransferResult(req, state, rec, res);
+}
+
 /******************************************************************************/
 /* XRD_CHUNK_RESP:                                                            */
 /*        T P C H a n d l e r : : R u n C u r l W i t h U p d a t e s         */
@@ -571,6 +702,10 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
 int TPCHandler::RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, State &state,
     TPCLogRecord &rec)
 {
+    if (m_engine) {
+        return RunCurlWithEngine(req, state, rec);
+    }
+
     // Create the multi-handle and add in the current transfer to it.
     CURLM *multi_handle = curl_multi_init();
     if (!multi_handle) {
@@ -712,9 +847,22 @@ int TPCHandler::RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, State &state,
         }
     } while (msg);
 
+    curl_multi_remove_handle(multi_handle, curl);
+    curl_multi_cleanup(multi_handle);
+
+    return SendTransferResult(req, state, rec, res);
+}
+
+/******************************************************************************/
+/* XRD_CHUNK_RESP:                                                            */
+/*        T P C H a n d l e r : : S e n d T r a n s f e r R e s u l t         */
+/******************************************************************************/
+  
+int TPCHandler::SendTransferResult(XrdHttpExtReq &req, State &state,
+    TPCLogRecord &rec, CURLcode res)
+{
+    int retval;
     if (!state.GetErrorCode() && res == static_cast<CURLcode>(-1)) { // No transfers returned?!?
-        curl_multi_remove_handle(multi_handle, curl);
-        curl_multi_cleanup(multi_handle);
         char msg[] = "Internal state error in libcurl";
         logTransferEvent(LogMask::Error, rec, "TRANSFER_CURL_ERROR", msg);
 
@@ -725,7 +873,6 @@ int TPCHandler::RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, State &state,
         }
         return req.ChunkResp(NULL, 0);
     }
-    curl_multi_cleanup(multi_handle);
 
     state.Flush();
 
@@ -846,6 +993,7 @@ int TPCHandler::ProcessPushReq(const std::string & resource, XrdHttpExtReq &req)
         return req.SendSimpleResp(rec.status, NULL, NULL, msg, 0);
     }
     curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
+    if (m_curl_share) curl_easy_setopt(curl, CURLOPT_SHARE, m_curl_share);
 //  curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, sockopt_setcloexec_callback);
     curl_easy_setopt(curl, CURLOPT_OPENSOCKETFUNCTION, opensocket_callback);
     curl_easy_setopt(curl, CURLOPT_OPENSOCKETDATA, &rec);
@@ -926,6 +1074,7 @@ int TPCHandler::ProcessPullReq(const std::string &resource, XrdHttpExtReq &req)
             return req.SendSimpleResp(rec.status, NULL, NULL, msg, 0);
     }
     curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
+    if (m_curl_share) curl_easy_setopt(curl, CURLOPT_SHARE, m_curl_share);
 //  curl_easy_setopt(curl,CURLOPT_SOCKOPTFUNCTION,sockopt_setcloexec_callback);
     curl_easy_setopt(curl, CURLOPT_OPENSOCKETFUNCTION, opensocket_callback);
     curl_easy_setopt(curl, CURLOPT_OPENSOCKETDATA, &rec);
@@ -1004,7 +1153,9 @@ int TPCHandler::ProcessPullReq(const std::string &resource, XrdHttpExtReq &req)
         fh->close();
         return resp_result;
     }
-    Stream stream(std::move(fh), streams * m_pipelining_multiplier, streams > 1 ? m_block_size : m_small_block_size, m_log);
+    size_t max_streams = std::max(static_cast<size_t>(streams), m_max_streams);
+    Stream stream(std::move(fh), max_streams * m_pipelining_multiplier, streams > 1 ? m_block_size : m_small_block_size, m_log);
+    if (m_unordered_writes) stream.SetUnordered();
     State state(0, stream, curl, false);
     state.CopyHeaders(req);
 
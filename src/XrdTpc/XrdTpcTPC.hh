@@ -21,6 +21,7 @@ class XrdXrootdTpcMon;
 typedef void CURL;
 
 namespace TPC {
+class Engine;
 class State;
 
 enum LogMask {
@@ -51,6 +52,9 @@ public:
 private:
 
     static int sockopt_setcloexec_callback(void * clientp, curl_socket_t curlfd, curlsocktype purpose);
+    static void share_lock_callback(CURL *curl, curl_lock_data data,
+                                    curl_lock_access access, void *userptr);
+    static void share_unlock_callback(CURL *curl, curl_lock_data data, void *userptr);
     static int opensocket_callback(void *clientp,
                                    curlsocktype purpose,
                                    struct curl_sockaddr *address);
@@ -106,12 +110,19 @@ private:
     // (such as whether the transfer is happening over IPv4, IPv6, or both).
     int SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, TPC::State &state);
     int SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vector<State*> &state,
-        off_t bytes_transferred);
+        off_t bytes_transferred, int active_streams = 0);
 
     // Perform the libcurl transfer, periodically sending back chunked updates.
     int RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, TPC::State &state,
                            TPCLogRecord &rec);
 
+    // Version of RunCurlWithUpdates driving the transfer through the shared engine.
+    int RunCurlWithEngine(XrdHttpExtReq &req, TPC::State &state, TPCLogRecord &rec);
+
+    // Flush and close the local file, then send the final transfer status.
+    int SendTransferResult(XrdHttpExtReq &req, TPC::State &state,
+                           TPCLogRecord &rec, CURLcode res);
+
     // Experimental multi-stream version of RunCurlWithUpdates
     int RunCurlWithStreams(XrdHttpExtReq &req, TPC::State &state,
                            size_t streams, TPCLogRecord &rec);
@@ -131,6 +142,8 @@ private:
                         std::string &path2, bool &path2_alt);
     bool Configure(const char *configfn, XrdOucEnv *myEnv);
     bool ConfigureLogger(XrdOucStream &Config);
+    bool ConfigureStreams(XrdOucStream &Config);
+    bool ConfigureEngine(XrdOucStream &Config);
 
     // Generate a consistently-formatted log message.
     void logTransferEvent(LogMask lvl, const TPCLogRecord &record,
@@ -143,10 +156,19 @@ private:
     int m_timeout; // the 'timeout interval'; if no bytes have been received during this time period, abort the transfer.
     int m_first_timeout; // the 'first timeout interval'; the amount of time we're willing to wait to get the first byte.
                          // Unless explicitly specified, this is 2x the timeout interval.
+    size_t m_max_streams; // If non-zero, the number of active streams of a multi-stream pull adapts up to this limit.
+    bool m_unordered_writes; // Write multi-stream blocks at their offset as they arrive instead of reordering them.
+    int m_engine_loops;  // Number of shared transfer loop threads; zero runs each transfer on its own thread.
+    int m_engine_diskio; // Maximum number of concurrent disk operations of engine transfers.
+    std::unique_ptr<Engine> m_engine;
     std::string m_cadir;  // The directory to use for CAs.
     std::string m_cafile; // The file to use for CAs in libcurl
     static XrdSysMutex m_monid_mutex;
     static uint64_t m_monid;
+    // Shared by all transfers so that DNS lookups and TLS sessions for a
+    // remote host are reused instead of paying a full handshake per transfer.
+    static CURLSH *m_curl_share;
+    static XrdSysMutex m_curl_share_mutex[CURL_LOCK_DATA_LAST];
     XrdSysError m_log;
     XrdSfsFileSystem *m_sfs;
     std::shared_ptr<XrdTlsTempCA> m_ca_file;
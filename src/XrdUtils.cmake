@@ -117,6 +117,7 @@ set ( XrdOucSources
                                 XrdOuc/XrdOucHash.icc
   XrdOuc/XrdOucHashVal.cc
                                 XrdOuc/XrdOucJson.hh
+  XrdOuc/XrdOucLatency.cc       XrdOuc/XrdOucLatency.hh
   XrdOuc/XrdOucLogging.cc       XrdOuc/XrdOucLogging.hh
                                 XrdOuc/XrdOucMapP2X.hh
   XrdOuc/XrdOucMsubs.cc         XrdOuc/XrdOucMsubs.hh
@@ -234,6 +235,7 @@ set ( XrdSources
   #-----------------------------------------------------------------------------
 set ( XrdCksSources
   XrdCks/XrdCksAssist.cc           XrdCks/XrdCksAssist.hh
+  XrdCks/XrdCksCalcadler32.cc      XrdCks/XrdCksCalcadler32.hh
   XrdCks/XrdCksCalccrc32.cc        XrdCks/XrdCksCalccrc32.hh
   XrdCks/XrdCksCalccrc32C.cc       XrdCks/XrdCksCalccrc32C.hh
   XrdCks/XrdCksCalcmd5.cc          XrdCks/XrdCksCalcmd5.hh
@@ -241,7 +243,7 @@ set ( XrdCksSources
   XrdCks/XrdCksLoader.cc           XrdCks/XrdCksLoader.hh
   XrdCks/XrdCksManager.cc          XrdCks/XrdCksManager.hh
   XrdCks/XrdCksManOss.cc           XrdCks/XrdCksManOss.hh
-                                   XrdCks/XrdCksCalcadler32.hh
+  XrdCks/XrdCksPipeline.cc         XrdCks/XrdCksPipeline.hh
                                    XrdCks/XrdCksCalc.hh
                                    XrdCks/XrdCksData.hh
                                    XrdCks/XrdCks.hh
@@ -44,6 +44,7 @@
   
 #include "XrdVersion.hh" 
 #include "XrdHttp/XrdHttpSecXtractor.hh"
+#include "XrdTls/XrdTlsPeerCerts.hh"
 #include "XrdSec/XrdSecInterface.hh"
 
 #include "XrdVoms.hh"
@@ -97,7 +98,7 @@ int XrdVomsHttp::GetSecData(XrdLink *lp, XrdSecEntity &sec, SSL *ssl)
 //
    xCerts.cert  = SSL_get_peer_certificate(ssl);
    if (!xCerts.cert) return 0;
-   xCerts.chain = SSL_get_peer_cert_chain(ssl);
+   xCerts.chain = XrdTlsPeerCerts::getChain(ssl);
 
 // The API calls for the cert member in the SecEntity point to the certs
 //
@@ -85,7 +85,7 @@ void XrdXrootdAioFob::Reset()
               aioP->Recycle(true);
              }
         aioQ[i].last = 0;
-        Running[i] = false;
+        Running[i] = 0;
        }
 
    fobMutex.UnLock();
@@ -108,7 +108,7 @@ void XrdXrootdAioFob::Reset(XrdXrootdProtocol *protP)
          aioP->Recycle(true);
         }
    aioQ[pathID].last = 0;
-   Running[pathID] = false;
+   Running[pathID] = 0;
 
    fobMutex.UnLock();
 }
@@ -121,11 +121,12 @@ void XrdXrootdAioFob::Schedule(XrdXrootdAioTask *aioP)
 {
    int pathID = aioP->Protocol->getPathID();
 
-// Run or queue this task
+// Run or queue this task. Normally, only one task per stream runs at a time
+// but more may run if read pipelining has been enabled.
 //
    fobMutex.Lock();
 
-   if (Running[pathID])
+   if (Running[pathID] >= XrdXrootdProtocol::as_rdpipe)
       {if (aioQ[pathID].last) aioQ[pathID].last->nextTask = aioP;
           else aioQ[pathID].first = aioP;
        aioQ[pathID].last = aioP;
@@ -134,7 +135,7 @@ void XrdXrootdAioFob::Schedule(XrdXrootdAioTask *aioP)
        if (TRACING(TRACE_FSAIO)) Notify(aioP, "Queuing");
       } else {
        Sched->Schedule(aioP);
-       Running[pathID] = true;
+       Running[pathID]++;
        if (TRACING(TRACE_FSAIO)) Notify(aioP, "Running");
       }
 
@@ -147,7 +148,7 @@ void XrdXrootdAioFob::Schedule(XrdXrootdProtocol *protP)
 {
    int pathID = protP->getPathID();
 
-// Schedule the next task.
+// Schedule the next task in place of the one that finished.
 //
    fobMutex.Lock();
 
@@ -156,9 +157,8 @@ void XrdXrootdAioFob::Schedule(XrdXrootdProtocol *protP)
        if (!(aioQ[pathID].first = aioP->nextTask)) aioQ[pathID].last = 0;
        aioP->nextTask = 0;
        Sched->Schedule(aioP);
-       Running[pathID] = true;
        if (TRACING(TRACE_FSAIO)) Notify(aioP, "Running");
-      } else  Running[pathID] = false;
+      } else if (Running[pathID] > 0) Running[pathID]--;
 
    fobMutex.UnLock();
 }
@@ -54,7 +54,7 @@ private:
 void         Notify(XrdXrootdAioTask *aioP, const char *what);
 
 XrdSysMutex         fobMutex;
-bool                Running[XrdXrootdProtocol::maxStreams] = {false};
+int                 Running[XrdXrootdProtocol::maxStreams] = {0};
 struct AioTasks
       {XrdXrootdAioTask *first;
        XrdXrootdAioTask *last;
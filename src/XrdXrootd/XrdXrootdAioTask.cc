@@ -35,6 +35,7 @@
 #include <sys/uio.h>
 #include "Xrd/XrdLink.hh"
 #include "Xrd/XrdScheduler.hh"
+#include "XrdOuc/XrdOucLatency.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysE2T.hh"
@@ -285,12 +286,27 @@ void XrdXrootdAioTask::Init(XrdXrootdProtocol *protP,
    dataLink   = resp.theLink();
    Response   = resp;
    dataFile   = fP;
+   latP       = 0;
    aioState   = 0;
    inFlight   = 0;
    isDone     = false;
    Status     = Running;
 }
   
+/******************************************************************************/
+/* Protected:                    l a t D o n e                                */
+/******************************************************************************/
+
+void XrdXrootdAioTask::latDone()
+{
+// Record the service time of the request, if it is being timed
+//
+   if (latP)
+      {latP->Service(XrdOucLatency::Now() - latBeg);
+       latP = 0;
+      }
+}
+  
 /******************************************************************************/
 /* Protected:                  S e n d E r r o r                              */
 /******************************************************************************/
@@ -38,6 +38,7 @@
 using namespace XrdSys;
 
 class XrdLink;
+class XrdOucLatency;
 class XrdXrootdAioBuff;
 class XrdXrootdNormAio;
 class XrdXrootdPgrwAio;
@@ -60,6 +61,9 @@ virtual void               Read(long long offs, int dlen) = 0;
 
 virtual void               Recycle(bool release) = 0;
 
+        void               Timed(XrdOucLatency *lP, long long tBeg)
+                                {latP = lP; latBeg = tBeg;}
+
         XrdXrootdProtocol *urProtocol() {return Protocol;}
 
 virtual int                Write(long long offs, int dlen) = 0;
@@ -77,6 +81,7 @@ virtual bool               CopyL2F(XrdXrootdAioBuff *aioP) = 0;
         int                gdDone() override;
         void               gdFail() override;
         XrdXrootdAioBuff*  getBuff(bool wait);
+        void               latDone();
         void               SendError(int rc, const char *eText);
         void               SendFSError(int rc);
         bool               Validate(XrdXrootdAioBuff* aioP);
@@ -99,6 +104,8 @@ union  {XrdXrootdNormAio*  nextNorm;   // Never used in conflicting context!
 union  {XrdXrootdAioBuff  *finalRead;  // -> A short read indicating EOF
         XrdXrootdAioBuff  *pendWrite;  // -> Pending write operation
        };
+        XrdOucLatency*     latP;       // -> Histograms of the request or nil
+        long long          latBeg;     // Time the request started
         off_t              highOffset; // F2L: EOF offset L2F: initial offset
         off_t              dataOffset; // Next offset
         int                dataLen;    // Size remaining
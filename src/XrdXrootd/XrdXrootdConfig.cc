@@ -507,6 +507,7 @@ int XrdXrootdProtocol::Configure(char *parms, XrdProtocol_Config *pi)
    if (fsFeatures & XrdSfs::hasGPF)  myRole |= kXR_supgpf;
    if (fsFeatures & XrdSfs::hasGPFA && myRole & kXR_supgpf)
       myRole |= kXR_anongpf;
+   if (!isRedir) myRole |= kXR_supsxfull; // Redirectors cannot split a batch
 
 // Finally note whether or not we have TLS enabled
 //
@@ -788,7 +789,8 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
    Purpose:  To parse directive: async [limit <aiopl>] [maxsegs <msegs>]
                                        [maxtot <mtot>] [segsize <segsize>]
                                        [minsize <iosz>] [maxstalls <cnt>]
-                                       [timeout <tos>]
+                                       [timeout <tos>] [metaops <mops>]
+                                       [rdpipe <rdp>]
                                        [Debug] [force] [syncw] [off]
                                        [nocache] [nosf]
 
@@ -803,6 +805,17 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
                       to allow async processing to occur (default is maxbsz/2
                       typically 1M).
              <tos>    second timeout for async I/O.
+             <mops>   maximum number of stat and locate requests per link that
+                      may be handled on a separate thread while the link goes
+                      on with other requests. Each still occupies a thread
+                      while the file system works on it and opens are always
+                      handled inline. The default is 0 (disabled).
+             <rdp>    maximum number of reads against the same file from the
+                      same stream that may run concurrently. When greater than
+                      one, large reads use async I/O even when the file was
+                      not opened in async mode or the file system has no native
+                      async I/O; in which case reads run on separate threads.
+                      The default is 1.
              <cnt>    Maximum number of client stalls before synchronous i/o is
                       used. Async mode is tried after <cnt> requests.
              Debug    Turns on async I/O for everything. This an internal
@@ -823,7 +836,8 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
     int  i, ppp;
     int  V_force=-1, V_syncw = -1, V_off = -1, V_mstall = -1, V_nosf = -1;
     int  V_limit=-1, V_msegs=-1, V_mtot=-1, V_minsz=-1, V_segsz=-1;
-    int  V_minsf=-1, V_debug=-1, V_noca=-1, V_tmo=-1;
+    int  V_minsf=-1, V_debug=-1, V_noca=-1, V_tmo=-1, V_meta=-1;
+    int  V_rdpipe=-1;
     long long llp;
     struct asyncopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} asopts[] =
@@ -840,6 +854,8 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
         {"maxsegs",    0, &V_msegs, "async maxsegs"},
         {"maxstalls",  0, &V_mstall,"async maxstalls"},
         {"maxtot",     0, &V_mtot,  "async maxtot"},
+        {"rdpipe",     0, &V_rdpipe,"async rdpipe"},
+        {"metaops",    0, &V_meta,  "async metaops"},
         {"minsfsz",    1, &V_minsf, "async minsfsz"},
         {"minsize", 4096, &V_minsz, "async minsize"}};
     int numopts = sizeof(asopts)/sizeof(struct asyncopts);
@@ -914,6 +930,8 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
    if (V_segsz > 0){as_segsize   = V_segsz; as_seghalf = V_segsz/2;}
    if (V_tmo  >= 0) as_timeout   = V_tmo;
    if (V_mstall> 0) as_maxstalls = V_mstall;
+   if (V_meta  > 0) as_metaops   = V_meta;
+   if (V_rdpipe> 0) as_rdpipe    = V_rdpipe;
    if (V_debug > 0) asyncFlags  |= asDebug;
    if (V_force > 0) as_force     = true;
    if (V_off   > 0) as_aioOK     = false;
@@ -1917,11 +1935,15 @@ int XrdXrootdProtocol::xtls(XrdOucStream &Config)
 /* Function: xtlsr
 
    Purpose:  To parse the directive: tlsreuse off | on [flush <ft>[h|m|s]]
+                                                       [notickets]
 
              off       turns off the TLS session reuse cache.
              on        turns on  the TLS session reuse cache.
              <ft>      sets the cache flush frequency. the default is set
                        by the TLS libraries and is typically connection count.
+             notickets does not issue session tickets. By default, tickets
+                       are issued to clients that did not present a
+                       certificate so they can resume without server state.
 
   Output: 0 upon success or !0 upon failure.
 */
@@ -1944,16 +1966,25 @@ int XrdXrootdProtocol::xtlsr(XrdOucStream &Config)
        return 0;
       }
 
-// If it's on we may need more to do
+// If it's not on then we have a bad keyword
 //
-   if (!strcmp(val, "on"))
-      {if (!tlsCtx) {eDest.Emsg("Config warning:", "Ignoring "
-                                "'tlsreuse on'; TLS not configured!");
-                     return 0;
-                    }
-       tlsCache = XrdTlsContext::scSrvr;
-       if (!(val = Config.GetWord())) return 0;
-       if (!strcmp(val, "flush" ))
+   if (strcmp(val, "on"))
+      {eDest.Emsg("config", "Invalid tlsreuse option -", val);
+       return 1;
+      }
+
+// It's on, make sure we actually have TLS
+//
+   if (!tlsCtx) {eDest.Emsg("Config warning:", "Ignoring "
+                            "'tlsreuse on'; TLS not configured!");
+                 return 0;
+                }
+   tlsCache = XrdTlsContext::scSrvr;
+
+// Process the options
+//
+   while((val = Config.GetWord()))
+        {if (!strcmp(val, "flush" ))
             {if (!(val = Config.GetWord()))
                 {eDest.Emsg("Config", "tlsreuse flush value not specified");
                  return 1;
@@ -1962,14 +1993,14 @@ int XrdXrootdProtocol::xtlsr(XrdOucStream &Config)
              if (num < 60) num = 60;
                 else if (num > XrdTlsContext::scFMax)
                          num = XrdTlsContext::scFMax;
-             tlsCache |= num;
+             tlsCache = (tlsCache & ~XrdTlsContext::scFMax) | num;
             }
-      }
-
-// We have a bad keyword
-//
-   eDest.Emsg("config", "Invalid tlsreuse option -", val);
-   return 1;
+         else if (!strcmp(val, "notickets")) tlsCache |= XrdTlsContext::scNoTk;
+         else {eDest.Emsg("config", "Invalid tlsreuse option -", val);
+               return 1;
+              }
+        }
+   return 0;
 }
   
 /******************************************************************************/
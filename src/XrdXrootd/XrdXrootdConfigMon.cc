@@ -417,6 +417,16 @@ char *XrdXrootdProtocol::xmondest(const char *what, char *val)
    const char *eText;
    char netBuff[288];
 
+// A local Unix datagram socket is specified by its absolute path
+//
+   if (*val == '/')
+      {if (strlen(val) >= 108)
+          {eDest.Emsg("Config", what, "socket path is too long -", val);
+           return 0;
+          }
+       return strdup(val);
+      }
+
 // Parse the host:port spec
 //
    if ((eText = netdest.Set(val)))
@@ -446,7 +456,8 @@ char *XrdXrootdProtocol::xmondest(const char *what, char *val)
 
    <strm>:  {all | ccm | pfc | tcpmon | tpc}  [<strm>]
 
-   <opts>:  [flust <t>] [maxlen <l>] [send <fmt> [noident] <host:port>]
+   <opts>:  [aggregate] [flust <t>] [maxlen <l>]
+            [send <fmt> [noident] {<host:port> | <path>}]
 
    <fmt>    {cgi | json} <hdr> | nohdr
 
@@ -458,6 +469,9 @@ char *XrdXrootdProtocol::xmondest(const char *what, char *val)
          tcpmon             gstream: tcp connection monitoring
          tpc                gstream: Third Party Copy
 
+         aggregate          merge events by key over the flush interval for
+                            plugins that support it.
+         <path>             absolute path of a local Unix datagram socket.
          noXXX              do not include information.
 
    Output: 0 upon success or !0 upon failure. Ignored by master.
@@ -481,6 +495,7 @@ int XrdXrootdProtocol::xmongs(XrdOucStream &Config)
               | XROOTD_MON_TPC;
    int i, selMon = 0, opt = -1, hdr = -1, fmt = -1, flushVal = -1;
    long long maxlVal = -1;
+   bool aggr = false;
    char *val, *dest = 0;
 
 // Make sure we have something here
@@ -518,7 +533,9 @@ do {if (!strcmp("all", val)) selMon = selAll;
 
 // Process all the parameters now
 //
-do{for (i = 0; i < numopts; i++)
+do{if (!strcmp(val, "aggregate")) {aggr = true; continue;}
+
+   for (i = 0; i < numopts; i++)
        {if (!strcmp(val, gsopts[i].opname))
            {if (!(val =  Config.GetWord()))
                {eDest.Emsg("Config", "gstream", gsopts[i].opname,
@@ -566,7 +583,9 @@ do{for (i = 0; i < numopts; i++)
                }
             if (flushVal >= 0)  gsObj[i].flsT = flushVal;
             if (maxlVal >= 0)   gsObj[i].maxL = maxlVal;
-            if (opt >= 0)       gsObj[i].Opt  = opt;
+            if (opt >= 0)       gsObj[i].Opt  = opt
+                                 | (gsObj[i].Opt & XrdXrootdGSReal::optAggr);
+            if (aggr)           gsObj[i].Opt |= XrdXrootdGSReal::optAggr;
             if (fmt >= 0)       gsObj[i].Fmt  = fmt;
             if (hdr >= 0)       gsObj[i].Hdr  = hdr;
            }
@@ -68,7 +68,7 @@ XrdXrootdGSReal::XrdXrootdGSReal(const XrdXrootdGSReal::GSParms &gsParms,
                                     || gsParms.Hdr == XrdXrootdGSReal::hdrNone
                                      ? 0 : gsParms.dest, gsParms.Fmt),
                                   pSeq(0), pSeqID(0), pSeqDID(0), binHdr(0),
-                                  isCGI(false)
+                                  isCGI(false), aggBeg(0)
 {
    static const int minSZ = 1024;
    static const int dflSZ = 1024*32;
@@ -131,6 +131,7 @@ XrdXrootdGSReal::XrdXrootdGSReal(const XrdXrootdGSReal::GSParms &gsParms,
 //
    monType = gsParms.Mode;
    rsvbytes = 0;
+   aggOn = (gsParms.Opt & optAggr) != 0;
 
 // If we have a specific end-point, then create a network relay to it
 //
@@ -154,6 +155,78 @@ XrdXrootdGSReal::XrdXrootdGSReal(const XrdXrootdGSReal::GSParms &gsParms,
    gMon.Register(idBuff, monHost, "xroot");
 }
 
+/******************************************************************************/
+/* Private:                      A g g E m i t                                */
+/******************************************************************************/
+
+void XrdXrootdGSReal::AggEmit() // gMutex is held
+{
+   char buff[2048];
+   int n, k, last, tNow = time(0);
+
+// Insert a record for each key. The histogram counts values below 1 in the
+// first bin and values in [2**(k-1), 2**k) in bin k; trailing zeros are
+// omitted. Keys are limited to 255 characters so the record always fits.
+//
+   for (auto it = aggMap.begin(); it != aggMap.end(); ++it)
+       {AggEnt &aE = it->second;
+        n = snprintf(buff, sizeof(buff), "{\"event\":\"aggregate\","
+                     "\"key\":\"%s\",\"tbeg\":%d,\"tend\":%d,\"count\":%lld,"
+                     "\"sum\":%lld,\"min\":%lld,\"max\":%lld,\"hist\":[",
+                     it->first.c_str(), aggBeg, tNow, aE.count, aE.sum,
+                     aE.min, aE.max);
+        for (last = aggBins-1; last > 0 && !aE.hist[last]; last--) {}
+        for (k = 0; k <= last; k++)
+            n += snprintf(buff+n, sizeof(buff)-n, (k ? ",%lld" : "%lld"),
+                          aE.hist[k]);
+        n += snprintf(buff+n, sizeof(buff)-n, "]}");
+        Insert(buff, n+1);
+       }
+
+// Start a new aggregation interval
+//
+   aggMap.clear();
+   aggBeg = 0;
+}
+
+/******************************************************************************/
+/*                             A g g r e g a t e                              */
+/******************************************************************************/
+
+bool XrdXrootdGSReal::Aggregate(const char *key, long long value)
+{
+   const char *kP = key;
+   int bin;
+
+// Validate the key as it is placed in a JSON string as is
+//
+   if (!aggOn || !key || !*key) return false;
+   while(*kP && *kP != '"' && *kP != '\\' && (unsigned char)*kP >= ' ')
+        {if (kP - key >= 255) return false;
+         kP++;
+        }
+   if (*kP) return false;
+
+// Find the histogram bin for this value
+//
+   bin = (value < 1 ? 0 : 64 - __builtin_clzll((unsigned long long)value));
+
+// Merge in the event. If there are too many keys, emit what we have first.
+//
+   XrdSysMutexHelper gHelp(gMutex);
+   if ((int)aggMap.size() >= aggKeys && !aggMap.count(key)) AggEmit();
+   auto rc = aggMap.emplace(key, AggEnt());
+   AggEnt &aE = rc.first->second;
+   if (rc.second) aE.min = aE.max = value;
+   aE.count++;
+   aE.sum += value;
+   if (value < aE.min) aE.min = value;
+   if (value > aE.max) aE.max = value;
+   aE.hist[bin]++;
+   if (!aggBeg) aggBeg = time(0);
+   return true;
+}
+
 /******************************************************************************/
 /*                             A u t o F l u s h                              */
 /******************************************************************************/
@@ -178,7 +251,8 @@ void XrdXrootdGSReal::DoIt()
 //
    afRunning = false;
    if (afTime)
-      {if (tBeg && time(0)-tBeg >= afTime) Expel(0);
+      {if (aggBeg && time(0)-aggBeg >= afTime) {AggEmit(); Expel(0);}
+          else if (tBeg && time(0)-tBeg >= afTime) Expel(0);
        AutoFlush();
       }
 }
@@ -241,6 +315,7 @@ void XrdXrootdGSReal::Expel(int dlen) // gMutex is held
 void XrdXrootdGSReal::Flush()
 {
    XrdSysMutexHelper gHelp(gMutex);
+   if (aggBeg) AggEmit();
    Expel(0);
 }
   
@@ -30,6 +30,9 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <map>
+#include <string>
+
 #include "Xrd/XrdJob.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdXrootd/XrdXrootdGStream.hh"
@@ -50,6 +53,8 @@ class XrdXrootdGSReal : public XrdJob, public XrdXrootdGStream,
 {
 public:
 
+bool      Aggregate(const char *key, long long value);
+
 void      DoIt(); // XrdJob override
 
 void      Flush();
@@ -91,6 +96,7 @@ int       Space();
    static const int hdrFull = 5;       //!< Include site, host, port, inst, pgm
 
    static const int optNoID = 0x01;    //!< Don't send ident records
+   static const int optAggr = 0x02;    //!< Allow events to be aggregated
 
    struct GSParms {const char *pin;    //!< the plugin name.
                    const char *dest;   //!< Destination for records
@@ -114,6 +120,7 @@ int       Space();
 private:
 
 
+void AggEmit();
 void AutoFlush();
 void Expel(int dlen);
 int  hdrBIN(const GSParms &gs);
@@ -126,6 +133,17 @@ struct HdrInfo
        char *tend;
       }      hInfo;
 
+static const int aggBins = 64;     // Histogram bins (one per power of two)
+static const int aggKeys = 1024;   // Keys held before aggregates are emitted
+
+struct AggEnt
+      {long long count;
+       long long sum;
+       long long min;
+       long long max;
+       long long hist[aggBins];
+      };
+
 char                  *dictHdr;
 char                  *idntHdr0;
 char                  *idntHdr1;
@@ -147,6 +165,9 @@ int                    monType;
 int                    afTime;
 bool                   afRunning;
 bool                   isCGI;
+bool                   aggOn;
+int                    aggBeg;
+std::map<std::string, AggEnt> aggMap;
 
 XrdXrootdMonitor::User gMon;
 };
@@ -31,6 +31,13 @@
 #include "XrdXrootd/XrdXrootdGStream.hh"
 #include "XrdXrootd/XrdXrootdGSReal.hh"
 
+/******************************************************************************/
+/*                             A g g r e g a t e                              */
+/******************************************************************************/
+
+bool      XrdXrootdGStream::Aggregate(const char *key, long long value)
+                           {return gStream.Aggregate(key, value);}
+
 /******************************************************************************/
 /*                                 F l u s h                                  */
 /******************************************************************************/
@@ -44,6 +44,26 @@ class XrdXrootdGStream
 {
 public:
 
+//-----------------------------------------------------------------------------
+//! Add an event to an aggregate kept by the G-Stream instead of inserting a
+//! record for each event. Events with the same key are merged until the
+//! stream is flushed, at which time a single JSON record is inserted for
+//! each key with the number of events, the sum, minimum, and maximum of their
+//! values, and a histogram of values by powers of two. Aggregation must have
+//! been enabled for the stream via the mongstream aggregate option.
+//!
+//! @param  key    -> the null terminated key of the event. The key must be
+//!                   less than 256 characters and not contain quotes,
+//!                   backslashes, or control characters.
+//! @param  value     the value to be merged (e.g. bytes transferred).
+//!
+//! @return true      event merged.
+//! @return false     aggregation is not enabled or the key is invalid; the
+//!                   caller should insert a record for the event instead.
+//-----------------------------------------------------------------------------
+
+bool      Aggregate(const char *key, long long value);
+
 //-----------------------------------------------------------------------------
 //! Flush any pending monitoring messages to the data collector. Also, see
 //! the related SetAutoFlush() method.
@@ -410,7 +410,7 @@ void XrdXrootdJob2Do::sendResult(char *lp, int caned, int jrc)
 //
    if (!caned && lp)
       {jobStat = kXR_ok; trc = "ok";
-       if (theArgs[0])
+       if (theArgs[0] && *theArgs[0])
           {        jobVec[n].iov_base = theArgs[0];                 // 1
            dlen  = jobVec[n].iov_len  = strlen(theArgs[0]); n++;
                    jobVec[n].iov_base = (char *)" ";                // 2
@@ -685,7 +685,7 @@ int XrdXrootdJob::sendResult(XrdXrootdResponse *resp,
 // Send an error result if no result is present
 //
    if (!(job->theResult)) rc = resp->Send(kXR_ServerError,"Program failed");
-      else {if (!rpfx) {dlen = 0; i = 1;}
+      else {if (!rpfx || !*rpfx) {dlen = 0; i = 1;}
                else {        jobResp[1].iov_base = (char *)rpfx;
                      dlen  = jobResp[1].iov_len  = strlen(rpfx);
                              jobResp[2].iov_base = (char *)" "; 
@@ -0,0 +1,186 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d M e t a J o b . c c                    */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/stat.h>
+
+#include "Xrd/XrdLink.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdOuc/XrdOucLatency.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdXrootd/XrdXrootdCallBack.hh"
+#include "XrdXrootd/XrdXrootdMetaJob.hh"
+#include "XrdXrootd/XrdXrootdProtocol.hh"
+#include "XrdXrootd/XrdXrootdStats.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+
+/******************************************************************************/
+/*                        G l o b a l   S t a t i c s                         */
+/******************************************************************************/
+
+extern XrdSysTrace  XrdXrootdTrace;
+
+namespace XrdXrootd
+{
+extern XrdScheduler *Sched;
+}
+using namespace XrdXrootd;
+
+namespace
+{
+const char *TraceID = "MetaJob";
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdXrootdMetaJob::XrdXrootdMetaJob(XrdXrootdProtocol *protP,
+                                   XrdXrootdCallBack *cbP,
+                                   const char *path, const char *opaque,
+                                   int cmd)
+                 : XrdJob("meta request"), Protocol(protP), cbFunc(cbP),
+                   Link(protP->Link), latP(protP->latReq),
+                   latBeg(protP->latBeg), Path(path), fsctlCmd(cmd),
+                   hasOpaque(opaque != 0)
+{
+// The request is timed until we complete it rather than the protocol
+//
+   protP->latReq = 0;
+   if (opaque) Opaque = opaque;
+   eInfo = new XrdOucErrInfo(Link->ID, cbP, protP->ReqID.getID(),
+                             protP->Monitor.Did, protP->clientPV);
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdXrootdMetaJob::~XrdXrootdMetaJob()
+{
+   if (latP) latP->Service(XrdOucLatency::Now() - latBeg);
+   delete eInfo;
+   Protocol->linkMetaReq--;
+   Link->setRef(-1);
+}
+
+/******************************************************************************/
+/*                                  D o I t                                   */
+/******************************************************************************/
+  
+void XrdXrootdMetaJob::DoIt()
+{
+   struct stat buf;
+   const char *opaque = (hasOpaque ? Opaque.c_str() : 0);
+   char xxBuff[1024];
+   int  rc, ecode;
+
+// Perform the actual function
+//
+   if (fsctlCmd)
+      {rc = Protocol->osFS->fsctl(fsctlCmd, Path.c_str(), *eInfo,
+                                  Protocol->Client);
+       TRACE(FS, Link->ID <<" async rc=" <<rc <<" locate " <<Path);
+      } else {
+       rc = Protocol->osFS->stat(Path.c_str(), &buf, *eInfo,
+                                  Protocol->Client, opaque);
+       TRACE(FS, Link->ID <<" async rc=" <<rc <<" stat " <<Path);
+      }
+
+// The client was already told to wait for the response. Should the file system
+// also defer the response, all we need to do is to tell it that the wait was
+// sent. Otherwise, send the final response.
+//
+   if (rc == SFS_OK)
+      {if (fsctlCmd) cbFunc->sendResp(eInfo, kXR_ok);
+          else {int n = Protocol->StatGen(buf, xxBuff, sizeof(xxBuff));
+                cbFunc->sendResp(eInfo, kXR_ok, 0, xxBuff, n);
+               }
+      }
+   else if (rc == SFS_STARTED)
+           {eInfo->getErrText(ecode);
+            if (ecode <= 0) ecode = 1800;
+            if (eInfo->getErrCB()) eInfo->getErrCB()->Done(ecode, eInfo);
+           }
+   else cbFunc->sendError(rc, eInfo, Path.c_str());
+
+// All done
+//
+   delete this;
+}
+
+/******************************************************************************/
+/*                                L o c a t e                                 */
+/******************************************************************************/
+
+int XrdXrootdMetaJob::Locate(XrdXrootdProtocol *protP, XrdXrootdCallBack *cbP,
+                             const char *path, int fsctlCmd)
+{
+   return Start(new XrdXrootdMetaJob(protP, cbP, path, 0, fsctlCmd));
+}
+
+/******************************************************************************/
+/*                                  S t a t                                   */
+/******************************************************************************/
+
+int XrdXrootdMetaJob::Stat(XrdXrootdProtocol *protP, XrdXrootdCallBack *cbP,
+                           const char *path, const char *opaque)
+{
+   return Start(new XrdXrootdMetaJob(protP, cbP, path, opaque, 0));
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdXrootdMetaJob::Start(XrdXrootdMetaJob *jobP)
+{
+   XrdXrootdProtocol *protP = jobP->Protocol;
+   int rc;
+
+// Pin the link so that the protocol object stays with us until we are done
+//
+   jobP->Link->setRef(1);
+   protP->linkMetaReq++;
+   protP->SI->Bump(protP->SI->metaCnt);
+
+// Tell the client to wait for the response. We must do this before the job
+// is scheduled as the response may otherwise arrive ahead of the wait.
+//
+   if ((rc = protP->Response.Send(kXR_waitresp, 1800, "")))
+      {delete jobP;
+       return rc;
+      }
+
+// Run the request asynchronously
+//
+   Sched->Schedule((XrdJob *)jobP);
+   return 1;
+}
@@ -0,0 +1,85 @@
+#ifndef __XRDXROOTDMETAJOB_H__
+#define __XRDXROOTDMETAJOB_H__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d M e t a J o b . h h                    */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors; see the git history for authorship.   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string>
+
+#include "Xrd/XrdJob.hh"
+
+class XrdLink;
+class XrdOucErrInfo;
+class XrdOucLatency;
+class XrdXrootdCallBack;
+class XrdXrootdProtocol;
+
+/******************************************************************************/
+/*                    C l a s s   X r d X r o o t d M e t a J o b             */
+/******************************************************************************/
+
+// This class runs a stat or locate request on a scheduler thread after the
+// client has been told to wait for the response. This frees the link so that
+// other requests may be processed while a slow file system works on this one.
+// The link is pinned until the job completes, so the protocol object remains
+// valid. The response is sent using the callback object for the request.
+// Note that the file system call still blocks the scheduler thread, so this
+// does not reduce the number of threads in use; it only keeps one slow request
+// from holding up the ones that follow it on the same link. Opens are not
+// handled this way as the file handle must be assigned in request order.
+  
+class XrdXrootdMetaJob : public XrdJob
+{
+public:
+
+static int  Locate(XrdXrootdProtocol *protP, XrdXrootdCallBack *cbP,
+                   const char *path, int fsctlCmd);
+
+static int  Stat(XrdXrootdProtocol *protP, XrdXrootdCallBack *cbP,
+                 const char *path, const char *opaque);
+
+       void DoIt() override;
+
+private:
+
+            XrdXrootdMetaJob(XrdXrootdProtocol *protP, XrdXrootdCallBack *cbP,
+                             const char *path, const char *opaque, int cmd);
+           ~XrdXrootdMetaJob();
+
+static int  Start(XrdXrootdMetaJob *jobP);
+
+XrdXrootdProtocol *Protocol;
+XrdXrootdCallBack *cbFunc;
+XrdLink           *Link;
+XrdOucErrInfo     *eInfo;
+XrdOucLatency     *latP;       // Histograms of the request or nil
+long long          latBeg;     // Time the request started
+std::string        Path;
+std::string        Opaque;
+int                fsctlCmd;   // Zero for stat, otherwise the locate command
+bool               hasOpaque;
+};
+#endif
@@ -28,12 +28,15 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cerrno>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include "XrdVersion.hh"
 
@@ -119,6 +122,29 @@ char           *SidCGI[4] = {0};
 int             LidCGI[4] = {0};
 char           *SidJSON[4]= {0}; // 0:sidsite 1:sidhostid 2:sidinst 3:sidfull
 int             LidJSON[4]= {0};
+
+// Records are handed off to a sender thread so that threads producing them
+// never wait on the network. Producers push a copy of the record on a
+// lock-free stack that the sender takes as a whole and sends in order.
+//
+struct SendItem
+      {SendItem *Next;
+       int       mMode;
+       int       bLen;
+       bool      setSeq;
+       char      bData[8];
+      };
+
+std::atomic<SendItem *> sndHead(0);
+std::atomic<int>        sndQLen(0);
+std::atomic<int>        sndDrop(0);
+XrdSysSemaphore         sndSem(0);
+bool                    sndActive = false;
+int                     sndSeq1   = 0;
+int                     sndSeq2   = 0;
+
+static const int        sndQMax   = 1024;
+static const int        sndBatch  = 64;
 }
 
 using namespace XrdXrootdMonInfo;
@@ -730,6 +756,16 @@ int XrdXrootdMonitor::Init()
           }
       }
 
+// Start the sender thread. Should that fail, records are sent inline.
+//
+   if (InetDest1 || InetDest2)
+      {pthread_t tid;
+       if (XrdSysThread::Run(&tid, XrdXrootdMonitor::Sender, 0, 0,
+                             "Monitor sender"))
+          eDest->Emsg("Monitor", errno, "start monitor sender");
+          else sndActive = true;
+      }
+
 // Now schedule the first identification record
 //
    if (Sched && monIdent >= 0) Sched->Schedule((XrdJob *)&MonIdent);
@@ -1170,12 +1206,124 @@ void XrdXrootdMonitor::Mark()
 /******************************************************************************/
   
 int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
+{
+   SendItem *sP, *oldHead;
+
+// If there is no sender thread, send the record right away
+//
+   if (!sndActive) return SendNow(monMode, buff, blen, setseq);
+
+// Should the sender fall too far behind, drop the record as UDP would
+//
+   if (sndQLen.fetch_add(1, std::memory_order_relaxed) >= sndQMax)
+      {sndQLen.fetch_sub(1, std::memory_order_relaxed);
+       sndDrop.fetch_add(1, std::memory_order_relaxed);
+       return 1;
+      }
+
+// Copy the record as the caller will reuse the buffer
+//
+   if (!(sP = (SendItem *)malloc(offsetof(SendItem, bData) + blen)))
+      {sndQLen.fetch_sub(1, std::memory_order_relaxed);
+       return -1;
+      }
+   sP->mMode = monMode; sP->bLen = blen; sP->setSeq = setseq;
+   memcpy(sP->bData, buff, blen);
+
+// Push it and wake up the sender if it may be waiting
+//
+   oldHead = sndHead.load(std::memory_order_relaxed);
+   do {sP->Next = oldHead;}
+      while(!sndHead.compare_exchange_weak(oldHead, sP,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+   if (!oldHead) sndSem.Post();
+   return 0;
+}
+
+/******************************************************************************/
+/*                                S e n d e r                                 */
+/******************************************************************************/
+  
+void *XrdXrootdMonitor::Sender(void *)
+{
+#ifndef NODEBUG
+   const char *TraceID = "Monitor";
+#endif
+   SendItem *sP, *nP, *fifoP, *bP[sndBatch];
+   struct iovec ioV[sndBatch];
+   XrdXrootdMonHeader *mHdr;
+   int i, k, n, rc, nDrop;
+
+// Wait for records and send all of them in the order they were added
+//
+do{sndSem.Wait();
+   sP = sndHead.exchange(0, std::memory_order_acquire);
+   fifoP = 0;
+   while(sP) {nP = sP->Next; sP->Next = fifoP; fifoP = sP; sP = nP;}
+
+   while(fifoP)
+        {for (n = 0; fifoP && n < sndBatch; n++)
+             {bP[n] = fifoP; fifoP = fifoP->Next;}
+
+         if (InetDest1)
+            {for (i = k = 0; i < n; i++)
+                 {if (!(bP[i]->mMode & monMode1)) continue;
+                  if (bP[i]->setSeq)
+                     {mHdr = (XrdXrootdMonHeader *)bP[i]->bData;
+                      mHdr->pseq = (sndSeq1++) & 0xff;
+                     }
+                  ioV[k].iov_base = bP[i]->bData;
+                  ioV[k++].iov_len = bP[i]->bLen;
+                 }
+             if (k)
+                {rc = InetDest1->SendMany(ioV, k);
+                 TRACE(DEBUG,k <<" records sent to " <<Dest1 <<" rc=" <<rc);
+                }
+            }
+
+         if (InetDest2)
+            {for (i = k = 0; i < n; i++)
+                 {if (!(bP[i]->mMode & monMode2)) continue;
+                  if (bP[i]->setSeq)
+                     {mHdr = (XrdXrootdMonHeader *)bP[i]->bData;
+                      mHdr->pseq = (sndSeq2++) & 0xff;
+                     }
+                  ioV[k].iov_base = bP[i]->bData;
+                  ioV[k++].iov_len = bP[i]->bLen;
+                 }
+             if (k)
+                {rc = InetDest2->SendMany(ioV, k);
+                 TRACE(DEBUG,k <<" records sent to " <<Dest2 <<" rc=" <<rc);
+                }
+            }
+
+         for (i = 0; i < n; i++) free(bP[i]);
+         sndQLen.fetch_sub(n, std::memory_order_relaxed);
+        }
+
+   if ((nDrop = sndDrop.exchange(0, std::memory_order_relaxed)))
+      {char buff[32];
+       snprintf(buff, sizeof(buff), "%d", nDrop);
+       eDest->Emsg("Monitor", buff, "records dropped; send queue full.");
+      }
+  } while(1);
+
+// Keep the compiler happy
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                               S e n d N o w                                */
+/******************************************************************************/
+  
+int XrdXrootdMonitor::SendNow(int monMode, void *buff, int blen, bool setseq)
 {
 #ifndef NODEBUG
     const char *TraceID = "Monitor";
 #endif
     static XrdSysMutex sendMutex;
-    static int seq1=0, seq2=0;
     XrdXrootdMonHeader *mHdr=0;
     int rc1, rc2;
 
@@ -1186,13 +1334,13 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
 
     sendMutex.Lock();
     if (monMode & monMode1 && InetDest1)
-       {if (mHdr) mHdr->pseq = (seq1++) & 0xff;
+       {if (mHdr) mHdr->pseq = (sndSeq1++) & 0xff;
         rc1  = InetDest1->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest1 <<" rc=" <<rc1);
        }
        else rc1 = 0;
     if (monMode & monMode2 && InetDest2)
-       {if (mHdr) mHdr->pseq = (seq2++) & 0xff;
+       {if (mHdr) mHdr->pseq = (sndSeq2++) & 0xff;
         rc2  = InetDest2->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest2 <<" rc=" <<rc2);
        }
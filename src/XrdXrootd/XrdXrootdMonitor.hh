@@ -264,6 +264,8 @@ static void              Flush(MonRdrBuff *mP);
 static kXR_unt32         Map(char  code, XrdXrootdMonitor::User &uInfo,
                              const char *path);
        void              Mark();
+static void             *Sender(void *);
+static int               SendNow(int mmode, void *buff, int size, bool setseq);
 static void              startClock();
 static void              unAlloc(XrdXrootdMonitor *monp);
 
@@ -421,6 +421,7 @@ void XrdXrootdNormAio::Recycle(bool release)
            dataLink->setRef(-1);
           }
        aioState |= aioHeld;
+       latDone();
       }
 
 // Do some tracing and reset reorder counter
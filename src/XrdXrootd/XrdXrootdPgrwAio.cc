@@ -398,6 +398,7 @@ void XrdXrootdPgrwAio::Recycle(bool release)
             dataFile->Ref(-1);
            }
         aioState |= aioHeld;
+        latDone();
        }
 
 // Do some traceing
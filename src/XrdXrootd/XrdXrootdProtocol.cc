@@ -37,6 +37,7 @@
 #include "Xrd/XrdLink.hh"
 #include "XrdNet/XrdNetIF.hh"
 #include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucLatency.hh"
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdOuc/XrdOucStream.hh"
 #include "XrdOuc/XrdOucString.hh"
@@ -125,6 +126,8 @@ int                   XrdXrootdProtocol::as_minsfsz   = 1;
 int                   XrdXrootdProtocol::as_minsfsz   = 8192;
 #endif
 int                   XrdXrootdProtocol::as_maxstalls = 4;
+int                   XrdXrootdProtocol::as_metaops   = 0;
+int                   XrdXrootdProtocol::as_rdpipe    = 1;
 short                 XrdXrootdProtocol::as_okstutter = 1; // For 64K unit
 short                 XrdXrootdProtocol::as_timeout   = 45;
 bool                  XrdXrootdProtocol::as_force     = false;
@@ -371,7 +374,7 @@ int XrdXrootdProtocol::Process(XrdLink *lp) // We ignore the argument here
    if (Resume)
       {if (myBlen && (rc = getData("data", myBuff, myBlen)) != 0) return rc;
           else if ((rc = (*this.*Resume)()) != 0) return rc;
-                  else {Resume = 0; return 0;}
+                  else {Resume = 0; latDone(); return 0;}
       }
 
 // Read the next request header
@@ -381,6 +384,8 @@ int XrdXrootdProtocol::Process(XrdLink *lp) // We ignore the argument here
 // Check if we need to copy the request prior to unmarshalling it
 //
    reqID = ntohs(Request.header.requestid);
+   latReq = SI->Latency(reqID);
+   latBeg = XrdOucLatency::Start(latReq, Link->getReadyTime(), latRdy);
    if (reqID != kXR_sigver && NEED2SECURE(Protect)(Request))
       {memcpy(&sigReq2Ver, &Request, sizeof(ClientRequest));
        sigNeed = true;
@@ -423,9 +428,12 @@ int XrdXrootdProtocol::Process(XrdLink *lp) // We ignore the argument here
           {Resume = &XrdXrootdProtocol::Process2; return rc;}
       }
 
-// Continue with request processing at the resume point
+// Continue with request processing at the resume point. The time taken is
+// recorded once the request completes, which may be after more data arrives.
 //
-   return Process2();
+   rc = Process2();
+   if (!Resume) latDone();
+   return rc;
 }
 
 /******************************************************************************/
@@ -1446,6 +1454,21 @@ int XrdXrootdProtocol::getDumpCont()
    return 1;
 }
   
+/******************************************************************************/
+/*                               l a t D o n e                                */
+/******************************************************************************/
+
+void XrdXrootdProtocol::latDone()
+{
+// Record the service time of the current request unless it is not timed or
+// the request was handed off to be completed elsewhere.
+//
+   if (latReq)
+      {latReq->Service(XrdOucLatency::Now() - latBeg);
+       latReq = 0;
+      }
+}
+  
 /******************************************************************************/
 /*                                 R e s e t                                  */
 /******************************************************************************/
@@ -1481,6 +1504,8 @@ void XrdXrootdProtocol::Reset()
    cumSegsW           = 0;
    cumWrites          = 0;
    totReadP           = 0;
+   latRdy             = 0;
+   latReq             = 0;
    hcPrev             =13;
    hcNext             =21;
    hcNow              =13;
@@ -1502,6 +1527,7 @@ void XrdXrootdProtocol::Reset()
    ableTLS            = false;  // resolved during the kXR_protocol interchange.
    isTLS              = false;  // Made true when link converted to TLS
    linkAioReq         = 0;
+   linkMetaReq        = 0;
    pioFree = pioFirst = pioLast = 0;
    isActive = isLinkWT= isNOP = isDead = false;
    sigNeed = sigHere = sigRead = false;
@@ -69,6 +69,7 @@
 class XrdNetSocket;
 class XrdOucEnv;
 class XrdOucErrInfo;
+class XrdOucLatency;
 class XrdOucReqID;
 class XrdOucStream;
 class XrdOucTList;
@@ -155,6 +156,7 @@ class XrdXrootdProtocol : public XrdProtocol, public XrdXrootd::gdCallBack,
                           public XrdSfsDio,   public XrdSfsXio
 {
 friend class XrdXrootdAdmin;
+friend class XrdXrootdMetaJob;
 public:
 
        void          aioUpdate(int val) {srvrAioOps += val;}
@@ -223,6 +225,8 @@ static int           as_minsfsz;   // Min sendf request size
 static int           as_seghalf;
 static int           as_segsize;   // Aio quantum (optimal)
 static int           as_maxstalls; // Maximum stalls we will tolerate
+static int           as_metaops;   // Max async stat/locate requests per link
+static int           as_rdpipe;    // Max concurrent aio reads per file stream
 static short         as_okstutter; // Allowable stutters per transfer unit
 static short         as_timeout;   // request timeout (usually < stream timeout)
 static bool          as_force;     // aio to be forced
@@ -289,6 +293,7 @@ enum RD_func {RD_chmod = 0, RD_chksum,  RD_dirlist, RD_locate, RD_mkdir,
        int   do_Set_Mon(XrdOucTokenizer &setargs);
        int   do_Stat();
        int   do_Statx();
+       int   do_StatxFull();
        int   do_Sync();
        int   do_Truncate();
        int   do_Write();
@@ -315,13 +320,17 @@ static int   ConfigSecurity(XrdOucEnv &xEnv, const char *cfn);
        int   fsOvrld(char opc, const char *Path, char *Cgi);
        int   fsRedirNoEnt(const char *eMsg, char *Cgi, int popt);
        int   getBuff(const int isRead, int Quantum);
-       char *getCksType(char *opaque, char *cspec=0, int cslen=0);
+       char *getCksList(char *cksT, char *cspec, int cslen);
+       char *getCksType(char *opaque, char *cspec=0, int cslen=0,
+                        bool multi=false);
        int   getData(const char *dtype, char *buff, int blen);
        int   getDataCont();
        int   getDataIovCont();
        int   getDumpCont();
+       void  latDone();
        bool  logLogin(bool xauth=false);
 static int   mapMode(int mode);
+       bool  MetaAsync();
        void  Reset();
 static int   rpCheck(char *fn, char **opaque);
        int   rpEmsg(const char *op, char *fn);
@@ -493,6 +502,9 @@ int                        cumSegsW;     // Count less numSegsW
 int                        cumWrites;    // Count less numWrites
 int                        myStalls;     // Number of stalls
 long long                  totReadP;     // Bytes
+long long                  latRdy;       // Link dispatch time last timed
+long long                  latBeg;       // Time the current request started
+XrdOucLatency             *latReq;       // Histograms of the current request
 
 // Data local to each protocol/link combination
 //
@@ -530,6 +542,7 @@ bool                       sigWarn;      // Once for unneeded signature
 // Async I/O area, these need to be atomic
 //
 RAtomic_int                linkAioReq;   // Aio requests   inflight for link
+RAtomic_int                linkMetaReq;  // Meta requests  inflight for link
 static RAtomic_int         srvrAioOps;   // Aio operations inflight for server
 
 // Buffer information, used to drive getData(), and (*Resume)()
@@ -28,8 +28,10 @@
 /******************************************************************************/
  
 #include <cstdio>
+#include <cstring>
   
 #include "Xrd/XrdStats.hh"
+#include "XrdOuc/XrdOucLatency.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
@@ -64,6 +66,7 @@ AsyncNum = 0;     // Stats: Number of async ops
 AsyncMax = 0;     // Stats: Number of async max
 AsyncRej = 0;     // Stats: Number of async rejected
 AsyncNow = 0;     // Stats: Number of async now (not locked)
+metaCnt  = 0;     // Stats: Number of async stat and locate
 Refresh  = 0;     // Stats: Number of refresh requests
 LoginAT  = 0;     // Stats: Number of   attempted     logins
 LoginAU  = 0;     // Stats: Number of   authenticated logins
@@ -72,6 +75,18 @@ AuthBad  = 0;     // Stats: Number of authentication failures
 aokSCnt  = 0;     // Stats: Number of signature successes
 badSCnt  = 0;     // Stats: Number of signature failures
 ignSCnt  = 0;     // Stats: Number of signature ignored
+
+// Allocate latency histograms for the requests that are most often slow
+//
+static const struct {int reqID; const char *reqName;} latReq[] =
+      {{kXR_open, "open"},     {kXR_read, "read"},   {kXR_readv, "readv"},
+       {kXR_pgread, "pgread"}, {kXR_write, "write"}, {kXR_pgwrite, "pgwrite"},
+       {kXR_stat, "stat"},     {kXR_dirlist, "dirlist"}};
+
+memset(latTab, 0, sizeof(latTab));
+for (unsigned int i = 0; i < sizeof(latReq)/sizeof(latReq[0]); i++)
+    latTab[latReq[i].reqID-kXR_1stRequest] =
+           new XrdOucLatency("xroot", latReq[i].reqName);
 }
 
 /******************************************************************************/
@@ -86,7 +101,7 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
    "<wv>%lld</wv><ws>%lld</ws><wr>%lld</wr>"
    "<sync>%d</sync><getf>%d</getf><putf>%d</putf><misc>%d</misc></ops>"
    "<sig><ok>%d</ok><bad>%d</bad><ign>%d</ign></sig>"
-   "<aio><num>%lld</num><max>%d</max><rej>%lld</rej></aio>"
+   "<aio><num>%lld</num><max>%d</max><rej>%lld</rej><meta>%lld</meta></aio>"
    "<err>%d</err><rdr>%lld</rdr><dly>%d</dly>"
    "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn></stats>";
 //                                   1 2 3 4 5 6 7 8
@@ -103,9 +118,10 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       LLMax, LLMax, LLMax, LLMax, LLMax, LLMax, INMax, INMax,
                       INMax, INMax,
                       INMax, INMax, INMax,
-                      LLMax, INMax, LLMax, INMax, LLMax, INMax,
+                      LLMax, INMax, LLMax, LLMax, INMax, LLMax, INMax,
                       INMax, INMax, INMax, INMax);
-       return len + (fsP ? fsP->getStats(0,0) : 0);
+       return len + (fsP ? fsP->getStats(0,0) : 0)
+                  + XrdOucLatency::Report("xroot", 0, 0);
       }
 
 // Format our statistics
@@ -117,13 +133,15 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   syncCnt, getfCnt,
                   putfCnt, miscCnt,
                   aokSCnt, badSCnt, ignSCnt,
-                  AsyncNum, AsyncMax, AsyncRej, errorCnt, redirCnt, stallCnt,
+                  AsyncNum, AsyncMax, AsyncRej, metaCnt,
+                  errorCnt, redirCnt, stallCnt,
                   LoginAT, AuthBad, LoginAU, LoginUA);
    statsMutex.UnLock();
 
 // Now include filesystem statistics and return
 //
    if (fsP) len += fsP->getStats(buff+len, blen-len);
+   if (len < blen) len += XrdOucLatency::Report("xroot", buff+len, blen-len);
    return len;
 }
  
@@ -29,9 +29,11 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include "XProtocol/XProtocol.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdOuc/XrdOucStats.hh"
 
+class XrdOucLatency;
 class XrdSfsFileSystem;
 class XrdStats;
 class XrdXrootdResponse;
@@ -59,6 +61,7 @@ long long        AsyncNum;     // Stats: Number of async ops
 long long        AsyncRej;     // Stats: Number of async rejected
 long long        AsyncNow;     // Stats: Number of async now (not locked)
 int              AsyncMax;     // Stats: Number of async max
+long long        metaCnt;      // Stats: Number of async stat and locate
 int              Refresh;      // Stats: Number of refresh requests
 int              LoginAT;      // Stats: Number of   attempted     logins
 int              LoginAU;      // Stats: Number of   authenticated logins
@@ -68,6 +71,13 @@ int              aokSCnt;      // Stats: Number of signature successes
 int              badSCnt;      // Stats: Number of signature failures
 int              ignSCnt;      // Stats: Number of signature ignored
 
+// Return the latency histograms for a request or nil if it is not timed
+//
+XrdOucLatency   *Latency(int reqID)
+                        {return (reqID >= kXR_1stRequest && reqID < kXR_REQFENCE
+                                 ? latTab[reqID-kXR_1stRequest] : 0);
+                        }
+
 void             setFS(XrdSfsFileSystem *fsp) {fsP = fsp;}
 
 int              Stats(char *buff, int blen, int do_sync=0);
@@ -80,5 +90,6 @@ private:
 
 XrdSfsFileSystem *fsP;
 XrdStats *xstats;
+XrdOucLatency    *latTab[kXR_REQFENCE-kXR_1stRequest];
 };
 #endif
@@ -126,6 +126,21 @@ void XrdXrootdTpcMon::Report(XrdXrootdTpcMon::TpcInfo &info)
    const char *srcURL, *dstURL;
    char bt_buff[40], et_buff[40], sBuff[1024], dBuff[1024], buff[8192];
 
+// If the stream aggregates events, merge the size and duration of this copy
+// into the totals for the protocol, direction, and outcome.
+//
+   long long msec = (info.endT.tv_sec  - info.begT.tv_sec)*1000
+                  + (info.endT.tv_usec - info.begT.tv_usec)/1000;
+   int k = snprintf(buff, sizeof(buff), "tpc.%s.%s.%s.", protocol,
+                    (info.opts & TpcInfo::isaPush ? "push" : "pull"),
+                    (info.endRC ? "fail" : "ok"));
+   strcpy(buff+k, "bytes");
+   if (gStream.Aggregate(buff, info.fSize))
+      {strcpy(buff+k, "msec");
+       gStream.Aggregate(buff, msec);
+       return;
+      }
+
 // Get correct source and destination URLs
 //
    srcURL = getURL(info.srcURL, protocol, sBuff, sizeof(sBuff));
@@ -57,6 +57,7 @@
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdFileLock.hh"
 #include "XrdXrootd/XrdXrootdJob.hh"
+#include "XrdXrootd/XrdXrootdMetaJob.hh"
 #include "XrdXrootd/XrdXrootdMonFile.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdNormAio.hh"
@@ -404,7 +405,8 @@ int XrdXrootdProtocol::do_Chmod()
 int XrdXrootdProtocol::do_CKsum(int canit)
 {
    char *opaque;
-   char *algT = JobCKT, *args[6];
+   char *algT = JobCKT, *args[6], cksT[256];
+   bool isList = false;
    int rc;
 
 // Check for static routing
@@ -428,16 +430,20 @@ int XrdXrootdProtocol::do_CKsum(int canit)
        return Response.Send();
       }
 
-// Check if multiple checksums are supported and if so, pre-process
+// Check if multiple checksums are supported and if so, pre-process. A list
+// of types can only be handled by the local checksum, which computes all of
+// them reading the file only once.
 //
    if (JobCKCGI && opaque && *opaque)
-      {char cksT[64];
-       algT = getCksType(opaque, cksT, sizeof(cksT));
+      {algT = getCksType(opaque, cksT, sizeof(cksT), true);
        if (!algT)
           {char ebuf[1024];
            snprintf(ebuf, sizeof(ebuf), "%s checksum not supported.", cksT);
            return Response.Send(kXR_ServerError, ebuf);
           }
+       if ((isList = (index(algT, ',') != 0)) && !JobLCL)
+          return Response.Send(kXR_Unsupported,
+                               "multiple checksum types are not supported");
       }
 
 // If we are allowed to locally query the checksum to avoid computation, do it
@@ -452,10 +458,14 @@ int XrdXrootdProtocol::do_CKsum(int canit)
 // Check if multiple checksums are supported and construct right argument list
 // We make a concession to a wrongly placed setfsuid/gid plugin. Fortunately,
 // it only needs to know user's name but that can come from another plugin.
+// The result for a list of types already names each one so it gets no prefix
+// and its job is kept apart from those for a single type.
 //
    std::string keyval; // Contents will be copied prior to return!
+   std::string jobKey(argp->buff);
+   if (isList) jobKey.append(" ").append(algT);
    if (JobCKCGI > 1 || JobLCL)
-      {args[0] = algT;
+      {args[0] = (isList ? (char *)"" : algT);
        args[1] = algT;
        args[2] = argp->buff;
        args[3] = const_cast<char *>(Client->tident);
@@ -472,7 +482,7 @@ int XrdXrootdProtocol::do_CKsum(int canit)
 
 // Preform the actual function
 //
-   return JobCKS->Schedule(argp->buff, (const char **)args, &Response,
+   return JobCKS->Schedule(jobKey.c_str(), (const char **)args, &Response,
                   ((CapVer & kXR_vermask) >= kXR_ver002 ? 0 : JOB_Sync));
 }
 
@@ -495,6 +505,7 @@ int XrdXrootdProtocol::do_CKsum(char *algT, const char *Path, char *Opaque)
 //
    if (*csData)
       {if (*csData == '!') return Response.Send(csData+1);
+       if (index(algT, ',')) return Response.Send(csData);
        struct iovec iov[4] = {{0,0}, {algT, (size_t)CKTLen}, {&Space, 1},
                               {(char *)csData, strlen(csData)+1}};
        return Response.Send(iov, 4);
@@ -934,6 +945,8 @@ int XrdXrootdProtocol::do_Locate()
                   if ((argp->buff)+n != opaque-1)
                   memmove(&argp->buff[n+1], opaque, strlen(opaque)+1);
                  }
+              if (MetaAsync())
+                 return XrdXrootdMetaJob::Locate(this, &locCB, fn, fsctl_cmd);
               rc =  osFS->fsctl(fsctl_cmd, fn, myError, CRED);
              }
    TRACEP(FS, "rc=" <<rc <<" locate " <<fn);
@@ -1228,9 +1241,11 @@ int XrdXrootdProtocol::do_Offload(int (XrdXrootdProtocol::*Invoke)(),int pathID)
 //
    if (!(pp = VerifyStream(rc, pathID))) return rc;
 
-// Grab the stream ID
+// Grab the stream ID. The I/O completes on the other path where it is not
+// timed, so neither is the request.
 //
    Response.StreamID(streamID);
+   latReq = 0;
 
 // Try to schedule this operation. In order to maximize the I/O overlap, we
 // will wait until the stream gets control and will have a chance to start
@@ -2377,15 +2392,22 @@ int XrdXrootdProtocol::do_Read()
    if (!IO.IOLen) return Response.Send();
 
 // There are many competing ways to accomplish a read. Pick the one we
-// will use and if possible, do a fast dispatch.
+// will use and if possible, do a fast dispatch. When read pipelining is
+// enabled, large reads are handed off so that the link can go on with other
+// requests; this takes precedence over sendfile which blocks the link. Read
+// pipelining is subject to async I/O being enabled, like kXR_async.
 //
+   bool doAio = as_aioOK && (IO.File->AsyncMode || as_rdpipe > 1)
+             && IO.IOLen >= as_miniosz
+             && IO.Offset+IO.IOLen <= IO.File->Stats.fSize+as_seghalf
+             && linkAioReq < as_maxperlnk && srvrAioOps < as_maxpersrv;
+
         if (IO.File->isMMapped) IO.Mode = XrdXrootd::IOParms::useMMap;
    else if (IO.File->sfEnabled && !isTLS && IO.IOLen >= as_minsfsz
-        &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize)
+        &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize
+        &&  !(doAio && as_rdpipe > 1))
            IO.Mode = XrdXrootd::IOParms::useSF;
-   else if (IO.File->AsyncMode && IO.IOLen >= as_miniosz
-        &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize+as_seghalf
-        &&  linkAioReq < as_maxperlnk && srvrAioOps < as_maxpersrv)
+   else if (doAio)
            {XrdXrootdProtocol *pP;
             XrdXrootdNormAio  *aioP;
 
@@ -2395,6 +2417,7 @@ int XrdXrootdProtocol::do_Read()
                     }
             if (pP && (aioP = XrdXrootdNormAio::Alloc(pP,pP->Response,IO.File)))
                {if (!IO.File->aioFob) IO.File->aioFob = new XrdXrootdAioFob;
+                aioP->Timed(latReq, latBeg); latReq = 0;
                 aioP->Read(IO.Offset, IO.IOLen);
                 return 0;
                }
@@ -2940,6 +2963,8 @@ int XrdXrootdProtocol::do_Stat()
        TRACEP(FS, "rc=" <<rc <<" statfs " <<argp->buff);
        if (rc == SFS_OK) Response.Send("");
       } else {
+       if (!doDig && MetaAsync())
+          return XrdXrootdMetaJob::Stat(this, &statCB, argp->buff, opaque);
        if (doDig) rc = digFS->stat(argp->buff, &buf, myError, CRED, opaque);
           else    rc =  osFS->stat(argp->buff, &buf, myError, CRED, opaque);
        TRACEP(FS, "rc=" <<rc <<" stat " <<argp->buff);
@@ -2966,6 +2991,10 @@ int XrdXrootdProtocol::do_Statx()
 //
    STATIC_REDIRECT(RD_stat);
 
+// If full information was requested, handle it elsewhere
+//
+   if (Request.stat.options & kXR_sxfull) return do_StatxFull();
+
 // Cycle through all of the paths in the list
 //
    while((path = pathlist.GetLine()))
@@ -2987,6 +3016,74 @@ int XrdXrootdProtocol::do_Statx()
    return Response.Send(argp->buff, respinfo-argp->buff);
 }
 
+/******************************************************************************/
+/*                         d o _ S t a t x F u l l                            */
+/******************************************************************************/
+
+// Each path yields one line of the form "<errcode> <info>" where errcode is 0
+// and info is the usual stat response upon success (StatGen()'s length counts
+// the trailing null byte which becomes the newline), otherwise it is the
+// kXR error code followed by the error message. A failing path does not fail
+// the request; only delays apply to the request as a whole. Since the paths
+// may live on different servers, a batch that would be redirected based on
+// one of its paths is refused and the client stats each path on its own.
+//
+int XrdXrootdProtocol::do_StatxFull()
+{
+   static const char *badPath = "invalid path";
+   static const char *noRedir = "batched stat cannot be redirected";
+   std::string  resp;
+   struct stat  buf;
+   int          rc, ecode, n;
+   char        *path, *opaque, *cP, xxBuff[1024];
+   const char  *eMsg;
+   bool         isMulti;
+   XrdOucErrInfo myError(Link->ID, Monitor.Did, clientPV);
+   XrdOucTokenizer pathlist(argp->buff);
+
+// A redirector would send the whole batch wherever the first path lives
+//
+   isMulti = (cP = index(argp->buff, '\n')) && cP[1];
+   if (isMulti && isRedir) return Response.Send(kXR_Unsupported, noRedir);
+
+// Cycle through all of the paths in the list
+//
+   while((path = pathlist.GetLine()))
+        {if (rpCheck(path, &opaque) || !Squash(path))
+            {n = snprintf(xxBuff, sizeof(xxBuff), "%d %s\n",
+                          kXR_ArgInvalid, badPath);
+             resp.append(xxBuff, n);
+             continue;
+            }
+         myError.Reset();
+         rc = osFS->stat(path, &buf, myError, CRED, opaque);
+         TRACEP(FS, "rc=" <<rc <<" statx " <<path);
+         if (rc == SFS_OK)
+            {*xxBuff = '0'; xxBuff[1] = ' ';
+             n = StatGen(buf, xxBuff+2, sizeof(xxBuff)-2);
+             resp.append(xxBuff, n+2);
+             resp.back() = '\n';
+             continue;
+            }
+         if (rc == SFS_REDIRECT && isMulti)
+            return Response.Send(kXR_Unsupported, noRedir);
+         if (rc != SFS_ERROR)
+            return fsError(rc, XROOTD_MON_STAT, myError, path, opaque);
+         SI->errorCnt++;
+         eMsg = myError.getErrText(ecode);
+         n = snprintf(xxBuff, sizeof(xxBuff), "%d ", XProtocol::mapError(ecode));
+         resp.append(xxBuff, n);
+         n = resp.size();
+         resp.append(eMsg);
+         for (cP = &resp[n]; *cP; cP++) if (*cP == '\n') *cP = ' ';
+         resp += '\n';
+        }
+
+// Return result
+//
+   return Response.Send((void *)resp.c_str(), resp.size());
+}
+
 /******************************************************************************/
 /*                               d o _ S y n c                                */
 /******************************************************************************/
@@ -3170,8 +3267,9 @@ int XrdXrootdProtocol::do_WriteAio()
        return do_WriteAll();
       }
 
-// Issue the write request
+// Issue the write request; the time taken is recorded when it completes
 //
+   aioP->Timed(latReq, latBeg); latReq = 0;
    return aioP->Write(IO.Offset, IO.IOLen);
 }
 
@@ -3953,16 +4051,21 @@ int XrdXrootdProtocol::getBuff(const int isRead, int Quantum)
 /* Private:                   g e t C k s T y p e                             */
 /******************************************************************************/
 
-char *XrdXrootdProtocol::getCksType(char *opaque, char *cspec, int cslen)
+char *XrdXrootdProtocol::getCksType(char *opaque, char *cspec, int cslen,
+                                     bool multi)
 {
    char *cksT;
 
 // Get match for user specified checksum type, if any. Otherwise return default.
+// If so allowed, a comma separated list of types is matched one by one and
+// the list of matching types is returned in cspec.
 //
    if (opaque && *opaque)
       {XrdOucEnv jobEnv(opaque);
        if ((cksT = jobEnv.Get("cks.type")))
-          {XrdOucTList *tP = JobCKTLST;
+          {if (multi && cspec && index(cksT, ','))
+              return getCksList(cksT, cspec, cslen);
+           XrdOucTList *tP = JobCKTLST;
            while(tP && strcasecmp(tP->text, cksT)) tP = tP->next;
            if (!tP && cspec) snprintf(cspec, cslen, "%s", cksT);
            return (tP ? tP->text : 0);
@@ -3973,6 +4076,33 @@ char *XrdXrootdProtocol::getCksType(char *opaque, char *cspec, int cslen)
 //
    return JobCKT;
 }
+
+/******************************************************************************/
+/* Private:                       g e t C k s L i s t                         */
+/******************************************************************************/
+
+char *XrdXrootdProtocol::getCksList(char *cksT, char *cspec, int cslen)
+{
+   XrdOucTList *tP;
+   char *name, *lasts;
+   int n = 0;
+
+// Match each type in the list, copying the matching types to cspec. Upon
+// failure cspec holds the type that did not match.
+//
+   name = strtok_r(cksT, ",", &lasts);
+   while(name)
+        {tP = JobCKTLST;
+         while(tP && strcasecmp(tP->text, name)) tP = tP->next;
+         if (!tP || n + (int)strlen(tP->text) + 2 > cslen)
+            {snprintf(cspec, cslen, "%s", name);
+             return 0;
+            }
+         n += sprintf(cspec+n, "%s%s", (n ? "," : ""), tP->text);
+         name = strtok_r(0, ",", &lasts);
+        }
+   return (n ? cspec : 0);
+}
   
 /******************************************************************************/
 /* Private:                     l o g L o g i n                               */
@@ -4069,6 +4199,20 @@ int XrdXrootdProtocol::mapMode(int Mode)
    return newmode;
 }
 
+/******************************************************************************/
+/*                             M e t a A s y n c                              */
+/******************************************************************************/
+
+bool XrdXrootdProtocol::MetaAsync()
+{
+// A stat or locate may be handled asynchronously if so configured, the client
+// can accept async responses, and the link has not hit its limit. We don't do
+// this when not-found redirects are configured as only fsError() handles them.
+//
+   return as_metaops && !RQLxist && linkMetaReq < as_metaops
+       && (clientPV & XrdOucEI::uAsync);
+}
+
 /******************************************************************************/
 /*                               M o n A u t h                                */
 /******************************************************************************/
@@ -177,6 +177,7 @@ int XrdXrootdProtocol::do_PgRead()
 
          if (pP && (aioP = XrdXrootdPgrwAio::Alloc(pP, pP->Response, IO.File)))
             {if (!IO.File->aioFob) IO.File->aioFob = new XrdXrootdAioFob;
+             aioP->Timed(latReq, latBeg); latReq = 0;
              aioP->Read(IO.Offset, IO.IOLen);
              return 0;
             }
@@ -441,8 +442,9 @@ bool XrdXrootdProtocol::do_PgWAIO(int &rc)
        return false;
       }
 
-// Issue the write request
+// Issue the write request; the time taken is recorded when it completes
 //
+   aioP->Timed(latReq, latBeg); latReq = 0;
    rc = aioP->Write(IO.Offset, IO.IOLen);
    return true;
 }
@@ -0,0 +1,243 @@
+#undef NDEBUG
+
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccPrefixTrie.hh"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+class XrdAccTests : public Test {};
+
+namespace
+{
+// Return the values of every rule that is a prefix of the path, shortest
+// prefix first, by comparing the path against each rule in turn.
+//
+std::vector<int> LinearMatch(const std::vector<std::pair<std::string, int> > &rules,
+                             const std::string &path)
+{
+   std::vector<std::pair<size_t, int> > hits;
+   for (const auto &rule : rules)
+       if (!path.compare(0, rule.first.size(), rule.first))
+          hits.emplace_back(rule.first.size(), rule.second);
+   std::sort(hits.begin(), hits.end());
+
+   std::vector<int> result;
+   for (const auto &hit : hits) result.push_back(hit.second);
+   return result;
+}
+
+std::vector<int> TrieMatch(const XrdAccPrefixTrie<int> &trie,
+                           const std::string &path)
+{
+   std::vector<int> result;
+   trie.Match(path.c_str(), path.size(),
+              [&result](const int &v) {result.push_back(v); return true;});
+   return result;
+}
+
+std::string RandomPath(std::mt19937 &rng, int maxlen)
+{
+   static const char alphabet[] = "/ab.";
+   std::string path;
+   int len = rng() % (maxlen + 1);
+   for (int i = 0; i < len; i++) path += alphabet[rng() % 4];
+   return path;
+}
+
+// One entry of a capability list: a path with its privileges or, when tmpl
+// is not negative, a reference to that template.
+//
+struct CapSpec
+{
+   std::string path;
+   int         pprivs;
+   int         nprivs;
+   int         tmpl;
+};
+
+XrdAccCapability *MakeCaps(const std::vector<CapSpec> &spec,
+                           const std::vector<XrdAccCapability *> &tmplts)
+{
+   XrdAccCapability *head = 0, *last = 0, *cP;
+   for (const auto &ent : spec)
+       {if (ent.tmpl >= 0) cP = new XrdAccCapability(tmplts[ent.tmpl]);
+           else {XrdAccPrivCaps caps;
+                 caps.pprivs = (XrdAccPrivs)ent.pprivs;
+                 caps.nprivs = (XrdAccPrivs)ent.nprivs;
+                 cP = new XrdAccCapability((char *)ent.path.c_str(), caps);
+                }
+        if (last) last->Add(cP);
+           else head = cP;
+        last = cP;
+       }
+   return head;
+}
+
+// The result of Privs() as a return code and the privileges it granted.
+//
+std::vector<int> PrivsOf(XrdAccCapability *caps, const std::string &path,
+                         const char *pathsub = 0)
+{
+   XrdAccPrivCaps privs;
+   int rc = caps->Privs(privs, path.c_str(), pathsub);
+   return {rc, privs.pprivs, privs.nprivs};
+}
+}
+
+// Lookups must find exactly the rules that a linear scan finds, in the same
+// order, including rules that split existing nodes when they are added.
+//
+TEST(XrdAccTests, prefixTrieMatchesLinearScan) {
+    std::mt19937 rng(43);
+    for (int round = 0; round < 50; round++) {
+        XrdAccPrefixTrie<int> trie;
+        std::vector<std::pair<std::string, int> > rules;
+        int nRules = 1 + rng() % 40;
+        for (int i = 0; i < nRules; i++) {
+            std::string prefix = RandomPath(rng, 8);
+            bool dup = false;
+            for (const auto &rule : rules) dup |= rule.first == prefix;
+            if (dup) continue;
+            rules.emplace_back(prefix, i);
+            trie.Add(prefix.c_str(), prefix.size()) = i;
+        }
+        ASSERT_EQ((int)rules.size(), trie.Size());
+
+        for (int i = 0; i < 200; i++) {
+            std::string path = RandomPath(rng, 12);
+            ASSERT_EQ(LinearMatch(rules, path), TrieMatch(trie, path))
+                << "path '" << path << "'";
+        }
+        for (const auto &rule : rules)
+            ASSERT_EQ(LinearMatch(rules, rule.first), TrieMatch(trie, rule.first))
+                << "rule '" << rule.first << "'";
+    }
+}
+
+// Adding a prefix again returns the same value and does not add a key.
+//
+TEST(XrdAccTests, prefixTrieAddExisting) {
+    XrdAccPrefixTrie<unsigned int> trie;
+    trie.Add("/store/data", 11) |= 1;
+    trie.Add("/store", 6) |= 2;
+    trie.Add("/store/data", 11) |= 4;
+    ASSERT_EQ(2, trie.Size());
+
+    std::vector<unsigned int> seen;
+    trie.Match("/store/data/file", 16,
+               [&seen](const unsigned int &v) {seen.push_back(v); return true;});
+    ASSERT_EQ((std::vector<unsigned int>{2, 5}), seen);
+}
+
+// The walk stops as soon as the callable returns false.
+//
+TEST(XrdAccTests, prefixTrieStopWalk) {
+    XrdAccPrefixTrie<int> trie;
+    trie.Add("", 0) = 1;
+    trie.Add("/a", 2) = 2;
+    trie.Add("/a/b", 4) = 3;
+
+    int calls = 0;
+    trie.Match("/a/b/c", 6, [&calls](const int &v) {calls++; return v < 2;});
+    ASSERT_EQ(2, calls);
+}
+
+// A compiled list grants the privileges of the first entry in list order
+// whose path is a prefix, not of the longest one; a later duplicate path is
+// never used and a template is only used when it comes first.
+//
+TEST(XrdAccTests, capabilityCompileFirstMatch) {
+    std::vector<XrdAccCapability *> tmplts
+        {MakeCaps({{"/store/user/", XrdAccPriv_Write, 0, -1}}, {}),
+         MakeCaps({{"/tmp/", XrdAccPriv_Update, 0, -1}}, {})};
+    std::vector<CapSpec> spec
+        {{"/store/",      XrdAccPriv_Read,   0, -1},
+         {"",             0,                 0,  0},
+         {"/store/user/", XrdAccPriv_All,    0, -1},
+         {"/data/",       XrdAccPriv_Lookup, 0, -1},
+         {"/data/",       XrdAccPriv_Write,  0, -1},
+         {"/data/x/",     XrdAccPriv_Delete, 0, -1},
+         {"",             0,                 0,  1},
+         {"/tmp/",        XrdAccPriv_Lookup, XrdAccPriv_Write, -1},
+         {"/",            XrdAccPriv_Insert, 0, -1},
+         {"/data/",       XrdAccPriv_Lock,   0, -1}};
+    XrdAccCapability *plain = MakeCaps(spec, tmplts);
+    XrdAccCapability *compiled = MakeCaps(spec, tmplts);
+    compiled->Compile();
+
+    const std::vector<std::pair<std::string, std::vector<int> > > expect
+        {{"/store/user/f", {1, XrdAccPriv_Read,   0}},
+         {"/data/x/f",     {1, XrdAccPriv_Lookup, 0}},
+         {"/data/",        {1, XrdAccPriv_Lookup, 0}},
+         {"/tmp/f",        {1, XrdAccPriv_Update, 0}},
+         {"/tmp",          {1, XrdAccPriv_Insert, 0}},
+         {"/other",        {1, XrdAccPriv_Insert, 0}},
+         {"other",         {0, 0, 0}}};
+    for (const auto &test : expect) {
+        ASSERT_EQ(test.second, PrivsOf(plain, test.first)) << test.first;
+        ASSERT_EQ(test.second, PrivsOf(compiled, test.first)) << test.first;
+    }
+
+    delete plain;
+    delete compiled;
+    for (auto cP : tmplts) delete cP;
+}
+
+// Compiled lists of any length from eight entries up, with duplicate paths
+// and templates interleaved, give the same results as the same lists
+// searched in order, also when a substitution is made into the path.
+//
+TEST(XrdAccTests, capabilityCompileMatchesList) {
+    std::mt19937 rng(43);
+    std::vector<XrdAccCapability *> tmplts;
+    for (int i = 0; i < 4; i++) {
+        std::vector<CapSpec> spec;
+        for (int j = 0; j < 2; j++)
+            spec.push_back({RandomPath(rng, 4), 1 << (rng() % 7), 0, -1});
+        tmplts.push_back(MakeCaps(spec, {}));
+    }
+
+    for (int round = 0; round < 200; round++) {
+        std::vector<CapSpec> spec;
+        int nCaps = 8 + rng() % 40;
+        for (int i = 0; i < nCaps; i++) {
+            int pick = rng() % 10;
+            if (pick < 2) spec.push_back({"", 0, 0, (int)(rng() % tmplts.size())});
+            else if (pick < 4 && !spec.empty())
+                spec.push_back({spec[rng() % spec.size()].path.empty()
+                                ? "/" : spec[rng() % spec.size()].path,
+                                (int)(rng() & XrdAccPriv_All), 0, -1});
+            else if (pick < 5)
+                spec.push_back({"/u/@=/" + RandomPath(rng, 2),
+                                (int)(rng() & XrdAccPriv_All), 0, -1});
+            else spec.push_back({RandomPath(rng, 6), (int)(rng() & XrdAccPriv_All),
+                                 (int)(rng() & XrdAccPriv_All), -1});
+        }
+        XrdAccCapability *plain = MakeCaps(spec, tmplts);
+        XrdAccCapability *compiled = MakeCaps(spec, tmplts);
+        compiled->Compile();
+
+        std::vector<std::string> paths;
+        for (int i = 0; i < 100; i++) paths.push_back(RandomPath(rng, 10));
+        for (const auto &ent : spec) paths.push_back(ent.path + "/f");
+        for (const auto &path : paths) {
+            ASSERT_EQ(PrivsOf(plain, path), PrivsOf(compiled, path))
+                << "round " << round << " path '" << path << "'";
+            ASSERT_EQ(PrivsOf(plain, path, "a"), PrivsOf(compiled, path, "a"))
+                << "round " << round << " path '" << path << "'";
+        }
+        ASSERT_EQ(PrivsOf(plain, "/u/a/b"), PrivsOf(compiled, "/u/a/b"));
+        ASSERT_EQ(PrivsOf(plain, "/u/a/b", "a"), PrivsOf(compiled, "/u/a/b", "a"));
+
+        delete plain;
+        delete compiled;
+    }
+    for (auto cP : tmplts) delete cP;
+}
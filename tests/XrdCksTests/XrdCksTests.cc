@@ -0,0 +1,208 @@
+#undef NDEBUG
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalcmd5.hh"
+#include "XrdCks/XrdCksManager.hh"
+#include "XrdCks/XrdCksPipeline.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdVersion.hh"
+
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <zlib.h>
+
+using namespace testing;
+
+class XrdCksTests : public Test {};
+
+namespace
+{
+// Sums are reduced every 5552 bytes and updates of 64 bytes or more are done
+// 16 bytes at a time where the CPU allows it (SSSE3); test around both.
+//
+const int nMax = 5552;
+
+unsigned int Adler(const std::vector<unsigned char> &data,
+                   const std::vector<int> &splits)
+{
+   XrdCksCalcadler32 cks;
+   unsigned int value;
+   size_t offs = 0;
+
+   for (int len : splits)
+       {cks.Update((const char *)data.data() + offs, len);
+        offs += len;
+       }
+   cks.Update((const char *)data.data() + offs, data.size() - offs);
+   memcpy(&value, cks.Final(), sizeof(value));
+   return ntohl(value);
+}
+
+unsigned int ZAdler(const std::vector<unsigned char> &data)
+{
+   uLong value = adler32(0L, Z_NULL, 0);
+   return adler32(value, data.data(), data.size());
+}
+
+std::string Hex(const char *value, int len)
+{
+   static const char hv[] = "0123456789abcdef";
+   std::string result;
+   for (int i = 0; i < len; i++)
+       {result += hv[(value[i] >> 4) & 0x0f];
+        result += hv[ value[i]       & 0x0f];
+       }
+   return result;
+}
+
+// A file holding random data that is removed once the test is done.
+//
+class TmpFile
+{
+public:
+
+            TmpFile(const std::vector<unsigned char> &data)
+            {fd = mkstemp(path);
+             if (fd >= 0 && write(fd, data.data(), data.size())
+                            != (ssize_t)data.size()) {close(fd); fd = -1;}
+            }
+           ~TmpFile() {if (fd >= 0) {close(fd); unlink(path);}}
+
+char path[32] = "/tmp/xrdckstestXXXXXX";
+int  fd;
+};
+
+XrdVERSIONINFODEF(myVer, ckstest, XrdVNUMBER, XrdVERSION);
+}
+
+// Whole buffers whose length is at or near a vector or reduction boundary.
+//
+TEST(XrdCksTests, adler32Lengths) {
+    std::mt19937 rng(50);
+    for (int len : {0, 1, 15, 16, 17, 63, 64, 65, 127, 128, 129,
+                    nMax-16, nMax-1, nMax, nMax+1, nMax+16,
+                    2*nMax-1, 2*nMax, 2*nMax+1, 3*nMax+15, 1<<20}) {
+        std::vector<unsigned char> data(len), ones(len, 0xff);
+        for (auto &c : data) c = rng();
+        ASSERT_EQ(ZAdler(data), Adler(data, {})) << "length " << len;
+        ASSERT_EQ(ZAdler(ones), Adler(ones, {})) << "0xff length " << len;
+    }
+}
+
+// The same data fed in pieces of random size, so that updates start and end
+// at any offset relative to the boundaries. All 0xff bytes give the largest
+// sums and so catch any overflow before a reduction.
+//
+TEST(XrdCksTests, adler32Splits) {
+    std::mt19937 rng(32);
+    for (int round = 0; round < 500; round++) {
+        std::vector<unsigned char> data(rng() % (4*nMax));
+        bool allOnes = round % 4 == 0;
+        for (auto &c : data) c = (allOnes ? 0xff : rng());
+
+        std::vector<int> splits;
+        size_t left = data.size();
+        while (left && rng() % 8) {
+            int len = rng() % (rng() % 2 ? 100 : 2*nMax);
+            if ((size_t)len > left) len = left;
+            splits.push_back(len);
+            left -= len;
+        }
+        ASSERT_EQ(ZAdler(data), Adler(data, splits))
+            << "round " << round << " length " << data.size();
+    }
+}
+
+// Segments of any size up to the buffer size, fed through the pipeline, give
+// the same checksums as the whole data at once.
+//
+TEST(XrdCksTests, pipelineSegments) {
+    std::mt19937 rng(6);
+    for (int bsz : {1, 100, 4096, 65536}) {
+        std::vector<unsigned char> data(rng() % (8 * bsz + 1000));
+        for (auto &c : data) c = rng();
+
+        XrdCksCalcadler32 adler;
+        XrdCksCalcmd5 md5, md5Whole;
+        {
+            XrdCksPipeline pipeA(&adler, bsz), pipeM(&md5, bsz);
+            ASSERT_TRUE(pipeA.Ready());
+            ASSERT_TRUE(pipeM.Ready());
+            size_t offs = 0;
+            while (offs < data.size()) {
+                int len = 1 + rng() % bsz;
+                if ((size_t)len > data.size() - offs) len = data.size() - offs;
+                memcpy(pipeA.Buffer(), data.data() + offs, len);
+                pipeA.Update(len);
+                memcpy(pipeM.Buffer(), data.data() + offs, len);
+                pipeM.Update(len);
+                offs += len;
+            }
+            pipeA.Wait();
+            pipeM.Wait();
+        }
+
+        unsigned int value;
+        memcpy(&value, adler.Final(), sizeof(value));
+        ASSERT_EQ(ZAdler(data), ntohl(value)) << "buffer size " << bsz;
+        md5Whole.Update((const char *)data.data(), data.size());
+        ASSERT_EQ(Hex(md5Whole.Final(), 16), Hex(md5.Final(), 16))
+            << "buffer size " << bsz;
+    }
+}
+
+// The buffers are half the i/o size, capped, and no larger than the file.
+//
+TEST(XrdCksTests, pipelineBuffSize) {
+    ASSERT_EQ(XrdCksPipeline::maxBsz,
+              XrdCksPipeline::BuffSize(67108864, 1LL << 40));
+    ASSERT_EQ(524288, XrdCksPipeline::BuffSize(1048576, 1LL << 40));
+    ASSERT_EQ(1000, XrdCksPipeline::BuffSize(67108864, 1000));
+    ASSERT_EQ(0, XrdCksPipeline::BuffSize(67108864, 0));
+}
+
+// Several checksums computed in one pass over a file that spans several
+// buffers match those computed one at a time and those of zlib.
+//
+TEST(XrdCksTests, managerCalcMany) {
+    std::mt19937 rng(50);
+    std::vector<unsigned char> data(3 * XrdCksPipeline::maxBsz + 12345);
+    for (auto &c : data) c = rng();
+    TmpFile file(data);
+    ASSERT_GE(file.fd, 0);
+
+    XrdSysLogger logger;
+    XrdSysError  eDest(&logger, "test_");
+    XrdCksManager cksMan(&eDest, 0, myVer);
+    ASSERT_TRUE(cksMan.Init(""));
+
+    const char *names[] = {"adler32", "md5", "crc32"};
+    XrdCksData many[3];
+    for (int i = 0; i < 3; i++) many[i].Set(names[i]);
+    ASSERT_EQ(0, cksMan.Calc(file.path, many, 3, 0));
+
+    for (int i = 0; i < 3; i++) {
+        XrdCksData one;
+        one.Set(names[i]);
+        ASSERT_EQ(0, cksMan.Calc(file.path, one, 0));
+        ASSERT_EQ(one.Length, many[i].Length) << names[i];
+        ASSERT_EQ(Hex(one.Value, one.Length), Hex(many[i].Value, many[i].Length))
+            << names[i];
+    }
+
+    unsigned int value;
+    memcpy(&value, many[0].Value, sizeof(value));
+    ASSERT_EQ(ZAdler(data), ntohl(value));
+
+    XrdCksData bad[2];
+    bad[0].Set("adler32");
+    bad[1].Set("nosuchcks");
+    ASSERT_EQ(-ENOTSUP, cksMan.Calc(file.path, bad, 2, 0));
+}
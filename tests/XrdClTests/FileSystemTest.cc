@@ -21,9 +21,11 @@
 #include <XrdCl/XrdClFile.hh>
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClPlugInManager.hh"
+#include "XrdCl/XrdClConstants.hh"
 #include "CppUnitXrdHelpers.hh"
 
 #include <pthread.h>
+#include <set>
 
 #include "TestEnv.hh"
 #include "IdentityPlugIn.hh"
@@ -45,10 +47,12 @@ class FileSystemTest: public CppUnit::TestCase
       CPPUNIT_TEST( ChmodTest );
       CPPUNIT_TEST( PingTest );
       CPPUNIT_TEST( StatTest );
+      CPPUNIT_TEST( StatBatchTest );
       CPPUNIT_TEST( StatVFSTest );
       CPPUNIT_TEST( ProtocolTest );
       CPPUNIT_TEST( DeepLocateTest );
       CPPUNIT_TEST( DirListTest );
+      CPPUNIT_TEST( DirListRecursiveTest );
       CPPUNIT_TEST( SendInfoTest );
       CPPUNIT_TEST( PrepareTest );
       CPPUNIT_TEST( XAttrTest );
@@ -62,10 +66,12 @@ class FileSystemTest: public CppUnit::TestCase
     void ChmodTest();
     void PingTest();
     void StatTest();
+    void StatBatchTest();
     void StatVFSTest();
     void ProtocolTest();
     void DeepLocateTest();
     void DirListTest();
+    void DirListRecursiveTest();
     void SendInfoTest();
     void PrepareTest();
     void XAttrTest();
@@ -333,6 +339,133 @@ void FileSystemTest::StatTest()
   delete response;
 }
 
+//------------------------------------------------------------------------------
+// Batched stat test
+//------------------------------------------------------------------------------
+void FileSystemTest::StatBatchTest()
+{
+  using namespace XrdCl;
+
+  Env *testEnv = TestEnv::GetEnv();
+
+  std::string address;
+  std::string remoteFile;
+  std::string dataPath;
+
+  CPPUNIT_ASSERT( testEnv->GetString( "MainServerURL", address ) );
+  CPPUNIT_ASSERT( testEnv->GetString( "RemoteFile",    remoteFile ) );
+  CPPUNIT_ASSERT( testEnv->GetString( "DataPath",      dataPath ) );
+
+  //----------------------------------------------------------------------------
+  // First ask the data server that holds the file, which answers the whole
+  // batch in a single request
+  //----------------------------------------------------------------------------
+  FileSystem    fs( address );
+  LocationInfo *info = 0;
+  CPPUNIT_ASSERT_XRDST( fs.DeepLocate( remoteFile, OpenFlags::Refresh, info ) );
+  CPPUNIT_ASSERT( info );
+  CPPUNIT_ASSERT( info->GetSize() );
+  FileSystem fs1( info->Begin()->GetAddress() );
+  delete info;
+
+  //----------------------------------------------------------------------------
+  // Stat the file on its own first; this also connects us so that the batch
+  // goes out as a single request to servers that support it
+  //----------------------------------------------------------------------------
+  StatInfo *fileInfo = 0, *dirInfo = 0;
+  CPPUNIT_ASSERT_XRDST( fs1.Stat( remoteFile, fileInfo ) );
+  CPPUNIT_ASSERT_XRDST( fs1.Stat( dataPath, dirInfo ) );
+
+  std::vector<std::string> paths;
+  paths.push_back( remoteFile );
+  paths.push_back( dataPath + "/does-not-exist" );
+  paths.push_back( dataPath );
+  paths.push_back( remoteFile + "?some=cgi" );
+
+  StatInfoList *list = 0;
+  CPPUNIT_ASSERT_XRDST( fs1.StatBatch( paths, list ) );
+  CPPUNIT_ASSERT( list );
+  CPPUNIT_ASSERT( list->GetSize() == paths.size() );
+
+  for( uint32_t i = 0; i < list->GetSize(); ++i )
+    CPPUNIT_ASSERT( list->At( i )->GetPath() == paths[i] );
+
+  const StatInfo *st = list->At( 0 )->GetStatInfo();
+  CPPUNIT_ASSERT_XRDST( list->At( 0 )->GetStatus() );
+  CPPUNIT_ASSERT( st );
+  CPPUNIT_ASSERT( st->GetSize() == 1048576000 );
+  CPPUNIT_ASSERT( st->GetSize() == fileInfo->GetSize() );
+  CPPUNIT_ASSERT( st->GetFlags() == fileInfo->GetFlags() );
+  CPPUNIT_ASSERT( st->GetModTime() == fileInfo->GetModTime() );
+  CPPUNIT_ASSERT( st->TestFlags( StatInfo::IsReadable ) );
+  CPPUNIT_ASSERT( !st->TestFlags( StatInfo::IsDir ) );
+
+  CPPUNIT_ASSERT( !list->At( 1 )->GetStatus().IsOK() );
+  CPPUNIT_ASSERT( list->At( 1 )->GetStatus().errNo == kXR_NotFound );
+  CPPUNIT_ASSERT( !list->At( 1 )->GetStatInfo() );
+
+  st = list->At( 2 )->GetStatInfo();
+  CPPUNIT_ASSERT_XRDST( list->At( 2 )->GetStatus() );
+  CPPUNIT_ASSERT( st );
+  CPPUNIT_ASSERT( st->TestFlags( StatInfo::IsDir ) );
+  CPPUNIT_ASSERT( st->GetFlags() == dirInfo->GetFlags() );
+  CPPUNIT_ASSERT( st->GetModTime() == dirInfo->GetModTime() );
+
+  st = list->At( 3 )->GetStatInfo();
+  CPPUNIT_ASSERT_XRDST( list->At( 3 )->GetStatus() );
+  CPPUNIT_ASSERT( st );
+  CPPUNIT_ASSERT( st->GetSize() == fileInfo->GetSize() );
+
+  delete list;
+  delete fileInfo;
+  delete dirInfo;
+
+  //----------------------------------------------------------------------------
+  // Paths with a newline cannot be batched
+  //----------------------------------------------------------------------------
+  paths.push_back( "/bad\npath" );
+  list = 0;
+  CPPUNIT_ASSERT( !fs1.StatBatch( paths, list ).IsOK() );
+  CPPUNIT_ASSERT( !list );
+
+  //----------------------------------------------------------------------------
+  // Through the manager every path must be found on whichever data server
+  // holds it, so take files that are spread over all of them
+  //----------------------------------------------------------------------------
+  DirectoryList *dirList = 0;
+  CPPUNIT_ASSERT_XRDST( fs.DirList( dataPath, DirListFlags::Stat |
+                                    DirListFlags::Locate, dirList ) );
+  CPPUNIT_ASSERT( dirList );
+
+  std::vector<uint64_t> sizes;
+  paths.clear();
+  for( auto itr = dirList->Begin(); itr != dirList->End(); ++itr )
+  {
+    StatInfo *entryInfo = ( *itr )->GetStatInfo();
+    if( !entryInfo || entryInfo->TestFlags( StatInfo::IsDir ) ) continue;
+    paths.push_back( dataPath + "/" + ( *itr )->GetName() );
+    sizes.push_back( entryInfo->GetSize() );
+  }
+  delete dirList;
+  CPPUNIT_ASSERT( paths.size() > 1 );
+  paths.push_back( dataPath + "/does-not-exist" );
+
+  list = 0;
+  CPPUNIT_ASSERT_XRDST( fs.StatBatch( paths, list ) );
+  CPPUNIT_ASSERT( list );
+  CPPUNIT_ASSERT( list->GetSize() == paths.size() );
+
+  for( uint32_t i = 0; i < sizes.size(); ++i )
+  {
+    CPPUNIT_ASSERT( list->At( i )->GetPath() == paths[i] );
+    CPPUNIT_ASSERT_XRDST( list->At( i )->GetStatus() );
+    CPPUNIT_ASSERT( list->At( i )->GetStatInfo() );
+    CPPUNIT_ASSERT( list->At( i )->GetStatInfo()->GetSize() == sizes[i] );
+  }
+  CPPUNIT_ASSERT( list->At( sizes.size() )->GetStatus().errNo == kXR_NotFound );
+  delete list;
+}
+
 //------------------------------------------------------------------------------
 // Stat VFS test
 //------------------------------------------------------------------------------
@@ -508,6 +641,98 @@ void FileSystemTest::DirListTest()
 }
 
 
+//------------------------------------------------------------------------------
+// Recursive dir list
+//------------------------------------------------------------------------------
+void FileSystemTest::DirListRecursiveTest()
+{
+  using namespace XrdCl;
+
+  Env *testEnv = TestEnv::GetEnv();
+
+  std::string address;
+  std::string remoteFile;
+  std::string dataPath;
+
+  CPPUNIT_ASSERT( testEnv->GetString( "MainServerURL", address ) );
+  CPPUNIT_ASSERT( testEnv->GetString( "RemoteFile",    remoteFile ) );
+  CPPUNIT_ASSERT( testEnv->GetString( "DataPath",      dataPath ) );
+
+  //----------------------------------------------------------------------------
+  // Build a small tree on a single data server
+  //----------------------------------------------------------------------------
+  FileSystem    fs( address );
+  LocationInfo *info = 0;
+  CPPUNIT_ASSERT_XRDST( fs.DeepLocate( remoteFile, OpenFlags::Refresh, info ) );
+  CPPUNIT_ASSERT( info );
+  CPPUNIT_ASSERT( info->GetSize() );
+  std::string server = info->Begin()->GetAddress();
+  FileSystem  fs1( server );
+  delete info;
+
+  std::string top = dataPath + "/lstree";
+  const char *dirs[]  = { "/a", "/a/b", "/a/b/c", "/d" };
+  const char *files[] = { "/f0", "/a/f1", "/a/b/f2", "/a/b/c/f3", "/d/f4" };
+  const size_t nDirs  = sizeof( dirs ) / sizeof( dirs[0] );
+  const size_t nFiles = sizeof( files ) / sizeof( files[0] );
+
+  std::set<std::string> expected;
+  for( size_t i = 0; i < nDirs; ++i )
+  {
+    CPPUNIT_ASSERT_XRDST( fs1.MkDir( top + dirs[i], MkDirFlags::MakePath,
+                                     Access::UR | Access::UW | Access::UX ) );
+    expected.insert( top + dirs[i] );
+  }
+  for( size_t i = 0; i < nFiles; ++i )
+  {
+    File f;
+    std::string fileUrl = "root://" + server + "/" + top + files[i];
+    CPPUNIT_ASSERT_XRDST( f.Open( fileUrl, OpenFlags::New | OpenFlags::Write,
+                                  Access::UR | Access::UW ) );
+    CPPUNIT_ASSERT_XRDST( f.Write( 0, i + 1, "abcde" ) );
+    CPPUNIT_ASSERT_XRDST( f.Close() );
+    expected.insert( top + files[i] );
+  }
+
+  //----------------------------------------------------------------------------
+  // List it recursively, one subdirectory at a time and in parallel
+  //----------------------------------------------------------------------------
+  Env *env = DefaultEnv::GetEnv();
+  int  parallel[] = { 1, 16 };
+  for( size_t p = 0; p < 2; ++p )
+  {
+    env->PutInt( "DirListParallel", parallel[p] );
+    DirectoryList *list = 0;
+    CPPUNIT_ASSERT_XRDST( fs1.DirList( top, DirListFlags::Stat |
+                                            DirListFlags::Recursive, list ) );
+    CPPUNIT_ASSERT( list );
+
+    std::set<std::string> found;
+    for( auto itr = list->Begin(); itr != list->End(); ++itr )
+    {
+      DirectoryList::ListEntry *entry = *itr;
+      std::string path = top + "/" + entry->GetName();
+      CPPUNIT_ASSERT( entry->GetStatInfo() );
+      CPPUNIT_ASSERT( found.insert( path ).second );
+      for( size_t i = 0; i < nFiles; ++i )
+        if( path == top + files[i] )
+          CPPUNIT_ASSERT( entry->GetStatInfo()->GetSize() == i + 1 );
+    }
+    CPPUNIT_ASSERT( found == expected );
+    delete list;
+  }
+  env->PutInt( "DirListParallel", DefaultDirListParallel );
+
+  //----------------------------------------------------------------------------
+  // Clean up
+  //----------------------------------------------------------------------------
+  for( size_t i = 0; i < nFiles; ++i )
+    CPPUNIT_ASSERT_XRDST( fs1.Rm( top + files[i] ) );
+  for( size_t i = nDirs; i > 0; --i )
+    CPPUNIT_ASSERT_XRDST( fs1.RmDir( top + dirs[i-1] ) );
+  CPPUNIT_ASSERT_XRDST( fs1.RmDir( top ) );
+}
+
 //------------------------------------------------------------------------------
 // Set
 //------------------------------------------------------------------------------
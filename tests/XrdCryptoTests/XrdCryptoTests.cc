@@ -0,0 +1,82 @@
+#undef NDEBUG
+
+#include "XrdCrypto/XrdCryptoLite.hh"
+
+#include <cerrno>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+class XrdCryptoTests : public Test {};
+
+namespace
+{
+const char  theKey[]  = "0123456789abcdef0123456789abcdef";
+const int   theKeyLen = sizeof(theKey) - 1;
+
+std::unique_ptr<XrdCryptoLite> AesGcm()
+{
+   int rc = 0;
+   return std::unique_ptr<XrdCryptoLite>(XrdCryptoLite::Create(rc, "aesgcm", 'g'));
+}
+}
+
+// Messages of all sizes decrypt to the original data and the same message
+// never encrypts to the same bytes twice.
+//
+TEST(XrdCryptoTests, aesgcmRoundTrip) {
+    auto cP = AesGcm();
+    ASSERT_NE(nullptr, cP.get());
+    ASSERT_EQ('g', cP->Type());
+
+    for (int len : {1, 15, 16, 17, 100, 4096}) {
+        std::string msg(len, '\0');
+        for (int i = 0; i < len; i++) msg[i] = (char)(i * 7 + len);
+
+        std::vector<char> enc(len + cP->Overhead()), enc2(enc.size());
+        int elen = cP->Encrypt(theKey, theKeyLen, msg.data(), len,
+                               enc.data(), enc.size());
+        ASSERT_EQ(len + cP->Overhead(), elen);
+        ASSERT_EQ(elen, cP->Encrypt(theKey, theKeyLen, msg.data(), len,
+                                    enc2.data(), enc2.size()));
+        ASSERT_NE(enc, enc2);
+
+        std::vector<char> dec(len);
+        ASSERT_EQ(len, cP->Decrypt(theKey, theKeyLen, enc.data(), elen,
+                                   dec.data(), dec.size()));
+        ASSERT_EQ(msg, std::string(dec.data(), len));
+    }
+}
+
+// Changing any byte of the message (iv, data or tag) or using another key
+// makes decryption fail.
+//
+TEST(XrdCryptoTests, aesgcmTamper) {
+    auto cP = AesGcm();
+    ASSERT_NE(nullptr, cP.get());
+
+    std::string msg = "the quick brown fox jumps over the lazy dog";
+    std::vector<char> enc(msg.size() + cP->Overhead()), dec(msg.size());
+    int elen = cP->Encrypt(theKey, theKeyLen, msg.data(), msg.size(),
+                           enc.data(), enc.size());
+    ASSERT_EQ((int)enc.size(), elen);
+
+    for (int i = 0; i < elen; i++) {
+        std::vector<char> bad(enc);
+        bad[i] ^= 0x01;
+        ASSERT_EQ(-EPROTO, cP->Decrypt(theKey, theKeyLen, bad.data(), elen,
+                                       dec.data(), dec.size()))
+            << "byte " << i;
+    }
+
+    std::string otherKey(theKey);
+    otherKey[0] ^= 0x01;
+    ASSERT_EQ(-EPROTO, cP->Decrypt(otherKey.data(), theKeyLen, enc.data(),
+                                   elen, dec.data(), dec.size()));
+
+    ASSERT_EQ(-EINVAL, cP->Decrypt(theKey, theKeyLen, enc.data(),
+                                   cP->Overhead(), dec.data(), dec.size()));
+}
@@ -0,0 +1,165 @@
+// Measure the rate of sss logins with each credential encryption type. Each
+// login creates a client and a server protocol object, has the client make
+// credentials and the server authenticate them, as a real login would.
+//
+// Usage: xrdsecsss-login-bench [<threads> [<logins> [<keys>]]]
+//
+// Each of <threads> threads (default 8) performs <logins> logins (default
+// 20000) against a keytab holding <keys> keys (default 300). Each encryption
+// type runs in its own process as the sss protocol is loaded only once. The
+// sss plugin must be in the library search path.
+
+#include "XrdNet/XrdNetAddr.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdOuc/XrdOucPinLoader.hh"
+#include "XrdSec/XrdSecInterface.hh"
+#include "XrdSecsss/XrdSecsssKT.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdVersion.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+XrdVERSIONINFODEF(myVer, ssslogin, XrdVNUMBER, XrdVERSION);
+
+typedef char           *(*sssInit_t)(const char, const char *,
+                                     XrdOucErrInfo *);
+typedef XrdSecProtocol *(*sssObject_t)(const char, const char *,
+                                       XrdNetAddrInfo &, const char *,
+                                       XrdOucErrInfo *);
+
+// Write a keytab whose first key is the one clients use.
+//
+bool MakeKeyTab(const std::string &path, int nKeys)
+{
+   XrdOucErrInfo eInfo;
+   XrdSecsssKT keyTab(&eInfo, path.c_str(), XrdSecsssKT::isAdmin);
+   int numKeys, numTot, numExp;
+
+   for (int k = 0; k < nKeys; k++)
+       {XrdSecsssKT::ktEnt *ktP = new XrdSecsssKT::ktEnt;
+        snprintf(ktP->Data.Name, sizeof(ktP->Data.Name),
+                 (k ? "other%04d" : "bench"), k);
+        strcpy(ktP->Data.User, "nobody");
+        strcpy(ktP->Data.Grup, "nogroup");
+        ktP->Data.Len = 32;
+        ktP->Data.Exp = 0;
+        keyTab.addKey(*ktP);
+       }
+   return keyTab.Rewrite(0, numKeys, numTot, numExp) == 0;
+}
+
+// Perform logins using the given encryption type and report the results.
+//
+void Run(const char *encName, const std::string &ktPath,
+         int nThreads, int nLogins)
+{
+   static XrdSysLogger logger;
+   static XrdSysError  eDest(&logger, "bench_");
+   XrdOucPinLoader secLib(&eDest, &myVer, "sec.protocol", "libXrdSecsss.so");
+   XrdOucErrInfo eInfo;
+   sssInit_t   initP;
+   sssObject_t objP;
+   char *cParms;
+
+// Load the protocol as the security manager would, for clients then servers
+//
+   if (!(initP = (sssInit_t)secLib.Resolve("XrdSecProtocolsssInit"))
+   ||  !(objP  = (sssObject_t)secLib.Resolve("XrdSecProtocolsssObject")))
+      exit(1);
+
+   std::string sParms = "-s " + ktPath + " -e " + encName;
+   if (!initP('c', "", &eInfo)
+   ||  !(cParms = initP('s', sParms.c_str(), &eInfo)))
+      {fprintf(stderr, "%s: %s\n", encName, eInfo.getErrText()); exit(1);}
+
+// Clients and servers meet on the loopback interface
+//
+   XrdNetAddr epAddr;
+   char ipBuff[64];
+   epAddr.Set("127.0.0.1:1094");
+   epAddr.Format(ipBuff, sizeof(ipBuff), XrdNetAddrInfo::fmtAdv6,
+                 XrdNetAddrInfo::old6Map4);
+
+// Run the logins
+//
+   std::atomic<int> nFail(0);
+   auto tBeg = std::chrono::steady_clock::now();
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; t++)
+       threads.emplace_back([&, nLogins]
+           {XrdNetAddr myAddr(epAddr);
+            XrdOucEnv cEnv;
+            cEnv.Put("sockname", ipBuff);
+            for (int i = 0; i < nLogins; i++)
+                {XrdOucErrInfo cInfo("bench", &cEnv), sInfo;
+                 XrdSecParameters *parms = 0;
+                 XrdSecProtocol *cP = objP('c', "localhost", myAddr,
+                                           cParms, &cInfo);
+                 XrdSecProtocol *sP = objP('s', "localhost", myAddr,
+                                           0, &sInfo);
+                 XrdSecCredentials *cred = (cP ? cP->getCredentials(0, &cInfo)
+                                               : 0);
+                 if (!cred || !sP || sP->Authenticate(cred, &parms, &sInfo))
+                    nFail++;
+                 delete cred; delete parms;
+                 if (cP) cP->Delete();
+                 if (sP) sP->Delete();
+                }
+           });
+   for (auto &thread : threads) thread.join();
+   std::chrono::duration<double> secs = std::chrono::steady_clock::now() - tBeg;
+
+   double nAll = nThreads * (double)nLogins;
+   printf("%-6s %d threads x %d logins: %.3f s, %.0f logins/s, %d failed\n",
+          encName, nThreads, nLogins, secs.count(), nAll / secs.count(),
+          (int)nFail);
+   fflush(stdout);
+}
+}
+
+int main(int argc, char **argv)
+{
+   int nThreads = (argc > 1 ? atoi(argv[1]) : 8);
+   int nLogins  = (argc > 2 ? atoi(argv[2]) : 20000);
+   int nKeys    = (argc > 3 ? atoi(argv[3]) : 300);
+   char ktDir[] = "/tmp/xrdsssbenchXXXXXX";
+   int status, rc = 0;
+
+   if (nThreads <= 0 || nLogins <= 0 || nKeys <= 0)
+      {fprintf(stderr, "Usage: %s [<threads> [<logins> [<keys>]]]\n", argv[0]);
+       return 1;
+      }
+
+   if (!mkdtemp(ktDir)) {perror("mkdtemp"); return 1;}
+   std::string ktPath = std::string(ktDir) + "/sss.keytab";
+   if (!MakeKeyTab(ktPath, nKeys))
+      {fprintf(stderr, "Unable to write keytab %s\n", ktPath.c_str());
+       rmdir(ktDir);
+       return 1;
+      }
+
+   for (const char *encName : {"bf32", "aesgcm"})
+       {pid_t pid = fork();
+        if (pid < 0) {perror("fork"); rc = 1; break;}
+        if (!pid) {Run(encName, ktPath, nThreads, nLogins); _exit(0);}
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)
+        ||  WEXITSTATUS(status)) {rc = 1; break;}
+       }
+
+   unlink(ktPath.c_str());
+   rmdir(ktDir);
+   return rc;
+}
@@ -0,0 +1,105 @@
+#undef NDEBUG
+
+#include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+
+class XrdNetTests : public Test {};
+
+namespace
+{
+// A UDP socket on the loopback interface that collects messages.
+//
+class UdpSink
+{
+public:
+
+std::string Dest()
+            {return "127.0.0.1:" + std::to_string(port);}
+
+bool        Recv(std::string &msg)
+            {char buff[2048];
+             ssize_t n = recv(fd, buff, sizeof(buff), 0);
+             if (n < 0) return false;
+             msg.assign(buff, n);
+             return true;
+            }
+
+            UdpSink() : fd(-1), port(0)
+            {struct sockaddr_in sa = {};
+             socklen_t slen = sizeof(sa);
+             struct timeval tv = {2, 0};
+             int rcvbuf = 4*1024*1024;
+             sa.sin_family = AF_INET;
+             sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+             if ((fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) return;
+             setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+             setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+             if (bind(fd, (struct sockaddr *)&sa, sizeof(sa))
+             ||  getsockname(fd, (struct sockaddr *)&sa, &slen))
+                {close(fd); fd = -1; return;}
+             port = ntohs(sa.sin_port);
+            }
+           ~UdpSink() {if (fd >= 0) close(fd);}
+
+int fd;
+int port;
+};
+}
+
+// Messages sent as one batch arrive whole and in order, including batches
+// larger than what is handed to the kernel in one call.
+//
+TEST(XrdNetTests, sendManyOrder) {
+    XrdSysLogger logger;
+    XrdSysError  eDest(&logger, "test_");
+    UdpSink sink;
+    ASSERT_GE(sink.fd, 0);
+
+    bool aOK = false;
+    XrdNetMsg netMsg(&eDest, sink.Dest().c_str(), &aOK);
+    ASSERT_TRUE(aOK);
+
+    for (int count : {1, 64, 65, 150}) {
+        std::vector<std::string> msgs;
+        std::vector<struct iovec> iov(count);
+        for (int i = 0; i < count; i++)
+            msgs.push_back(std::to_string(count) + ":" + std::to_string(i)
+                           + std::string(i * 7 % 1000, 'x'));
+        for (int i = 0; i < count; i++) {
+            iov[i].iov_base = (void *)msgs[i].data();
+            iov[i].iov_len  = msgs[i].size();
+        }
+
+        ASSERT_EQ(0, netMsg.SendMany(iov.data(), count));
+        for (int i = 0; i < count; i++) {
+            std::string msg;
+            ASSERT_TRUE(sink.Recv(msg)) << "message " << i << " of " << count;
+            ASSERT_EQ(msgs[i], msg);
+        }
+    }
+}
+
+// Without a default destination nothing is sent.
+//
+TEST(XrdNetTests, sendManyNoDest) {
+    XrdSysLogger logger;
+    XrdSysError  eDest(&logger, "test_");
+    XrdNetMsg netMsg(&eDest);
+
+    std::string data("lost");
+    struct iovec iov = {(void *)data.data(), data.size()};
+    ASSERT_EQ(-1, netMsg.SendMany(&iov, 1));
+}
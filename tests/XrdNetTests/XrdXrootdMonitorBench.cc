@@ -0,0 +1,170 @@
+// Measure the cost of xroot monitoring at each level: none, files (open and
+// close records), io (also one record per read and per readv) and iov (also
+// one record per readv segment). Records go to a UDP sink on the loopback
+// interface, as they would to a collector.
+//
+// Usage: xrdxrootd-monitor-bench [<threads> [<requests> [<segments>]]]
+//
+// Each of <threads> threads (default 8) acts as a client that issues
+// <requests> (default 1000000) reads and readvs of <segments> (default 8)
+// segments, opening a new file every 100 requests. Each level runs in its own
+// process as the monitor is configured only once. The time taken and the
+// number of records that reached the sink are reported for each level.
+
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+#include "XrdXrootd/XrdXrootdMonData.hh"
+#include "XrdXrootd/XrdXrootdMonitor.hh"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+struct Level {const char *name; int mode;};
+
+const Level levels[] =
+      {{"none",  0},
+       {"files", XROOTD_MON_ALL | XROOTD_MON_FILE},
+       {"io",    XROOTD_MON_ALL | XROOTD_MON_FILE | XROOTD_MON_IO},
+       {"iov",   XROOTD_MON_ALL | XROOTD_MON_FILE | XROOTD_MON_IO
+                                                  | XROOTD_MON_IOV}};
+
+const int fileReqs = 100;
+
+// Issue the monitor calls the protocol makes for a client's requests.
+//
+void Client(int nReqs, int nSegs)
+{
+   XrdXrootdMonitor::User monitor;
+   kXR_unt32 fileID = 0;
+   kXR_char  rvSeq = 0;
+   long long rTot = 0;
+   int rdLen = 65536, segLen = 4096;
+
+   monitor.Enable();
+   char vType = (monitor.InOut() > 1 ? XROOTD_MON_READU : XROOTD_MON_READV);
+
+   for (int i = 0; i < nReqs; i++)
+       {if (!(i % fileReqs))
+           {if (monitor.Files())
+               {if (i) monitor.Agent->Close(fileID, rTot, 0);
+                fileID = XrdXrootdMonitor::GetDictID();
+                monitor.Agent->Open(fileID, 1LL << 30);
+               }
+            rTot = 0;
+           }
+
+        if (monitor.InOut())
+           monitor.Agent->Add_rd(fileID, htonl(rdLen), htonll((long long)i*rdLen));
+
+        rvSeq++;
+        if (monitor.InOut())
+           {monitor.Agent->Add_rv(fileID, htonl(nSegs*segLen), htons(nSegs),
+                                  rvSeq, vType);
+            if (monitor.InOut() > 1) for (int k = 0; k < nSegs; k++)
+               monitor.Agent->Add_rd(fileID, htonl(segLen),
+                                     htonll((long long)(i+k)*segLen));
+           }
+        rTot += rdLen + nSegs*segLen;
+       }
+
+   if (monitor.Files() && nReqs) monitor.Agent->Close(fileID, rTot, 0);
+}
+
+// Run all the clients at one level and report the results.
+//
+void Run(const Level &level, int nThreads, int nReqs, int nSegs)
+{
+   struct sockaddr_in sa = {};
+   socklen_t slen = sizeof(sa);
+   int rcvbuf = 16*1024*1024, sfd;
+   std::atomic<long long> nRecs(0);
+
+// Create the sink and a thread that drains it
+//
+   sa.sin_family = AF_INET;
+   sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   if ((sfd = socket(AF_INET, SOCK_DGRAM, 0)) < 0
+   ||  setsockopt(sfd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf))
+   ||  bind(sfd, (struct sockaddr *)&sa, sizeof(sa))
+   ||  getsockname(sfd, (struct sockaddr *)&sa, &slen))
+      {perror("sink"); exit(1);}
+
+   std::thread([sfd, &nRecs]
+       {char buff[65536];
+        while (recv(sfd, buff, sizeof(buff), 0) >= 0) nRecs++;
+       }).detach();
+
+// Configure the monitor as the xroot protocol would
+//
+   static XrdSysLogger logger;
+   static XrdSysError  eDest(&logger, "bench_");
+   std::string dest = "127.0.0.1:" + std::to_string(ntohs(sa.sin_port));
+
+   XrdXrootdMonitor::Defaults(0, 0, 0, 0, 0, -1, 0, 0);
+   if (level.mode)
+      XrdXrootdMonitor::Defaults(strdup(dest.c_str()), level.mode, 0, 0);
+      else XrdXrootdMonitor::Defaults(0, 0, 0, 0);
+   XrdXrootdMonitor::Init(0, &eDest, "localhost", "xrootd", "bench", 1094);
+   if (!XrdXrootdMonitor::Init()) exit(1);
+
+// Run the clients
+//
+   auto tBeg = std::chrono::steady_clock::now();
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; t++)
+       threads.emplace_back(Client, nReqs, nSegs);
+   for (auto &thread : threads) thread.join();
+   std::chrono::duration<double> secs = std::chrono::steady_clock::now() - tBeg;
+
+// Give the sender time to drain its queue before counting what arrived
+//
+   long long lastRecs = -1;
+   while (lastRecs != nRecs)
+         {lastRecs = nRecs;
+          usleep(200000);
+         }
+
+   double nAll = nThreads * (double)nReqs;
+   printf("%-5s %d threads x %d requests: %.3f s, %.0f ns/request, "
+          "%lld records\n", level.name, nThreads, nReqs, secs.count(),
+          secs.count() * 1e9 * nThreads / nAll, (long long)nRecs);
+   fflush(stdout);
+}
+}
+
+int main(int argc, char **argv)
+{
+   int nThreads = (argc > 1 ? atoi(argv[1]) : 8);
+   int nReqs    = (argc > 2 ? atoi(argv[2]) : 1000000);
+   int nSegs    = (argc > 3 ? atoi(argv[3]) : 8);
+   int status;
+
+   if (nThreads <= 0 || nReqs <= 0 || nSegs <= 0)
+      {fprintf(stderr, "Usage: %s [<threads> [<requests> [<segments>]]]\n",
+                       argv[0]);
+       return 1;
+      }
+
+   for (const Level &level : levels)
+       {pid_t pid = fork();
+        if (pid < 0) {perror("fork"); return 1;}
+        if (!pid) {Run(level, nThreads, nReqs, nSegs); _exit(0);}
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)
+        ||  WEXITSTATUS(status)) return 1;
+       }
+   return 0;
+}
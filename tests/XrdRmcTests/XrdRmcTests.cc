@@ -0,0 +1,174 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucCache.hh"
+#include "XrdRmc/XrdRmc.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+// An in-memory file that records the writes it receives. Writes are slowed
+// down so that the flushers are still busy while more data is written.
+//
+class MemFile : public XrdOucCacheIO
+{
+public:
+
+bool      Detach(XrdOucCacheIOCD &iocd) override {(void)iocd; return true;}
+
+long long FSize() override
+          {XrdSysMutexHelper mHelp(fMutex); return fData.size();}
+
+const char *Path() override {return "/memfile";}
+
+int       Read(char *buff, long long offs, int rlen) override
+          {XrdSysMutexHelper mHelp(fMutex);
+           if (offs >= (long long)fData.size()) return 0;
+           if (offs + rlen > (long long)fData.size()) rlen = fData.size()-offs;
+           memcpy(buff, fData.data() + offs, rlen);
+           return rlen;
+          }
+
+int       Sync() override {XrdSysMutexHelper mHelp(fMutex); nSync++; return 0;}
+
+int       Trunc(long long offs) override
+          {XrdSysMutexHelper mHelp(fMutex); fData.resize(offs); return 0;}
+
+int       Write(char *buff, long long offs, int wlen) override
+          {if (wDelay) XrdSysTimer::Wait(wDelay);
+           XrdSysMutexHelper mHelp(fMutex);
+           if (wErr) return -wErr;
+           if (offs + wlen > (long long)fData.size()) fData.resize(offs + wlen);
+           memcpy(&fData[offs], buff, wlen);
+           wLog.push_back(std::make_pair(offs, wlen));
+           return wlen;
+          }
+
+std::string Data() {XrdSysMutexHelper mHelp(fMutex); return fData;}
+
+          MemFile(int delay=0) : wDelay(delay), wErr(0), nSync(0) {}
+         ~MemFile() {}
+
+XrdSysMutex fMutex;
+std::string fData;
+std::vector<std::pair<long long, int> > wLog;
+int         wDelay;
+int         wErr;
+int         nSync;
+};
+
+class DetachWait : public XrdOucCacheIOCD
+{
+public:
+void DetachDone() override {done.Post();}
+
+XrdSysSemaphore done;
+
+     DetachWait() : done(0) {}
+};
+
+const int pgSize = 4096;
+
+XrdOucCache *WBCache()
+{
+   XrdRmc::Parms parms;
+   parms.CacheSize = 1024*pgSize;
+   parms.PageSize  = pgSize;
+   parms.Max2Cache = pgSize;
+   parms.Options   = XrdRmc::writeBack | XrdRmc::ioMTSafe | XrdRmc::Serialized;
+   parms.prThreads = 2;
+   parms.wbSize    = pgSize;
+   parms.wbLimit   = 16*pgSize;
+   return XrdRmc::Create(parms);
+}
+
+void Detach(XrdOucCacheIO *ioP)
+{
+   DetachWait iocd;
+   if (!ioP->Detach(iocd)) iocd.done.Wait();
+}
+}
+
+class XrdRmcTests : public Test {};
+
+// Random overlapping writes must reach the file in the order they were issued
+// so that the file ends up with the same contents as a plain copy.
+//
+TEST(XrdRmcTests, writeBackOrdering) {
+    XrdOucCache *cache = WBCache();
+    ASSERT_NE(nullptr, cache);
+    MemFile file(1);
+    XrdOucCacheIO *ioP = cache->Attach(&file, XrdOucCache::optRW);
+    ASSERT_NE((XrdOucCacheIO *)&file, ioP);
+
+    std::mt19937 rng(33);
+    std::string ref;
+    char buff[3*pgSize];
+    for (int i = 0; i < 2000; i++) {
+        long long offs = (i % 3 ? (long long)ref.size()
+                                : (long long)(rng() % (ref.size() + 1)));
+        int wlen = 1 + rng() % (i % 50 ? 512 : sizeof(buff));
+        for (int j = 0; j < wlen; j++) buff[j] = 'a' + rng() % 26;
+        ASSERT_EQ(wlen, ioP->Write(buff, offs, wlen));
+        if (offs + wlen > (long long)ref.size()) ref.resize(offs + wlen);
+        ref.replace(offs, wlen, buff, wlen);
+    }
+
+    // Reads see buffered data even before it is written
+    //
+    long long roffs = ref.size() > 100 ? ref.size() - 100 : 0;
+    int rlen = ref.size() - roffs;
+    ASSERT_EQ(rlen, ioP->Read(buff, roffs, rlen));
+    ASSERT_EQ(ref.substr(roffs), std::string(buff, rlen));
+
+    ASSERT_EQ(0, ioP->Sync());
+    ASSERT_EQ(ref, file.Data());
+    ASSERT_LT(file.wLog.size(), 2000u);
+    Detach(ioP);
+}
+
+// Detaching (i.e. closing) a file writes all buffered data.
+//
+TEST(XrdRmcTests, writeBackFlushOnClose) {
+    XrdOucCache *cache = WBCache();
+    ASSERT_NE(nullptr, cache);
+    MemFile file(5);
+    XrdOucCacheIO *ioP = cache->Attach(&file, XrdOucCache::optRW);
+
+    char buff[100];
+    memset(buff, 'x', sizeof(buff));
+    for (int i = 0; i < 10; i++)
+        ASSERT_EQ(100, ioP->Write(buff, i*100, 100));
+    ASSERT_TRUE(file.Data().empty());
+
+    Detach(ioP);
+    ASSERT_EQ(std::string(1000, 'x'), file.Data());
+    ASSERT_EQ(1u, file.wLog.size());
+    ASSERT_EQ(0, file.nSync);
+}
+
+// A failed background write is returned by the next sync.
+//
+TEST(XrdRmcTests, writeBackError) {
+    XrdOucCache *cache = WBCache();
+    ASSERT_NE(nullptr, cache);
+    MemFile file;
+    XrdOucCacheIO *ioP = cache->Attach(&file, XrdOucCache::optRW);
+
+    char buff[100];
+    memset(buff, 'y', sizeof(buff));
+    file.wErr = EIO;
+    ASSERT_EQ(100, ioP->Write(buff, 0, 100));
+    ASSERT_EQ(-EIO, ioP->Sync());
+    Detach(ioP);
+}
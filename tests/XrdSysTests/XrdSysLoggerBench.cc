@@ -0,0 +1,67 @@
+// Measure the message throughput of XrdSysLogger when writing synchronously
+// and asynchronously.
+//
+// Usage: xrdsys-logger-bench [<threads> [<msgs> [<file>]]]
+//
+// Each of <threads> threads (default 8) logs <msgs> messages (default 100000)
+// to <file> (default /dev/null). The time until all messages are written is
+// reported for each mode.
+
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+double Run(const char *path, int nThreads, int nMsgs, bool async)
+{
+   int fd = open(path, O_WRONLY|O_CREAT|O_TRUNC|O_APPEND, 0644);
+   if (fd < 0) {perror(path); exit(1);}
+
+   XrdSysLogger logger(fd, 0);
+   if (async && !logger.setAsync(256*1024*1024)) exit(1);
+   XrdSysError eDest(&logger, "bench_");
+
+   auto tBeg = std::chrono::steady_clock::now();
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; t++)
+       threads.emplace_back([&eDest, nMsgs, t]
+           {std::string tid = std::to_string(t);
+            for (int i = 0; i < nMsgs; i++)
+                eDest.Say("thread ", tid.c_str(), " message ",
+                          std::to_string(i).c_str(), " of the benchmark");
+           });
+   for (auto &thread : threads) thread.join();
+   logger.Flush();
+   std::chrono::duration<double> secs = std::chrono::steady_clock::now() - tBeg;
+   return secs.count();
+}
+}
+
+int main(int argc, char **argv)
+{
+   int nThreads = (argc > 1 ? atoi(argv[1]) : 8);
+   int nMsgs    = (argc > 2 ? atoi(argv[2]) : 100000);
+   const char *path = (argc > 3 ? argv[3] : "/dev/null");
+
+   if (nThreads <= 0 || nMsgs <= 0)
+      {fprintf(stderr, "Usage: %s [<threads> [<msgs> [<file>]]]\n", argv[0]);
+       return 1;
+      }
+
+   for (bool async : {false, true})
+       {double secs = Run(path, nThreads, nMsgs, async);
+        printf("%-5s %d threads x %d msgs: %.3f s, %.0f msgs/s\n",
+               (async ? "async" : "sync"), nThreads, nMsgs, secs,
+               nThreads * (double)nMsgs / secs);
+       }
+   return 0;
+}
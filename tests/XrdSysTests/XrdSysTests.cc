@@ -0,0 +1,133 @@
+#undef NDEBUG
+
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+
+class XrdSysTests : public Test {};
+
+namespace
+{
+// A log file that is removed once the test is done.
+//
+class TmpLog
+{
+public:
+
+std::vector<std::string> Lines()
+            {std::ifstream in(path);
+             std::vector<std::string> lines;
+             std::string line;
+             while (std::getline(in, line)) lines.push_back(line);
+             return lines;
+            }
+
+            TmpLog() {fd = mkstemp(path);}
+           ~TmpLog() {if (fd >= 0) {close(fd); unlink(path);}}
+
+char path[32] = "/tmp/xrdsystestXXXXXX";
+int  fd;
+};
+}
+
+// Messages logged asynchronously from several threads all reach the log and
+// those of each thread appear in the order they were logged.
+//
+TEST(XrdSysTests, asyncLoggerOrder) {
+    const int nThreads = 4, nMsgs = 5000;
+    TmpLog log;
+    ASSERT_GE(log.fd, 0);
+
+    XrdSysLogger logger(log.fd, 0);
+    ASSERT_TRUE(logger.setAsync(16*1024*1024));
+    XrdSysError eDest(&logger, "test_");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; t++)
+        threads.emplace_back([&eDest, t] {
+            for (int i = 0; i < nMsgs; i++)
+                eDest.Say("thread ", std::to_string(t).c_str(), " msg ",
+                          std::to_string(i).c_str());
+        });
+    for (auto &thread : threads) thread.join();
+    logger.Flush();
+
+    std::vector<int> next(nThreads, 0);
+    for (const auto &line : log.Lines()) {
+        int t, i;
+        if (sscanf(line.c_str(), "thread %d msg %d", &t, &i) != 2) continue;
+        ASSERT_GE(t, 0);
+        ASSERT_LT(t, nThreads);
+        ASSERT_EQ(next[t], i) << "thread " << t;
+        next[t]++;
+    }
+    for (int t = 0; t < nThreads; t++) ASSERT_EQ(nMsgs, next[t]);
+}
+
+// Messages still queued when the logger is deleted are written.
+//
+TEST(XrdSysTests, asyncLoggerDestroy) {
+    TmpLog log;
+    ASSERT_GE(log.fd, 0);
+    {
+        XrdSysLogger logger(dup(log.fd), 0);
+        ASSERT_TRUE(logger.setAsync(1024*1024));
+        XrdSysError eDest(&logger, "test_");
+        for (int i = 0; i < 100; i++)
+            eDest.Say("msg ", std::to_string(i).c_str());
+    }
+    ASSERT_EQ(100u, log.Lines().size());
+}
+
+// Messages that do not fit in the queue are dropped and counted.
+//
+TEST(XrdSysTests, asyncLoggerDrops) {
+    TmpLog log;
+    ASSERT_GE(log.fd, 0);
+    {
+        XrdSysLogger logger(dup(log.fd), 0);
+        ASSERT_FALSE(logger.setAsync(0));
+        ASSERT_TRUE(logger.setAsync(8));
+        XrdSysError eDest(&logger, "test_");
+        for (int i = 0; i < 10; i++)
+            eDest.Say("a message longer than the queue");
+    }
+    auto lines = log.Lines();
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_NE(std::string::npos, lines[0].find("10 message(s) dropped"));
+}
+
+// Drops are reported while the logger runs, even when nothing else was queued.
+//
+TEST(XrdSysTests, asyncLoggerDropsReported) {
+    TmpLog log;
+    ASSERT_GE(log.fd, 0);
+
+    XrdSysLogger logger(dup(log.fd), 0);
+    ASSERT_TRUE(logger.setAsync(8));
+    XrdSysError eDest(&logger, "test_");
+    for (int i = 0; i < 3; i++) eDest.Say("a message longer than the queue");
+
+    int dropped = 0;
+    for (int i = 0; i < 100 && dropped < 3; i++) {
+        usleep(20000);
+        dropped = 0;
+        for (const auto &line : log.Lines()) {
+            size_t pos = line.find("Logger: ");
+            ASSERT_NE(std::string::npos, pos) << line;
+            dropped += atoi(line.c_str() + pos + 8);
+        }
+    }
+    ASSERT_EQ(3, dropped);
+}
@@ -0,0 +1,346 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdTpc/XrdTpcEngine.hh"
+#include "XrdTpc/XrdTpcState.hh"
+#include "XrdTpc/XrdTpcStream.hh"
+
+#include <arpa/inet.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <curl/curl.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+using namespace TPC;
+
+class XrdTpcTests : public Test {};
+
+namespace
+{
+std::string Data(size_t len, int seed)
+{
+   std::string data(len, '\0');
+   for (size_t i = 0; i < len; i++) data[i] = (char)(i * 31 + i / 4096 + seed);
+   return data;
+}
+
+// An HTTP server on the loopback interface. A GET of /data/<len>/<seed>
+// returns that data, a GET of /slow trickles data until the server stops and
+// a PUT stores the body under its path.
+//
+class HttpServer
+{
+public:
+
+std::string Url(const std::string &path)
+            {return "http://127.0.0.1:" + std::to_string(port) + path;}
+
+std::string Stored(const std::string &path)
+            {std::lock_guard<std::mutex> lock(mutex);
+             return stored[path];
+            }
+
+            HttpServer() : lfd(-1), port(0), stop(false)
+            {struct sockaddr_in sa = {};
+             socklen_t slen = sizeof(sa);
+             sa.sin_family = AF_INET;
+             sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+             if ((lfd = socket(AF_INET, SOCK_STREAM, 0)) < 0) return;
+             if (bind(lfd, (struct sockaddr *)&sa, sizeof(sa))
+             ||  listen(lfd, 16)
+             ||  getsockname(lfd, (struct sockaddr *)&sa, &slen))
+                {close(lfd); lfd = -1; return;}
+             port = ntohs(sa.sin_port);
+             acceptor = std::thread(&HttpServer::Accept, this);
+            }
+
+           ~HttpServer()
+            {stop = true;
+             if (lfd < 0) return;
+             shutdown(lfd, SHUT_RDWR);
+             acceptor.join();
+             for (auto &conn : conns) conn.join();
+             close(lfd);
+            }
+
+int lfd;
+int port;
+
+private:
+
+void        Accept()
+            {int fd;
+             while ((fd = accept(lfd, NULL, NULL)) >= 0)
+                   {std::lock_guard<std::mutex> lock(mutex);
+                    conns.emplace_back(&HttpServer::Serve, this, fd);
+                   }
+            }
+
+static bool Send(int fd, const std::string &data)
+            {size_t sent = 0;
+             while (sent < data.size())
+                   {ssize_t n = send(fd, data.data() + sent, data.size() - sent,
+                                     MSG_NOSIGNAL);
+                    if (n <= 0) return false;
+                    sent += n;
+                   }
+             return true;
+            }
+
+void        Serve(int fd)
+            {std::string req, body;
+             char buff[65536];
+             size_t hend;
+             ssize_t n;
+             while ((hend = req.find("\r\n\r\n")) == std::string::npos)
+                   {if ((n = recv(fd, buff, sizeof(buff), 0)) <= 0)
+                       {close(fd); return;}
+                    req.append(buff, n);
+                   }
+             body = req.substr(hend + 4);
+             req.erase(hend + 2);
+             std::string method = req.substr(0, req.find(' '));
+             size_t pbeg = method.size() + 1;
+             std::string path = req.substr(pbeg, req.find(' ', pbeg) - pbeg);
+
+             if (method == "PUT")
+                {size_t clen = 0, pos = req.find("Content-Length: ");
+                 if (pos != std::string::npos) clen = std::stoul(req.substr(pos + 16));
+                 if (req.find("Expect: 100-continue") != std::string::npos)
+                    Send(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+                 while (body.size() < clen
+                    &&  (n = recv(fd, buff, sizeof(buff), 0)) > 0)
+                       body.append(buff, n);
+                 {std::lock_guard<std::mutex> lock(mutex);
+                  stored[path] = body;
+                 }
+                 Send(fd, "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n"
+                          "Connection: close\r\n\r\n");
+                } else if (path == "/slow")
+                {Send(fd, "HTTP/1.1 200 OK\r\nContent-Length: 1000000000\r\n"
+                          "Connection: close\r\n\r\n");
+                 while (!stop && Send(fd, std::string(1000, 's'))) usleep(10000);
+                } else
+                {size_t len = 0;
+                 int seed = 0;
+                 sscanf(path.c_str(), "/data/%zu/%d", &len, &seed);
+                 Send(fd, "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(len)
+                          + "\r\nConnection: close\r\n\r\n" + Data(len, seed));
+                }
+             close(fd);
+            }
+
+std::thread              acceptor;
+std::vector<std::thread> conns;
+std::mutex               mutex;
+std::map<std::string, std::string> stored;
+std::atomic<bool>        stop;
+};
+
+// A file held in memory; writes fail once the file would exceed maxLen.
+//
+class MemFile : public XrdSfsFile
+{
+public:
+
+int            open(const char *, XrdSfsFileOpenMode, mode_t,
+                    const XrdSecEntity *, const char *) override {return SFS_OK;}
+int            close() override {return SFS_OK;}
+int            fctl(const int, const char *, XrdOucErrInfo &) override
+                   {return SFS_ERROR;}
+const char    *FName() override {return "memfile";}
+int            getMmap(void **, off_t &) override {return SFS_ERROR;}
+XrdSfsXferSize read(XrdSfsFileOffset, XrdSfsXferSize) override {return 0;}
+XrdSfsXferSize read(XrdSfsFileOffset offset, char *buffer,
+                    XrdSfsXferSize size) override
+                   {if (offset >= (XrdSfsFileOffset)data.size()) return 0;
+                    size_t len = std::min((size_t)size, (size_t)(data.size() - offset));
+                    memcpy(buffer, data.data() + offset, len);
+                    return len;
+                   }
+int            read(XrdSfsAio *) override {return SFS_ERROR;}
+XrdSfsXferSize write(XrdSfsFileOffset offset, const char *buffer,
+                     XrdSfsXferSize size) override
+                   {if (offset + size > maxLen)
+                       {error.setErrInfo(ENOSPC, "file too large"); return SFS_ERROR;}
+                    if (data.size() < (size_t)(offset + size)) data.resize(offset + size);
+                    memcpy(&data[offset], buffer, size);
+                    return size;
+                   }
+int            write(XrdSfsAio *) override {return SFS_ERROR;}
+int            stat(struct stat *buf) override
+                   {memset(buf, 0, sizeof(*buf));
+                    buf->st_size = data.size();
+                    return SFS_OK;
+                   }
+int            sync() override {return SFS_OK;}
+int            sync(XrdSfsAio *) override {return SFS_ERROR;}
+int            truncate(XrdSfsFileOffset) override {return SFS_ERROR;}
+int            getCXinfo(char *, int &cxrsz) override {cxrsz = 0; return SFS_OK;}
+
+               MemFile(std::string &file, off_t maxlen = 1LL << 40)
+                      : data(file), maxLen(maxlen) {}
+
+std::string &data;
+off_t        maxLen;
+};
+
+// One transfer as set up by the TPC handler: a curl handle, the stream over
+// the local file and the transfer state.
+//
+class Transfer
+{
+public:
+
+// Drive the transfer the way the request thread does and return curl's result.
+CURLcode    Run(Engine &engine, const std::string &url)
+            {curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+             EngineXfer xfer(engine, state);
+             CURLcode res = static_cast<CURLcode>(-1);
+             if (!engine.Add(xfer, url)) return res;
+             while (true)
+                   {bool done = xfer.Done(res);
+                    if (!xfer.Pump()) xfer.Abort();
+                    if (done) break;
+                    xfer.Wait(time(NULL) + 1);
+                   }
+             state.Flush();
+             state.Finalize();
+             return res;
+            }
+
+            Transfer(std::string &file, bool push, off_t maxLen = 1LL << 40)
+                    : curl(Init()),
+                      stream(std::unique_ptr<XrdSfsFile>(new MemFile(file, maxLen)),
+                             push ? 0 : 4, push ? 0 : 1024*1024, eDest()),
+                      state(0, stream, curl, push) {}
+           ~Transfer() {curl_easy_cleanup(curl);}
+
+static CURL *Init()
+            {CURL *curl = curl_easy_init();
+             curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+             curl_easy_setopt(curl, CURLOPT_NOPROXY, "*");
+             return curl;
+            }
+
+static XrdSysError &eDest()
+            {static XrdSysLogger logger;
+             static XrdSysError   eDest(&logger, "test_");
+             return eDest;
+            }
+
+CURL  *curl;
+Stream stream;
+State  state;
+};
+}
+
+// Concurrent pulls, including ones that fill the queue and pause curl, all
+// end with the remote data on disk while disk operations are serialized.
+//
+TEST(XrdTpcTests, enginePull) {
+    HttpServer server;
+    ASSERT_GE(server.lfd, 0);
+    Engine engine(Transfer::eDest(), 2, 1);
+    ASSERT_TRUE(engine.Start());
+
+    const size_t sizes[] = {0, 1, 1024*1024 + 17, 3*1024*1024, 20*1024*1024};
+    const int nXfers = sizeof(sizes)/sizeof(sizes[0]);
+    std::vector<std::string> files(nXfers);
+    std::vector<CURLcode> results(nXfers);
+    std::vector<int> status(nXfers);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nXfers; i++)
+        threads.emplace_back([&, i] {
+            Transfer xfer(files[i], false);
+            results[i] = xfer.Run(engine, server.Url("/data/" + std::to_string(sizes[i])
+                                                     + "/" + std::to_string(i)));
+            status[i] = xfer.state.GetStatusCode();
+        });
+    for (auto &thread : threads) thread.join();
+
+    for (int i = 0; i < nXfers; i++) {
+        ASSERT_EQ(CURLE_OK, results[i]) << "size " << sizes[i];
+        ASSERT_EQ(200, status[i]);
+        ASSERT_TRUE(Data(sizes[i], i) == files[i]) << "size " << sizes[i];
+    }
+}
+
+// Pushes larger than the queue reach the remote side whole.
+//
+TEST(XrdTpcTests, enginePush) {
+    HttpServer server;
+    ASSERT_GE(server.lfd, 0);
+    Engine engine(Transfer::eDest(), 1, 4);
+    ASSERT_TRUE(engine.Start());
+
+    for (size_t size : {2*1024*1024 + 5, 19*1024*1024}) {
+        std::string file = Data(size, 7);
+        std::string path = "/put/" + std::to_string(size);
+        Transfer xfer(file, true);
+        ASSERT_EQ(CURLE_OK, xfer.Run(engine, server.Url(path)));
+        ASSERT_EQ(201, xfer.state.GetStatusCode());
+        ASSERT_TRUE(file == server.Stored(path)) << "size " << size;
+    }
+}
+
+// A local write error fails the transfer instead of leaving it hanging.
+//
+TEST(XrdTpcTests, engineWriteError) {
+    HttpServer server;
+    ASSERT_GE(server.lfd, 0);
+    Engine engine(Transfer::eDest(), 1, 1);
+    ASSERT_TRUE(engine.Start());
+
+    std::string file;
+    Transfer xfer(file, false, 2*1024*1024);
+    ASSERT_EQ(CURLE_WRITE_ERROR, xfer.Run(engine, server.Url("/data/16777216/1")));
+    ASSERT_NE(0, xfer.state.GetErrorCode());
+}
+
+// A cancelled transfer is released by its loop and reports no result, while
+// the loop goes on serving other transfers.
+//
+TEST(XrdTpcTests, engineCancel) {
+    HttpServer server;
+    ASSERT_GE(server.lfd, 0);
+    Engine engine(Transfer::eDest(), 1, 1);
+    ASSERT_TRUE(engine.Start());
+
+    std::string file, other;
+    Transfer slow(file, false);
+    curl_easy_setopt(slow.curl, CURLOPT_URL, server.Url("/slow").c_str());
+    {
+        EngineXfer xfer(engine, slow.state);
+        ASSERT_TRUE(engine.Add(xfer, server.Url("/slow")));
+        time_t deadline = time(NULL) + 10;
+        while (slow.state.GetStatusCode() < 0 && time(NULL) < deadline)
+            xfer.Wait(time(NULL) + 1);
+        ASSERT_EQ(200, slow.state.GetStatusCode());
+
+        xfer.Cancel();
+        CURLcode res = CURLE_OK;
+        ASSERT_TRUE(xfer.Done(res));
+        ASSERT_EQ(static_cast<CURLcode>(-1), res);
+    }
+
+    Transfer xfer(other, false);
+    ASSERT_EQ(CURLE_OK, xfer.Run(engine, server.Url("/data/100000/3")));
+    ASSERT_TRUE(Data(100000, 3) == other);
+}